@@ -73,7 +73,8 @@ int main(void) {
 	sevenSegmentDisplayTextCarousel("12345678", 8, "WKT", 550000, true, true, "MRT1", 55000);
 
     while(1) {
-    	asm("NOP");
+    	// Sleeps until the next timer interrupt
+    	sevenSegmentIdle();
     }
     return 0 ;
 }
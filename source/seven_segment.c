@@ -12,74 +12,46 @@
 #include "LPC802.h"
 #include "clock_config.h"
 #include "seven_segment.h"
+#include "seven_segment_backend.h"
+#include "seven_segment_internal.h"
+#include "seven_segment_irq.h"
+#include "seven_segment_light.h"
+#include "seven_segment_script.h"
+#include "seven_segment_stats.h"
+#include "seven_segment_trace.h"
 #include "stdbool.h"
 #include "ctype.h"
+#include "string.h"
 
 
 #define MRT_REPEAT		(0)
-#define MRT_CHAN0		(0)
-#define MRT_CHAN1		(1)
-
-// 7 Segment GPIO Pin outputs
-int segments[7] = {-1, -1, -1, -1, -1, -1, -1};
-
-//decimalPoint GPIO locations
-int dp = -1;
-// Disabled to Start
-bool enableDP = false;
-
-// Pin Assignments of digits enabled, also controls which digits if not all are used
-int digits[4] = {-1, -1, -1 , -1};
-
-// Type is either common anode (0) or common cathode (1)
-// NOTE: This System was designed on a common cathode display
-int sevenSegType = 1;
-
-// Char Sequence to be used as the input
-char chrSequence[4] = "    ";
-int currentDigit = -1;
-int currentClock = -1;
-// Refresh rate for the display
-int cycleRate = -1;
-
-
-// Count Down Clock
-int startCount = -1;
-int currentCount = -1;
-// Normalized -> count within 9999 & 0000 limit but the counter can exceed this
-int normalizedCount = -1;
-// Either 'Up' or 'Down'
-char countDirection[4] = "";
-// Speed at which counting happens -> how often the interrupt is triggered
-int countRate = -1;
-// The increment for the counter
-int countIncrement = 0;
-// WHich clock is used for the counter
-int countClock = -1;
-
-bool pauseCounter = false;
-bool enableCountStopValue = true;
-// A preset stop value to end the counting sequence, if not enabled, the counter wraps around
-int countStopValue;
-
-// Carousel Component -> allows for larger segments of text
-// Transition clock is the clock for the carousel motion & rate determines speed
-int transitionClock = -1;
-int transitionRate = -1;
-int transitionIndex = -1;
-// How long the sentence/characters being displayed is
-int carouselSequenceLength = -1;
-char carouselSequence[] = "";
-// Continuous carousel or one-shot
-bool enableContinousCycle = false;
-bool carouselOverflow = false;
-bool pauseCarouselTransition = false;
-
-// Slider Component -> slides a new set of 4 characters onto the screen
-char sliderSequence[] = "";
-int sliderSequenceLength = -1;
-bool pauseSliderTransition = false;
-int sliderTransitionIndex = -1;
+
+// The display used by every function without a display parameter
+SevenSegmentDisplay defaultSevenSegmentDisplay = SEVEN_SEGMENT_DISPLAY_DEFAULTS;
+
+// Displays serviced round-robin by displayMultipleInterrupt, one display per interrupt
+SevenSegmentDisplay *multiDisplays[MAX_SEVEN_SEGMENT_DISPLAYS];
+int multiDisplayCount = 0;
+int multiDisplayIndex = 0;
+int multiClock = -1;
+int multiRate = -1;
+
+// NVIC priorities given to the clocks as they are started
+int sevenSegmentRefreshPriority = SEVEN_SEGMENT_REFRESH_PRIORITY;
+int sevenSegmentTransitionPriority = SEVEN_SEGMENT_TRANSITION_PRIORITY;
+
+// Owner of each clock, indexed by the internal clock index
+SevenSegmentTimerOwner sevenSegmentTimers[5];
+// Peripherals already powered and reset, bit n is the clock index of the peripheral (MRT uses bit 2)
+int timerPeripheralsReady = 0;
+// Timers refused to a display function, see getSevenSegmentTimerConflicts
+int timerConflicts = 0;
+
+// WKT count per nominal count, see calibrateSevenSegmentWKT
+uint32_t sevenSegmentWKTScale = WKT_SCALE_ONE;
+
+// Deepest mode sevenSegmentIdle may use
+int sevenSegmentPowerMode = SEVEN_SEGMENT_POWER_SLEEP;
 
 
 /************************************************************************************************
@@ -93,271 +65,374 @@ int sliderTransitionIndex = -1;
 /*
  * Function:  setupSevenSegment
  * --------------------
- * Sets up the GPIO Assignments
- * This function is called internally whenever the Digit GPIOs or Segment GPIOs change
+ * Sets up the pins used by the display through its backend
+ * This function is called internally whenever the Digit GPIOs, Segment GPIOs or backend change
+ *
+ * display: the display to act on
  *
  * Return: no return
  */
-void setupSevenSegment() {
-	SYSCON->SYSAHBCLKCTRL0 |= (SYSCON_SYSAHBCLKCTRL0_GPIO0_MASK); // GPIO is on
-	// Loop through the digits, turning them on if set to a good value (not -1)
-	for (int i = 0; i < 4; i++) {
-		if (digits[i] != -1) {
-			GPIO->DIRSET[0] = (1UL<<digits[i]);
-			if (sevenSegType == 1) {
-				GPIO->SET[0] = (1UL<<digits[i]); // Set the Digit bit i to 1
-			} else {
-				GPIO->CLR[0] = (1UL<<digits[i]); // Set the Digit bit i to 0
-			}
-		}
-	}
-
-	// Set the direction of the gpios for the segments, allows for either an enable bit or not
-	for(int i = 0; i < 7; i++) {
-		GPIO->DIRSET[0] = (1UL<<segments[i]);
-	}
+void setupSevenSegment(SevenSegmentDisplay *display) {
+	display->staticSegments = -1;
+	display->refresh.backend->init(display);
 }
 
 
 /*
- * Function:  digitGPIOSetup
+ * Function:  digitGPIOSetupCtx
  * --------------------
  * Sets up the GPIO Assignments for the 4 GPIOs to be used for digits
  * Internally calls setupSevenSegment
  *
+ * display: the display to act on
  * channels: list of up to 4 GPIO pins to be used for the digits of the display
  *
  * Return: no return
  */
-void digitGPIOSetup(int channels[]) {
+void digitGPIOSetupCtx(SevenSegmentDisplay *display, int channels[]) {
+	display->refresh.backend = &sevenSegmentGPIOBackend;
 	for (int i = 0; i < 4; i++) {
-		digits[i] = channels[i];
+		display->digits[i] = channels[i];
 	}
-	setupSevenSegment();
+	setupSevenSegment(display);
 }
 
 
 /*
- * Function:  sevenSegmentGPIOSetup
+ * Function:  sevenSegmentGPIOSetupCtx
  * --------------------
  * Sets up the GPIO Assignments for the 4 GPIOs to be used for digits
  * Internally calls setupSevenSegment
  *
+ * display: the display to act on
  * segs: list of up to 7 GPIO pins to be used for the display (Should be ordered from Segment A .. Segment G)
  *
  * Return: no return
  */
-void sevenSegmentGPIOSetup(int segs[]) {
+void sevenSegmentGPIOSetupCtx(SevenSegmentDisplay *display, int segs[]) {
+	display->refresh.backend = &sevenSegmentGPIOBackend;
 	for (int i = 0; i < 7; i++) {
-		segments[i] = segs[i];
+		display->segments[i] = segs[i];
 	}
-	setupSevenSegment();
+	setupSevenSegment(display);
 }
 
 /*
- * Function:  setSevenSegmentType
+ * Function:  setSevenSegmentTypeCtx
  * --------------------
  * Sets up the type of seven segment to be used
  *
+ * display: the display to act on
  * type: 0 = common anode, otherwise common cathode
  *
  * Return: no return
  */
-void setSevenSegmentType(int type) {
+void setSevenSegmentTypeCtx(SevenSegmentDisplay *display, int type) {
 	if (type == 0) {
-		sevenSegType = type;
+		display->refresh.sevenSegType = type;
 	} else {
 		type = 1;
 	}
 }
 
 /*
- * Function:  enableDecimalSegment
+ * Function:  enableDecimalSegmentCtx
  * --------------------
  * Enable or disable the Decimal Segment
  *
+ * display: the display to act on
  * decimalSegment: GPIO Pin for decimal point, -1 means disabled
  *
  * Return: no return
  */
-void enableDecimalSegment(int decimalSegment) {
-	dp = decimalSegment;
-	enableDP = true;
-	GPIO->DIRSET[0] = (1UL<<dp);
+void enableDecimalSegmentCtx(SevenSegmentDisplay *display, int decimalSegment) {
+	display->dp = decimalSegment;
+	display->refresh.enableDP = true;
+	setupSevenSegment(display);
 }
 
 /*
- * Function: sevenSegmentFullSetup
+ * Function: sevenSegmentFullSetupCtx
  * --------------------
  * Do a full reset/setup rather than just portions
  *
+ * display: the display to act on
  * decimalSegment: GPIO Pin for decimal point, -1 means disabled
  *
  * Return: no return
  */
-void sevenSegmentFullSetup(int channels[], int segs[], int decimalSegment) {
+void sevenSegmentFullSetupCtx(SevenSegmentDisplay *display, int channels[], int segs[], int decimalSegment) {
+	display->refresh.backend = &sevenSegmentGPIOBackend;
 	for (int i = 0; i < 4; i++) {
-		digits[i] = channels[i];
+		display->digits[i] = channels[i];
 	}
 	for (int i = 0; i < 7; i++) {
-		segments[i] = segs[i];
+		display->segments[i] = segs[i];
 	}
-	dp = decimalSegment;
-	setupSevenSegment();
+	display->dp = decimalSegment;
+	setupSevenSegment(display);
 }
 
+/*
+ * Function: setupSevenSegmentShiftRegisterCtx
+ * --------------------
+ * Drives the display through two chained 74HC595 shift registers instead of direct GPIOs
+ * The register nearest the LPC802 drives segments A..G and the decimal point on QA..QH,
+ * the second drives the digits on QA..QD (QA is the right most digit)
+ * setSevenSegmentType picks the output levels the same way as for direct GPIOs
+ *
+ * display: the display to act on
+ * dataPin: GPIO Pin wired to SER of the first register
+ * clockPin: GPIO Pin wired to SRCLK of both registers
+ * latchPin: GPIO Pin wired to RCLK of both registers
+ *
+ * Return: no return
+ */
+void setupSevenSegmentShiftRegisterCtx(SevenSegmentDisplay *display, int dataPin, int clockPin, int latchPin) {
+	display->serialDataPin = dataPin;
+	display->serialClockPin = clockPin;
+	display->serialLatchPin = latchPin;
+	display->refresh.backend = &sevenSegmentShiftRegisterBackend;
+	setupSevenSegment(display);
+}
 
 /*
- * Function: clearDigits
+ * Function: setupSevenSegmentTM1637Ctx
  * --------------------
- * Clear the content being displayed
- * Used internally for switching between digits
+ * Drives the display through a TM1637 driver chip instead of direct GPIOs
+ * The module must have pull ups on both lines, the LPC802 only ever pulls them low
  *
+ * display: the display to act on
+ * clockPin: GPIO Pin wired to CLK
+ * dataPin: GPIO Pin wired to DIO
  *
  * Return: no return
  */
-void clearDigits() {
-	for (int i = 0; i < 4; i++) {
-		if (digits[i] != -1) {
-			if (sevenSegType == 1) {
-				GPIO->SET[0] = (1UL<<digits[i]); // Set the Digit bit i to 1
-			} else {
-				GPIO->CLR[0] = (1UL<<digits[i]); // Set the Digit bit i to 0
-			}
-		}
-	}
+void setupSevenSegmentTM1637Ctx(SevenSegmentDisplay *display, int clockPin, int dataPin) {
+	display->serialDataPin = dataPin;
+	display->serialClockPin = clockPin;
+	display->refresh.backend = &sevenSegmentTM1637Backend;
+	setupSevenSegment(display);
 }
 
 /*
- * Function: enableDigits
+ * Function: setupSevenSegmentCharlieplexCtx
  * --------------------
- * If only 1 character is being displayed then there is no need to loop so all digits are turned on
- * If a User wishes to display 0000, or 8888, or ---- for example
+ * Drives a charlieplexed display from 8 lines (no decimal point) or 9 lines (with decimal point)
+ * Lines that are not driven are tri-stated with GPIO->DIRCLR so only one digit conducts at a time
+ * Digit place k has its common on lines[k], segment j (A..G, DP) of digit k is on lines[j] for
+ * j < k and on lines[j + 1] otherwise
+ * Only the timer based functions can be used, displaySingleCharacter lights the right most digit
+ * tools/charlieplex_check.py checks the wiring for LEDs lit through sneak paths
  *
+ * display: the display to act on
+ * lines: GPIO Pins of the lines in order
+ * lineCount: 8 or 9
  *
  * Return: no return
  */
-void enableDigits() {
-	for (int i = 0; i < 4; i++) {
-		if (digits[i] != -1) {
-			if (sevenSegType == 1) {
-				GPIO->CLR[0] = (1UL<<digits[i]); // Set the Digit bit i to 0
-			} else {
-				GPIO->SET[0] = (1UL<<digits[i]); // Set the Digit bit i to 1
-			}
+void setupSevenSegmentCharlieplexCtx(SevenSegmentDisplay *display, int lines[], int lineCount) {
+	if (lineCount == CHARLIEPLEX_MAX_LINES - 1 || lineCount == CHARLIEPLEX_MAX_LINES) {
+		for (int i = 0; i < lineCount; i++) {
+			display->charlieLines[i] = lines[i];
 		}
+		display->charlieLineCount = lineCount;
+		display->refresh.backend = &sevenSegmentCharlieplexBackend;
+		setupSevenSegment(display);
 	}
 }
 
 /*
- * Function: enableDigit
+ * Function: setSevenSegmentBackendCtx
  * --------------------
- * Pick the next digit in the sequence to enable & disable the rest
- * Function used internally for swapping currently displayed digit
+ * Drives the display through a user supplied backend (see seven_segment_backend.h)
+ * Any pins the backend needs should be set on the display before calling this
  *
- * digitPlace: the current digit(0..3) that needs to be updated
+ * display: the display to act on
+ * backend: backend providing init, writeDigit and writeFrame, must stay valid while in use
  *
  * Return: no return
  */
-void enableDigit(int digitPlace) {
-	if (digits[digitPlace] != -1) {
-		if (sevenSegType == 1) {
-			GPIO->CLR[0] = (1UL<<digits[digitPlace]); // Set the Digit bit i to 0
+void setSevenSegmentBackendCtx(SevenSegmentDisplay *display, const struct SevenSegmentBackend *backend) {
+	display->refresh.backend = backend;
+	setupSevenSegment(display);
+}
 
-		} else {
-			GPIO->SET[0] = (1UL<<digits[digitPlace]); // Set the Digit bit i to 1
+
+/*
+ * Function: getSegmentPattern
+ * --------------------
+ * Looks up the segments that show a character
+ * Function used internally
+ *
+ * inputChar: character to look up, lower case is converted
+ *
+ * Return: segments A..G in bits 0..6, 0 (blank) if the character cannot be shown
+ */
+int getSegmentPattern(char inputChar) {
+	char upperCaseChar = toupper(inputChar);
+	int size = sizeof(inputCharacterOptions)/sizeof(inputCharacterOptions[0]);//Method
+	for (int i = 0; i < size; i++) {
+		if (upperCaseChar == inputCharacterOptions[i]) {
+			return displayOptions[i];
 		}
 	}
-
+	return 0;
 }
 
 /*
  * Function: displayDP
  * --------------------
  * Display the decimal point or not
- * Function used internally to determine if the decimal point should be displayed
+ * A frame shown by displaySingleCharacter is written again with the new decimal point,
+ * the refresh interrupt picks the change up on its own
+ * Function used internally
+ *
+ * display: the display to act on
  *
  * Return: no return
  */
-void displayDP() {
-	if (enableDP) {
-		if (sevenSegType == 1) {
-			GPIO->SET[0] = (1UL<<dp); // Turn on decimal point Segment
-		} else {
-			GPIO->CLR[0] = (1UL<<dp); // Turn on decimal point Segment
-		}
-	} else {
-		if (sevenSegType == 1) {
-			GPIO->CLR[0] = (1UL<<dp); // Turn off decimal point Segment
+void displayDP(SevenSegmentDisplay *display) {
+	if (display->staticSegments != -1) {
+		if (display->refresh.enableDP) {
+			display->refresh.backend->writeFrame(display, display->staticSegments | SEGMENT_DP_BIT);
 		} else {
-			GPIO->SET[0] = (1UL<<dp); // Turn off decimal point Segment
+			display->refresh.backend->writeFrame(display, display->staticSegments);
 		}
 	}
 }
 
 /*
- * Function: displayValue
+ * Function: toggleDecimalPointCtx
  * --------------------
- * Display a single value from binary sequence of 7 segments
- * Function used internally to determine which binary value to display
+ * Turn on/off the decimal point
  * Calls displayDP internally
  *
- * binaryValue: binary representation in 7-segment format wishing to be displayed
+ * display: the display to act on
  *
  * Return: no return
  */
-void displayValue(int binaryValue) {
-	int segmentCount = 7;
-	for(int i = 0; i < segmentCount; i++) {
-		int bit = (binaryValue >> i) & 1;
-		if ((bit == 1 && sevenSegType == 1) || (bit == 0 && sevenSegType == 0)) {
-			GPIO->SET[0] = (1UL<<segments[i]); // Turn on Segment
-		} else {
-			GPIO->CLR[0] = (1UL<<segments[i]); // Turn on Segment
-		}
-	}
-
-	displayDP();
+void toggleDecimalPointCtx(SevenSegmentDisplay *display) {
+	display->refresh.enableDP = !display->refresh.enableDP;
+	displayDP(display);
 }
 
 
 /*
- * Function: toggleDecimalPoint
+ * Function: setDecimalPointCtx
  * --------------------
- * Turn on/off the decimal point
+ *  Turn on the decimal point
  * Calls displayDP internally
  *
+ * display: the display to act on
+ *
  * Return: no return
  */
-void toggleDecimalPoint() {
-	enableDP = !enableDP;
-	displayDP();
+void setDecimalPointCtx(SevenSegmentDisplay *display) {
+	display->refresh.enableDP = true;
+	displayDP(display);
+}
+
+/*
+ * Function: clearDecimalPointCtx
+ * --------------------
+ * Turn off the decimal point
+ *
+ * display: the display to act on
+ *
+ * Return: no return
+ */
+void clearDecimalPointCtx(SevenSegmentDisplay *display) {
+	display->refresh.enableDP = false;
+	displayDP(display);
 }
 
 
 /*
- * Function: setDecimalPoint
+ * Function: setDecimalPointDigitsCtx
  * --------------------
- *  Turn on the decimal point
- * Calls displayDP internally
+ * Pick which digits show the decimal point when it is turned on
+ * Only applies to the timer based functions, displaySingleCharacter shows it on every digit
+ *
+ * display: the display to act on
+ * digitMask: bit n is the digit on channels[n] (0xF shows it on every digit)
  *
  * Return: no return
  */
-void setDecimalPoint() {
-	enableDP = true;
-	displayDP();
+void setDecimalPointDigitsCtx(SevenSegmentDisplay *display, int digitMask) {
+	display->refresh.decimalPointMask = digitMask;
 }
 
 /*
- * Function: clearDecimalPoint
+ * Function: setSevenSegmentBlinkCtx
  * --------------------
- * Turn off the decimal point
+ * Blink digits and/or decimal points, handled within the refresh interrupt
+ * Blinking does not use a timer of its own, the phase is counted in refresh frames
+ *
+ * display: the display to act on
+ * digitMask: digits to blink, bit n is the digit on channels[n]
+ * dpMask: decimal points to blink, bit n is the digit on channels[n]
+ * newBlinkPeriod: length of the on and off phases in refresh frames (4 refresh interrupts each)
  *
  * Return: no return
  */
-void clearDecimalPoint() {
-	enableDP = false;
-	displayDP();
+void setSevenSegmentBlinkCtx(SevenSegmentDisplay *display, int digitMask, int dpMask, int newBlinkPeriod) {
+	display->refresh.blinkDigitMask = digitMask;
+	display->refresh.blinkDPMask = dpMask;
+	if (newBlinkPeriod != display->refresh.blinkPeriod) {
+		display->refresh.blinkFrameCount = 0;
+		display->refresh.blinkOff = false;
+	}
+	display->refresh.blinkPeriod = newBlinkPeriod;
+}
+
+/*
+ * Function: clearSevenSegmentBlinkCtx
+ * --------------------
+ * Stop all blinking, every digit and decimal point is shown steadily again
+ *
+ * display: the display to act on
+ *
+ * Return: no return
+ */
+void clearSevenSegmentBlinkCtx(SevenSegmentDisplay *display) {
+	display->refresh.blinkPeriod = 0;
+	display->refresh.blinkFrameCount = 0;
+	display->refresh.blinkOff = false;
+}
+
+/*
+ * Function: setSevenSegmentBrightnessCtx
+ * --------------------
+ * Set the brightness of the display by skipping whole refresh frames
+ * Only applies to the timer based functions, the refresh rate should be high enough
+ * that MAX_BRIGHTNESS frames still pass without visible flicker
+ *
+ * display: the display to act on
+ * level: 0 (off) .. MAX_BRIGHTNESS (full brightness), values outside the range are clamped
+ *
+ * Return: no return
+ */
+void setSevenSegmentBrightnessCtx(SevenSegmentDisplay *display, int level) {
+	if (level < 0) {
+		level = 0;
+	} else if (level > MAX_BRIGHTNESS) {
+		level = MAX_BRIGHTNESS;
+	}
+	display->refresh.brightnessLevel = level;
+}
+
+/*
+ * Function: getSevenSegmentBrightnessCtx
+ * --------------------
+ * Getter for the current brightness level
+ *
+ * display: the display to act on
+ *
+ * Return: brightnessLevel
+ */
+int getSevenSegmentBrightnessCtx(SevenSegmentDisplay *display) {
+	return display->refresh.brightnessLevel;
 }
 
 
@@ -369,33 +444,27 @@ void clearDecimalPoint() {
  ************************************************************************************************/
 
 /*
- * Function: displaySingleCharacter
+ * Function: displaySingleCharacterCtx
  * --------------------
  * If only 1 character is being displayed then there is no need to use a timer
  * If a User wishes to display 0000, or 8888, or ---- for example
- * Calls clearDigits and enableDigits internally
+ * Calls the writeFrame of the display backend internally
  *
+ * display: the display to act on
  * inputChar: Single character to display on all active digit displays
  *
  * Return: no return
  */
-void displaySingleCharacter(char inputChar) {
-	clearDigits();
-	char upperCaseChar = toupper(inputChar);
-	int size = sizeof(inputCharacterOptions)/sizeof(inputCharacterOptions[0]);//Method
+void displaySingleCharacterCtx(SevenSegmentDisplay *display, char inputChar) {
 	for (int i = 0; i < 4; i++) {
-		chrSequence[3-i] = inputChar;
-	}
-	for (int i = 0; i < size; i++) {
-		if (upperCaseChar == inputCharacterOptions[i]) {
-			displayValue(displayOptions[i]);
-		}
+		display->refresh.chrSequence[3-i] = inputChar;
 	}
-	enableDigits();
+	display->staticSegments = getSegmentPattern(inputChar);
+	displayDP(display);
 }
 
 /*
- * Function: displaySingleInt
+ * Function: displaySingleIntCtx
  * --------------------
  * Wrapper Function to allow integers to be displayed as well
  * Mainly for clarity of use for developers
@@ -403,13 +472,14 @@ void displaySingleCharacter(char inputChar) {
  * If a User wishes to display 0000, or 8888 for example
  * Calls displaySingleCharacter internally
  *
+ * display: the display to act on
  * inputNum: Single integer to display on all active digit displays
  *
  * Return: no return
  */
-void displaySingleInt(int inputNum) {
+void displaySingleIntCtx(SevenSegmentDisplay *display, int inputNum) {
 	char characterValue = inputNum +'0';
-	displaySingleCharacter(characterValue);
+	displaySingleCharacterCtx(display, characterValue);
 }
 
 
@@ -424,28 +494,148 @@ void displaySingleInt(int inputNum) {
  ************************************************************************************************/
 
 /*
- * Function: SysTick_Configuration_Seven_Segment
+ * Function: enterSevenSegmentCritical
  * --------------------
- * Enables the SysTick Timer for use
+ * Masks interrupts for a short read-modify-write of a SYSCON register the application may also change
+ * The timers themselves are set up with only their own NVIC line masked
  * Function called internally
  *
- * Return: no return
+ *
+ * Return: PRIMASK before masking, to hand to exitSevenSegmentCritical
  */
-void SysTick_Configuration_Seven_Segment() {
+uint32_t enterSevenSegmentCritical() {
+	uint32_t primask = __get_PRIMASK();
 	__disable_irq();
-	NVIC_DisableIRQ(SysTick_IRQn); // turn off the SysTick interrupt.
-	if (currentClock == 0) {
-		SysTick_Config(cycleRate);
-	} else if (countClock == 0) {
-		SysTick_Config(countRate);
-	} else if (transitionClock == 0) {
-		SysTick_Config(transitionRate);
+	return primask;
+}
+
+/*
+ * Function: exitSevenSegmentCritical
+ * --------------------
+ * Restores PRIMASK as it was before enterSevenSegmentCritical, so interrupts the caller had
+ * masked stay masked
+ * Function called internally
+ *
+ * primask: value returned by enterSevenSegmentCritical
+ *
+ * Return: no return
+ */
+void exitSevenSegmentCritical(uint32_t primask) {
+	__set_PRIMASK(primask);
+}
+
+/*
+ * Function: setSevenSegmentInterruptPriorities
+ * --------------------
+ * Sets the NVIC priorities given to the timers started from now on, 0 is the most urgent
+ * The refresh clock gets refreshPriority, counter and transition clocks get transitionPriority
+ * Call before the display functions, the defaults come from seven_segment_config.h
+ * MRT0 and MRT1 share one interrupt, when one of them refreshes the interrupt keeps the refresh priority
+ *
+ * refreshPriority: priority of the refresh interrupt (and the SPI interrupt of an SPI chain)
+ * transitionPriority: priority of the counter, carousel, slider, sequencer and script interrupts
+ *
+ * Return: no return
+ */
+void setSevenSegmentInterruptPriorities(int refreshPriority, int transitionPriority) {
+	sevenSegmentRefreshPriority = refreshPriority;
+	sevenSegmentTransitionPriority = transitionPriority;
+}
+
+/*
+ * Function: setClockPriority
+ * --------------------
+ * Gives the NVIC line of the clock the refresh priority if it refreshes a display,
+ * the transition priority otherwise
+ * The MRT line is shared by both channels and keeps the refresh priority while either channel refreshes
+ * Function called internally by startClock
+ *
+ * clock: internal clock index (0..4)
+ *
+ * Return: no return
+ */
+void setClockPriority(int clock) {
+	int priority = sevenSegmentTransitionPriority;
+	if (sevenSegmentTimers[clock].role == SEVEN_SEGMENT_TIMER_REFRESH) {
+		priority = sevenSegmentRefreshPriority;
+	}
+
+	if (clock == 0) {
+		NVIC_SetPriority(SysTick_IRQn, priority);
+	} else if (clock == 1) {
+		NVIC_SetPriority(WKT_IRQn, priority);
+	} else if (clock == 2 || clock == 3) {
+		if (sevenSegmentTimers[2].role == SEVEN_SEGMENT_TIMER_REFRESH
+				|| sevenSegmentTimers[3].role == SEVEN_SEGMENT_TIMER_REFRESH) {
+			priority = sevenSegmentRefreshPriority;
+		}
+		NVIC_SetPriority(MRT0_IRQn, priority);
+	} else if (clock == 4) {
+		NVIC_SetPriority(CTIMER0_IRQn, priority);
+	}
+}
+
+/*
+ * Function: initTimerPeripheral
+ * --------------------
+ * Powers, clocks and resets the peripheral of a clock the first time it is used
+ * Later calls leave the peripheral alone, so setting up one MRT channel never disturbs the other
+ * Function called internally
+ *
+ * clock: internal clock index (0..4), SysTick needs no set up
+ *
+ * Return: no return
+ */
+void initTimerPeripheral(int clock) {
+	// MRT0 and MRT1 are one peripheral, both use the bit of MRT0
+	int peripheral = clock;
+	if (clock == 3) {
+		peripheral = 2;
 	}
+	if (clock <= 0 || (timerPeripheralsReady & (1 << peripheral))) {
+		return;
+	}
+
+	uint32_t primask = enterSevenSegmentCritical();
+	if (peripheral == 1) {
+		SYSCON->SYSAHBCLKCTRL0 |= (SYSCON_SYSAHBCLKCTRL0_WKT_MASK);
+		SYSCON->PDRUNCFG &= ~(SYSCON_PDRUNCFG_LPOSC_PD_MASK);
+		SYSCON->LPOSCCLKEN |= (SYSCON_LPOSCCLKEN_WKT_MASK);
+		SYSCON->PRESETCTRL0 &= ~(SYSCON_PRESETCTRL0_WKT_RST_N_MASK);
+		SYSCON->PRESETCTRL0 |= (SYSCON_PRESETCTRL0_WKT_RST_N_MASK);
+	} else if (peripheral == 2) {
+		SYSCON->SYSAHBCLKCTRL0 |= (SYSCON_SYSAHBCLKCTRL0_MRT_MASK);
+		SYSCON->PRESETCTRL0 &= ~(0x400); 	//~(SYSCON_PRESETCTRL0_MRT_RST_N_MASK);
+		SYSCON->PRESETCTRL0 |= 0x400; 		//(SYSCON_PRESETCTRL0_WKT_RST_N_MASK);
+	} else if (peripheral == 4) {
+		SYSCON->SYSAHBCLKCTRL0 |= (SYSCON_SYSAHBCLKCTRL0_CTIMER0_MASK);
+		SYSCON->PRESETCTRL0 &= ~(SYSCON_PRESETCTRL0_CTIMER0_RST_N_MASK); // Reset
+		SYSCON->PRESETCTRL0 |= (SYSCON_PRESETCTRL0_CTIMER0_RST_N_MASK); // clear the reset.
+	}
+	timerPeripheralsReady = timerPeripheralsReady | (1 << peripheral);
+	exitSevenSegmentCritical(primask);
+}
 
-	NVIC_EnableIRQ(SysTick_IRQn); // SysTick IRQs are on.
-	__enable_irq();
+#if SEVEN_SEGMENT_USE_SYSTICK
+/*
+ * Function: SysTick_Configuration_Seven_Segment
+ * --------------------
+ * Enables the SysTick Timer for use
+ * Function called internally
+ *
+ * rate: reload value in main clock cycles
+ *
+ * Return: no return
+ */
+void SysTick_Configuration_Seven_Segment(int rate) {
+	// SysTick is not on the NVIC, its interrupt is held off in its own CTRL register
+	// SysTick_Config turns the interrupt back on once LOAD and VAL are set
+	SysTick->CTRL &= ~(SysTick_CTRL_TICKINT_Msk);
+	SysTick_Config(rate);
 }
+#endif
 
+#if SEVEN_SEGMENT_USE_WKT
 /*
  * Function: WKT_Configuration_Seven_Segment
  * --------------------
@@ -453,950 +643,3398 @@ void SysTick_Configuration_Seven_Segment() {
  * Note that the WKT uses the Low Power Oscillator
  * Function called internally
  *
+ * rate: count in low power oscillator cycles, reloaded by restartClock after each interrupt
+ *
  * Return: no return
  */
-void WKT_Configuration_Seven_Segment() {
-	__disable_irq();
-	SYSCON->SYSAHBCLKCTRL0 |= (SYSCON_SYSAHBCLKCTRL0_WKT_MASK);
-
+void WKT_Configuration_Seven_Segment(int rate) {
 	NVIC_DisableIRQ(WKT_IRQn); // turn off the WKT interrupt.
-	SYSCON->PDRUNCFG &= ~(SYSCON_PDRUNCFG_LPOSC_PD_MASK);
-	SYSCON->LPOSCCLKEN |= (SYSCON_LPOSCCLKEN_WKT_MASK);
-	SYSCON->PRESETCTRL0 &= ~(SYSCON_PRESETCTRL0_WKT_RST_N_MASK);
-	SYSCON->PRESETCTRL0 |= (SYSCON_PRESETCTRL0_WKT_RST_N_MASK);
-	WKT->CTRL = WKT_CTRL_CLKSEL_MASK;
-
-	if (currentClock == 1) {
-		WKT->COUNT = cycleRate;
-	} else if (countClock == 1) {
-		WKT->COUNT = countRate;
-	} else if (transitionClock == 1) {
-		WKT->COUNT = transitionRate;
-	}
+	initTimerPeripheral(1);
 
+	WKT->CTRL = WKT_CTRL_CLKSEL_MASK;
+	WKT->COUNT = getWKTCount(rate);
 
 	NVIC_EnableIRQ(WKT_IRQn);
-	__enable_irq();
 }
+#endif
 
 
+#if SEVEN_SEGMENT_USE_MRT
 /*
  * Function: MRT_Configuration_Seven_Segment
  * --------------------
- * Enables the MultiRate Timer for use
- * Can use 1 or 2 channels depending on actions chosen
+ * Enables one channel of the MultiRate Timer for use
+ * Only the given channel is set up, the other channel keeps running
  * Function called internally
  *
+ * channel: MRT_CHAN0 or MRT_CHAN1
+ * rate: interval in main clock cycles
+ *
  * Return: no return
  */
-void MRT_Configuration_Seven_Segment(int channel) {
-	__disable_irq(); // turn off globally
+void MRT_Configuration_Seven_Segment(int channel, int rate) {
 	NVIC_DisableIRQ(MRT0_IRQn);
-	SYSCON->SYSAHBCLKCTRL0 |= (SYSCON_SYSAHBCLKCTRL0_MRT_MASK);
-
-	SYSCON->PRESETCTRL0 &= ~(0x400); 	//~(SYSCON_PRESETCTRL0_MRT_RST_N_MASK);
-	SYSCON->PRESETCTRL0 |= 0x400; 		//(SYSCON_PRESETCTRL0_WKT_RST_N_MASK);
-	if (currentClock == 2 && countClock == 3) {
-		MRT0->CHANNEL[0].CTRL = (MRT_REPEAT << MRT_CHANNEL_CTRL_MODE_SHIFT | MRT_CHANNEL_CTRL_INTEN_MASK);
-		MRT0->CHANNEL[1].CTRL = (MRT_REPEAT << MRT_CHANNEL_CTRL_MODE_SHIFT | MRT_CHANNEL_CTRL_INTEN_MASK);
-		MRT0->CHANNEL[0].INTVAL = cycleRate | (MRT_CHANNEL_INTVAL_LOAD_MASK);
-		MRT0->CHANNEL[1].INTVAL = countRate | (MRT_CHANNEL_INTVAL_LOAD_MASK);
-	} else if (currentClock == 3 && countClock == 2) {
-		MRT0->CHANNEL[0].CTRL = (MRT_REPEAT << MRT_CHANNEL_CTRL_MODE_SHIFT | MRT_CHANNEL_CTRL_INTEN_MASK);
-		MRT0->CHANNEL[1].CTRL = (MRT_REPEAT << MRT_CHANNEL_CTRL_MODE_SHIFT | MRT_CHANNEL_CTRL_INTEN_MASK);
-		MRT0->CHANNEL[1].INTVAL = cycleRate | (MRT_CHANNEL_INTVAL_LOAD_MASK);
-		MRT0->CHANNEL[0].INTVAL = countRate | (MRT_CHANNEL_INTVAL_LOAD_MASK);
-	} else {
-		int tempCount = 0;
-		if (channel == 0 && currentClock == 2) {
-			tempCount = cycleRate;
-		} else if (channel == 1 && currentClock == 3) {
-			tempCount = cycleRate;
-		} else if (channel == 0 && countClock == 2) {
-			tempCount = countRate;
-		} else if (channel == 1 && countClock == 3) {
-			tempCount = countRate;
-		} else if (transitionClock == 2 || transitionClock == 3) {
-			tempCount = transitionRate;
-		}
-		MRT0->CHANNEL[channel].CTRL = (MRT_REPEAT << MRT_CHANNEL_CTRL_MODE_SHIFT | MRT_CHANNEL_CTRL_INTEN_MASK);
-		MRT0->CHANNEL[channel].INTVAL = tempCount | (MRT_CHANNEL_INTVAL_LOAD_MASK);
-	}
+	initTimerPeripheral(2 + channel);
+
+	MRT0->CHANNEL[channel].CTRL = (MRT_REPEAT << MRT_CHANNEL_CTRL_MODE_SHIFT | MRT_CHANNEL_CTRL_INTEN_MASK);
+	MRT0->CHANNEL[channel].INTVAL = rate | (MRT_CHANNEL_INTVAL_LOAD_MASK);
 
 	NVIC_EnableIRQ(MRT0_IRQn);
-	__enable_irq();
 }
+#endif
 
+#if SEVEN_SEGMENT_USE_CTIMER0
 /*
  * Function: CTIMER_Configuration_Seven_Segment
  * --------------------
  * Enables the CTimer0 for use
  * Function called internally
  *
+ * rate: match value in main clock cycles
+ *
  * Return: no return
  */
-void CTIMER_Configuration_Seven_Segment() {
-	__disable_irq(); // turn off globally
+void CTIMER_Configuration_Seven_Segment(int rate) {
 	 NVIC_DisableIRQ(CTIMER0_IRQn);
-	 SYSCON->SYSAHBCLKCTRL0 |= (SYSCON_SYSAHBCLKCTRL0_CTIMER0_MASK);
-	 SYSCON->PRESETCTRL0 &= ~(SYSCON_PRESETCTRL0_CTIMER0_RST_N_MASK); // Reset
-	 SYSCON->PRESETCTRL0 |= (SYSCON_PRESETCTRL0_CTIMER0_RST_N_MASK); // clear the reset.
+	 initTimerPeripheral(4);
+
 	 // Match Channel 0 and generate IRQ
 	 CTIMER0->MCR |= CTIMER_IR_MR0INT_MASK; // interrupt on Ch 0 match
-	 if (currentClock == 4) {
-		CTIMER0->MR[0] = cycleRate;
-	} else if (countClock == 4) {
-		CTIMER0->MR[0] = countRate;
-	} else if (transitionClock == 4) {
-		CTIMER0->MR[0] = transitionRate;
-	}
+	 CTIMER0->MR[0] = rate;
 
 	 CTIMER0->PR = (0); // PR = 0: Divide by 1 of APB clock, No Scaling
+	 // stopClock leaves TC where it stopped, start counting from 0 so a smaller match is not missed
+	 CTIMER0->TCR |= CTIMER_TCR_CRST_MASK; // set bit 1 to 1
+	 CTIMER0->TCR &= ~(CTIMER_TCR_CRST_MASK); // clear bit 1 to 0
+	 CTIMER0->IR = CTIMER_IR_MR0INT_MASK; // drop a match left from before
 	 CTIMER0->TCR |= CTIMER_TCR_CEN_MASK;
 	 NVIC_EnableIRQ(CTIMER0_IRQn);
-	 __enable_irq(); // global
 }
-
-
-/****************************************************************************************************
- * 																									*
- *									Timer Based Functions											*
- * 			These functions use at least 1 internal clock of the users choice						*
- *	Functions include: displaying 4 characters simultaneously, displaying 4 numbers simultaneously,	*
- *				a counting display, a carousel display, and a slider display						*
- * 																									*
- ****************************************************************************************************/
-
+#endif
 
 /*
- * Function: display4Characters
+ * Function: stopClock
  * --------------------
- * Function used to display 4 characters continuously on the 7 segment display
- * This function calls the timer configurations internally
+ * Stops a clock the library no longer uses, so it does not keep calling an old interrupt helper
+ * The peripheral stays powered and set up, the other MRT channel is not touched
+ * Function called internally
  *
- * inputSequence: Takes 4 character input
- * clockType: from the list "SysTick", "WKT", "MRT0", "MRT1", "CTIMER0" as input
- * refreshRate: how fast the 4 characters are cycled through on the 7-segment display
+ * clock: internal clock index (0..4)
  *
  * Return: no return
  */
-void display4Characters(char inputSequence[], char clockType[], int refreshRate) {
-	for (int i = 0; i < 4; i++) {
-		chrSequence[3-i] = inputSequence[i];
-	}
-	cycleRate = refreshRate;
-	if (strcmp(clockType, "SysTick") == 0) {
-		currentClock = 0;
-		SysTick_Configuration_Seven_Segment();
-	} else if (strcmp(clockType, "WKT") == 0) {
-		currentClock = 1;
-		WKT_Configuration_Seven_Segment();
-	} else if (strcmp(clockType, "MRT0") == 0) {
-		currentClock = 2;
-		MRT_Configuration_Seven_Segment(MRT_CHAN0);
-	}  else if (strcmp(clockType, "MRT1") == 0) {
-		currentClock = 3;
-		MRT_Configuration_Seven_Segment(MRT_CHAN1);
-	} else if (strcmp(clockType, "CTIMER0") == 0) {
-		currentClock = 4;
-		CTIMER_Configuration_Seven_Segment();
+void stopClock(int clock) {
+	if (clock == 0) {
+		SysTick->CTRL = 0;
+	} else if (clock == 1) {
+		NVIC_DisableIRQ(WKT_IRQn);
+		WKT->CTRL |= WKT_CTRL_CLEARCTR_MASK;
+	} else if (clock == 2 || clock == 3) {
+		// An interval of 0 written with LOAD stops the channel at once
+		MRT0->CHANNEL[clock - 2].CTRL = 0;
+		MRT0->CHANNEL[clock - 2].INTVAL = MRT_CHANNEL_INTVAL_LOAD_MASK;
+	} else if (clock == 4) {
+		NVIC_DisableIRQ(CTIMER0_IRQn);
+		CTIMER0->TCR &= ~(CTIMER_TCR_CEN_MASK);
 	}
-
-	currentDigit = 0;
+	SET_IRQ_HANDLER(clock, NULL, NULL);
 }
 
-
 /*
- * Function: display4Numbers
+ * Function: releaseDisplayClocks
  * --------------------
- * Function used to display 4 numbers continuously on the 7 segment display
- * This function calls the timer configurations internally
+ * Stops and frees every clock the display owns in one of the given roles
+ * Function called internally
  *
- * inputSequence: Takes 4 character input
- * clockType: from the list "SysTick", "WKT", "MRT0", "MRT1", "CTIMER0" as input
- * refreshRate: how fast the 4 numbers are cycled through on the 7-segment display
+ * display: the display to act on
+ * roleMask: bit n set releases clocks owned in role n (SEVEN_SEGMENT_TIMER_REFRESH ...)
+ * keepClock: clock index left alone, -1 for none
  *
  * Return: no return
  */
-void display4Numbers(int inputNumber, char clockType[], int refreshRate) {
-	int shifter = 1000;
-	int number = inputNumber;
-	char inputSequence[4] = "    ";
-	for (int i = 0; i < 4; i++) {
-		inputSequence[i] = (number -(number % shifter))/shifter +'0';
-		number = (number % shifter);
-		shifter = shifter/10;
+void releaseDisplayClocks(SevenSegmentDisplay *display, int roleMask, int keepClock) {
+	for (int clock = 0; clock < 5; clock++) {
+		SevenSegmentTimerOwner *owner = &sevenSegmentTimers[clock];
+		if (clock != keepClock && owner->display == display && owner->role != SEVEN_SEGMENT_TIMER_FREE
+				&& (roleMask & (1 << owner->role))) {
+			stopClock(clock);
+			owner->role = SEVEN_SEGMENT_TIMER_FREE;
+			owner->display = NULL;
+		}
 	}
-	display4Characters(inputSequence, clockType, refreshRate);
 }
 
-
 /*
- * Function: setupSevenSegmentCounter
+ * Function: claimClock
  * --------------------
- * Function used to display a counter on the 7 segment display
- * This function calls the 2 timers configurations internally
- * Calling the respective interrupts will refresh the display and update the counter
+ * Records the display and role owning a clock
+ * A clock owned by another display or reserved by the application is refused and reported in
+ * getSevenSegmentTimerConflicts
+ * A display has one refresh clock and one counter or transition clock, claiming a new one frees
+ * the clock it used before in that role
+ * Function called internally
  *
- * clockStart: Starting time for the display
- * clockType: from the list "SysTick", "WKT", "MRT0", "MRT1", "CTIMER0" as input
- * newCountDirection: "UP" or "DOWN"
- * newCountIncrement: counter increment/decrement depending on direction (negatives are allowed)
- * newStopValue: early stop point for counting
- * enableStopValue: true or false
- * newCountRate: Speed of counting progression
- * refreshClock: from the list: "SysTick", "WKT", "MRT0", "MRT1", "CTIMER0"
- * refreshRate: how fast the numbers are cycled through on the 7-segment display
- * NOTE: counterClock & refreshClock cannot be the same clock
+ * display: the display claiming the clock, NULL for the application
+ * clock: internal clock index (0..4)
+ * role: SEVEN_SEGMENT_TIMER_REFRESH, _COUNTER, _TRANSITION or _USER
  *
- * Return: no return
+ * Return: true if the clock may be set up
  */
-void setupSevenSegmentCounter(int clockStart, char counterClock[],  char newCountDirection[],
-		int newCountIncrement, int newStopValue, bool enableStopValue, int newCountRate, char refreshClock[], int refreshRate) {
-
-	if (strcmp(counterClock, refreshClock) != 0) {
-		startCount = clockStart;
-		normalizedCount = clockStart;
-		currentCount = clockStart;
+bool claimClock(SevenSegmentDisplay *display, int clock, int role) {
+	SevenSegmentTimerOwner *owner = &sevenSegmentTimers[clock];
+	if (owner->role != SEVEN_SEGMENT_TIMER_FREE && (owner->display != display
+			|| owner->role == SEVEN_SEGMENT_TIMER_USER)) {
+		timerConflicts = timerConflicts | (1 << clock);
+		return false;
+	}
 
-		if (strcmp(newCountDirection, "UP") == 0) {
-			strncpy(countDirection, "UP", 4);
+	if (display != NULL) {
+		if (role == SEVEN_SEGMENT_TIMER_REFRESH) {
+			releaseDisplayClocks(display, 1 << SEVEN_SEGMENT_TIMER_REFRESH, clock);
 		} else {
-			strncpy(countDirection, "DOWN", 4);
-		}
-
-		countStopValue = newStopValue;
-		enableCountStopValue = enableStopValue;
-		countIncrement = newCountIncrement;
-		countRate = newCountRate;
-
-		if (strcmp(counterClock, "SysTick") == 0) {
-			countClock = 0;
-			SysTick_Configuration_Seven_Segment();
-		} else if (strcmp(counterClock, "WKT") == 0) {
-			countClock = 1;
-			WKT_Configuration_Seven_Segment();
-		} else if (strcmp(counterClock, "MRT0") == 0) {
-			countClock = 2;
-			MRT_Configuration_Seven_Segment(MRT_CHAN0);
-		}  else if (strcmp(counterClock, "MRT1") == 0) {
-			countClock = 3;
-			MRT_Configuration_Seven_Segment(MRT_CHAN1);
-		} else if (strcmp(counterClock, "CTIMER0") == 0) {
-			countClock = 4;
-			CTIMER_Configuration_Seven_Segment();
+			releaseDisplayClocks(display, (1 << SEVEN_SEGMENT_TIMER_COUNTER) | (1 << SEVEN_SEGMENT_TIMER_TRANSITION), clock);
 		}
-
-		display4Numbers(clockStart, refreshClock, refreshRate);
 	}
+	owner->role = role;
+	owner->display = display;
+	return true;
 }
 
-
 /*
- * Function: sevenSegmentDisplayTextCarousel
+ * Function: reserveSevenSegmentTimer
  * --------------------
- * Function used to display a carousel of characters on the 7 segment display
- * This function calls the 2 timers configurations internally
- * Calling the respective interrupts will refresh the display and update the transition of the carousel
- * Creating a carousel sequence of text (loops on the display counter clockwise)
+ * Keeps a timer for the application, display functions asked to use it leave it alone and report
+ * a conflict instead
  *
- * characterSequence: As long of a sequence as desired of characters ("Hello World")
- * sequenceLength: Length of Sequence
- * newTransitionClock: from the list "SysTick", "WKT", "MRT0", "MRT1", "CTIMER0" as input
- * transitionSpeed: Speed of carousel motion
- * newEnableContinousCycle: true implies the coaursel will cycle, false implies a one shot action
- * newEnablePadding: Pad the sequence with a blank start and end screen
- * refreshClock: from the list: "SysTick", "WKT", "MRT0", "MRT1", "CTIMER0"
- * refreshRate: speed of cycling through digits
- * NOTE: newTransitionClock & refreshClock cannot be the same clock
+ * clock: from the list "SysTick", "WKT", "MRT0", "MRT1", "CTIMER0"
  *
- * Return: no return
+ * Return: true if reserved, false if a display already uses the timer
  */
-void sevenSegmentDisplayTextCarousel(char characterSequence[], int sequenceLength, char newTransitionClock[],
-		int transitionSpeed, bool newEnableContinousCycle, bool newEnablePadding, char refreshClock[], int refreshRate) {
-	if (strcmp(newTransitionClock, refreshClock) != 0) {
-		carouselSequenceLength = sequenceLength;
-		int padding = 0;
-		// 4 Character Padding
-		if (newEnablePadding) {
-			for (int i = 0; i < 4; i++) {
-				carouselSequence[i] = ' ';
-			}
-			padding = 4;
-			carouselSequenceLength = carouselSequenceLength + 3;
-		}
-		for (int i = 0; i < sequenceLength; i++) {
-			carouselSequence[i + padding] = characterSequence[i];
-		}
-
-		if (newEnablePadding && !newEnableContinousCycle) {
-			for (int i = 0; i < 4; i++) {
-				carouselSequence[4 + sequenceLength + i] = ' ';
-			}
-			carouselSequenceLength = carouselSequenceLength + 5;
-		}
-		// Single Character Padding
-		if (newEnableContinousCycle & !newEnablePadding) {
-			carouselSequence[sequenceLength] = ' ';
-		}
-		transitionRate = transitionSpeed;
-		cycleRate = refreshRate;
-		enableContinousCycle = newEnableContinousCycle;
-		pauseCarouselTransition = false;
-
-		if (strcmp(newTransitionClock, "SysTick") == 0) {
-			transitionClock = 0;
-			SysTick_Configuration_Seven_Segment();
-		} else if (strcmp(newTransitionClock, "WKT") == 0) {
-			transitionClock = 1;
-			WKT_Configuration_Seven_Segment();
-		} else if (strcmp(newTransitionClock, "MRT0") == 0) {
-			transitionClock = 2;
-			MRT_Configuration_Seven_Segment(MRT_CHAN0);
-		}  else if (strcmp(newTransitionClock, "MRT1") == 0) {
-			transitionClock = 3;
-			MRT_Configuration_Seven_Segment(MRT_CHAN1);
-		} else if (strcmp(newTransitionClock, "CTIMER0") == 0) {
-			transitionClock = 4;
-			CTIMER_Configuration_Seven_Segment();
-		}
-
-		transitionIndex = -1;
-		char firstScreen[] = {carouselSequence[0], carouselSequence[1], carouselSequence[2], carouselSequence[3]};
-		display4Characters(firstScreen, refreshClock, refreshRate);
+bool reserveSevenSegmentTimer(char clock[]) {
+	int index = getClockIndex(clock);
+	if (index < 0) {
+		return false;
 	}
+	return claimClock(NULL, index, SEVEN_SEGMENT_TIMER_USER);
 }
 
-
-
 /*
- * Function: sevenSegmentDisplayTextSlider
+ * Function: releaseSevenSegmentTimer
  * --------------------
- * Creating a slider for text to display 4 characters at a time and switch between character sets
- * This function calls the 2 timers configurations internally
- * Calling the respective interrupts will refresh the display and update the transition of the slider
+ * Gives a timer reserved with reserveSevenSegmentTimer back to the display functions
  *
- * characterSequence: As long of a sequence as desired of characters ("Hello World")
- * sequenceLength: Length of Sequence
- * newTransitionClock: from the list "SysTick", "WKT", "MRT0", "MRT1", "CTIMER0" as input
- * transitionSpeed: Speed of slider swapping
- * newEnableContinousCycle: true implies the slider will cycle, false implies a one shot action
- * newEnablePadding: Pad the sequence with a blank start and end screen
- * ignoreSingleSpaces: True or False, sequences with single spaces will have the spaces ignored
- * double spaces are not affected
- * Sample input and output of using the IgnoreSingleSpaces "A B C D  E F  G" -> "ABCD  EF  G"
- * refreshClock: from the list: "SysTick", "WKT", "MRT0", "MRT1", "CTIMER0"
- * refreshRate: speed of cycling through digits
- * NOTE: newTransitionClock & refreshClock cannot be the same clock
+ * clock: from the list "SysTick", "WKT", "MRT0", "MRT1", "CTIMER0"
  *
  * Return: no return
  */
-void sevenSegmentDisplayTextSlider(char characterSequence[], int sequenceLength, char newTransitionClock[],
-		int transitionSpeed, bool newEnableContinousCycle, bool newEnablePadding, bool ignoreSingleSpaces, char refreshClock[], int refreshRate) {
-	if (strcmp(newTransitionClock, refreshClock) != 0) {
-		sliderSequenceLength = sequenceLength;
-		int padding = 0;
-		// 4 Character Padding
-		if (newEnablePadding) {
-			for (int i = 0; i < 4; i++) {
-				sliderSequence[i] = ' ';
-			}
-			padding = 4;
-			sliderSequenceLength = sliderSequenceLength + 4;
-		}
-		int spaceAdjuster = 0;
-		for (int i = 0; i < sequenceLength; i++) {
-			if(ignoreSingleSpaces) {
-				if(i == 0 && characterSequence[i] == ' ' && characterSequence[i + 1] != ' ') {
-					spaceAdjuster = spaceAdjuster + 1;
-				 	sliderSequenceLength = sliderSequenceLength - 1;
-				} else if (i == (sequenceLength-1) && characterSequence[i] == ' ' && characterSequence[i - 1] != ' ') {
-					spaceAdjuster = spaceAdjuster + 1;
-					sliderSequenceLength = sliderSequenceLength - 1;
-				} else if (characterSequence[i] == ' ' && characterSequence[i - 1] != ' ' && characterSequence[i + 1] != ' ') {
-					spaceAdjuster = spaceAdjuster + 1;
-					sliderSequenceLength = sliderSequenceLength - 1;
-				} else {
-					sliderSequence[i + padding - spaceAdjuster] = characterSequence[i];
-				}
-			} else {
-				sliderSequence[i + padding] = characterSequence[i];
-			}
-
-		}
-
-		for (int i =0; i < 4 - ((sequenceLength - spaceAdjuster) % 4); i++) {
-			if ((sequenceLength - spaceAdjuster) % 4 != 0) {
-				sliderSequence[sequenceLength + padding - spaceAdjuster + i] = ' ';
-			}
-		}
-		if ((sequenceLength - spaceAdjuster) % 4 != 0) {
-			sliderSequenceLength = sliderSequenceLength + (4 - ((sequenceLength - spaceAdjuster) % 4));
-		}
-
-
-		transitionRate = transitionSpeed;
-		cycleRate = refreshRate;
-		enableContinousCycle = newEnableContinousCycle;
-		pauseSliderTransition = false;
-
-		if (strcmp(newTransitionClock, "SysTick") == 0) {
-			transitionClock = 0;
-			SysTick_Configuration_Seven_Segment();
-		} else if (strcmp(newTransitionClock, "WKT") == 0) {
-			transitionClock = 1;
-			WKT_Configuration_Seven_Segment();
-		} else if (strcmp(newTransitionClock, "MRT0") == 0) {
-			transitionClock = 2;
-			MRT_Configuration_Seven_Segment(MRT_CHAN0);
-		}  else if (strcmp(newTransitionClock, "MRT1") == 0) {
-			transitionClock = 3;
-			MRT_Configuration_Seven_Segment(MRT_CHAN1);
-		} else if (strcmp(newTransitionClock, "CTIMER0") == 0) {
-			transitionClock = 4;
-			CTIMER_Configuration_Seven_Segment();
-		}
-
-		sliderTransitionIndex = 0;
-		char firstScreen[] = {sliderSequence[0], sliderSequence[1], sliderSequence[2], sliderSequence[3]};
-		display4Characters(firstScreen, refreshClock, refreshRate);
+void releaseSevenSegmentTimer(char clock[]) {
+	int index = getClockIndex(clock);
+	if (index >= 0 && sevenSegmentTimers[index].role == SEVEN_SEGMENT_TIMER_USER) {
+		sevenSegmentTimers[index].role = SEVEN_SEGMENT_TIMER_FREE;
 	}
 }
 
-/************************************************************************************************
- * 																								*
- *									Timer Interrupt Functions									*
- * 			These functions should be called in the respective timer interrupt routine			*
- *			Allows flexibility to still use other logic within the interrupt as desired			*
- * 																								*
- ************************************************************************************************/
-
-
 /*
- * Function: display4CharactersInterrupt
+ * Function: getSevenSegmentTimerOwner
  * --------------------
- * Used to swap between digits quickly on the display
- * Should be called in the interrupt from the timer associated with the refreshRate
- * Used when display4Characters is used
+ * Tells what a timer is used for
  *
+ * clock: from the list "SysTick", "WKT", "MRT0", "MRT1", "CTIMER0"
  *
- * Return: no return
+ * Return: SEVEN_SEGMENT_TIMER_FREE, _REFRESH, _COUNTER, _TRANSITION or _USER, -1 if the name is not recognized
  */
-void display4CharactersInterrupt() {
-	clearDigits();
-	char upperCaseChar = toupper(chrSequence[currentDigit]);
-	int size = sizeof(inputCharacterOptions)/sizeof(inputCharacterOptions[0]);//Method
-
-	for (int i = 0; i < size; i++) {
-		if (upperCaseChar == inputCharacterOptions[i]) {
-			displayValue(displayOptions[i]);
-		}
-	}
-	enableDigit(currentDigit);
-	currentDigit = currentDigit + 1;
-	if (currentDigit == 4) {
-		currentDigit = 0;
-	}
-
-	// Handle Specific Details for Each Clock
-	// 0 == SysTick, 1 == WKT, 2 == MRT0, 3 = MRT1, 4 = CTIMER0
-	if (currentClock == 1) {
-		WKT->COUNT = cycleRate;
-	} else if (currentClock == 4) {
-		 CTIMER0->TCR |= CTIMER_TCR_CRST_MASK; // set bit 1 to 1
-		 CTIMER0->TCR &= ~(CTIMER_TCR_CRST_MASK); // clear bit 1 to 0
+int getSevenSegmentTimerOwner(char clock[]) {
+	int index = getClockIndex(clock);
+	if (index < 0) {
+		return -1;
 	}
-
+	return sevenSegmentTimers[index].role;
 }
 
-
 /*
- * Function: display4NumbersInterrupt
+ * Function: getSevenSegmentTimerConflicts
  * --------------------
- * Used to swap between digits quickly on the display
- * Should be called in the interrupt from the timer associated with the refreshRate
- * Just a Wrapper Function For Clarity
- * Called when digits are used, in reality display4CharactersInterrupt could be called instead
- *
- * Used when display4Numbers is used
+ * Timers a display function was refused since the last clearSevenSegmentTimerConflicts, because
+ * another display or the application was using them
  *
  *
- * Return: no return
+ * Return: bit n set for each refused timer, 0 == SysTick, 1 == WKT, 2 == MRT0, 3 = MRT1, 4 = CTIMER0
  */
-void display4NumbersInterrupt() {
-	display4CharactersInterrupt();
+int getSevenSegmentTimerConflicts() {
+	return timerConflicts;
 }
 
-
 /*
- * Function: displayCarouselInterrupt
+ * Function: clearSevenSegmentTimerConflicts
  * --------------------
- * Used to swap between digits quickly on the display
- * Should be called in the interrupt from the timer associated with the refreshRate
- * Just a Wrapper Function For Clarity
- * Called when the carousel is used, in reality display4CharactersInterrupt could be called instead
- *
- * Used when sevenSegmentDisplayTextCarousel is used
+ * Forgets the conflicts reported by getSevenSegmentTimerConflicts
  *
  *
  * Return: no return
  */
-void displayCarouselInterrupt() {
-	display4CharactersInterrupt();
+void clearSevenSegmentTimerConflicts() {
+	timerConflicts = 0;
 }
 
-
 /*
- * Function: displaySliderInterrupt
+ * Function: getClockIndex
  * --------------------
- * Used to swap between digits quickly on the display
- * Should be called in the interrupt from the timer associated with the refreshRate
- * Just a Wrapper Function For Clarity
- * Called when the slider is used, in reality display4CharactersInterrupt could be called instead
- *
- * Used when sevenSegmentDisplayTextSlider is used
+ * Converts a clock name into the internal clock index
+ * 0 == SysTick, 1 == WKT, 2 == MRT0, 3 = MRT1, 4 = CTIMER0
+ * Function called internally
  *
+ * clockType: from the list "SysTick", "WKT", "MRT0", "MRT1", "CTIMER0" as input
  *
- * Return: no return
+ * Return: clock index, -1 if the name is not recognized
  */
-void displaySliderInterrupt() {
-	display4CharactersInterrupt();
+int getClockIndex(char clockType[]) {
+	// Unused when every clock is left out by seven_segment_config.h
+	(void)clockType;
+#if SEVEN_SEGMENT_USE_SYSTICK
+	if (strcmp(clockType, "SysTick") == 0) {
+		return 0;
+	}
+#endif
+#if SEVEN_SEGMENT_USE_WKT
+	if (strcmp(clockType, "WKT") == 0) {
+		return 1;
+	}
+#endif
+#if SEVEN_SEGMENT_USE_MRT
+	if (strcmp(clockType, "MRT0") == 0) {
+		return 2;
+	}  else if (strcmp(clockType, "MRT1") == 0) {
+		return 3;
+	}
+#endif
+#if SEVEN_SEGMENT_USE_CTIMER0
+	if (strcmp(clockType, "CTIMER0") == 0) {
+		return 4;
+	}
+#endif
+	return -1;
 }
 
-
-
 /*
- * Function: updateSevenSegmentCounterInterrupt
+ * Function: startClock
  * --------------------
- * Interrupt for the counter mechanism if the seven segment display is used as a counter
- * Updates the count for the 7-segment
- * This function should be called within the interrupt that handles clock incrementing/decrementing
- *
- * Used when setupSevenSegmentCounter is used, where the clock associated with counting was passing in to counterClock
+ * Claims the clock for the display and runs the configuration function matching the clock index
+ * Nothing is set up if the clock is refused, see claimClock, the caller must then leave the clock's
+ * interrupt route and its own clock fields alone
+ * Function called internally
  *
+ * display: the display to act on
+ * clock: internal clock index (0..4), -1 is ignored
+ * role: SEVEN_SEGMENT_TIMER_REFRESH, _COUNTER or _TRANSITION
+ * rate: reload value the clock starts with
  *
- * Return: no return
+ * Return: false if the clock was refused, true otherwise
  */
-void updateSevenSegmentCounterInterrupt() {
-	if (pauseCounter == false) {
-		if (strcmp(countDirection, "UP") == 0) {
-			currentCount = currentCount + countIncrement;
-			normalizedCount = normalizedCount + countIncrement;
-		} else {
-			currentCount = currentCount - countIncrement;
-			normalizedCount = normalizedCount - countIncrement;
-		}
-
-		if (normalizedCount > 9999) {
-			normalizedCount = normalizedCount - 10000;
-		} else if(normalizedCount < 0) {
-			normalizedCount = 10000 + normalizedCount;
-		}
-
-		if(currentCount == countStopValue && enableCountStopValue == true) {
-			pauseCounter = true;
-		}
+bool startClock(SevenSegmentDisplay *display, int clock, int role, int rate) {
+	if (clock < 0) {
+		return true;
+	}
+	if (!claimClock(display, clock, role)) {
+		return false;
+	}
 
-		int shifter = 1000;
-		int number = normalizedCount;
-		for (int i = 0; i < 4; i++) {
-			chrSequence[3-i] = (number -(number % shifter))/shifter +'0';
-			number = (number % shifter);
-			shifter = shifter/10;
-		}
+	// The clock is started with a raw rate, updateSevenSegmentTiming leaves it alone until a timing function is used
+	if (role == SEVEN_SEGMENT_TIMER_REFRESH) {
+		display->refreshPeriodUs = 0;
+	} else if (role == SEVEN_SEGMENT_TIMER_COUNTER) {
+		display->countPeriodUs = 0;
+	} else {
+		display->transitionPeriodUs = 0;
 	}
 
-	if (countClock == 1) {
-		WKT->COUNT = countRate;
-	} else if (countClock == 4) {
-		 CTIMER0->TCR |= CTIMER_TCR_CRST_MASK; // set bit 1 to 1
-		 CTIMER0->TCR &= ~(CTIMER_TCR_CRST_MASK); // clear bit 1 to 0
+	// Unused when every clock is left out by seven_segment_config.h
+	(void)rate;
+#if SEVEN_SEGMENT_USE_SYSTICK
+	if (clock == 0) {
+		SysTick_Configuration_Seven_Segment(rate);
+	}
+#endif
+#if SEVEN_SEGMENT_USE_WKT
+	if (clock == 1) {
+		WKT_Configuration_Seven_Segment(rate);
 	}
+#endif
+#if SEVEN_SEGMENT_USE_MRT
+	if (clock == 2) {
+		MRT_Configuration_Seven_Segment(MRT_CHAN0, rate);
+	}  else if (clock == 3) {
+		MRT_Configuration_Seven_Segment(MRT_CHAN1, rate);
+	}
+#endif
+#if SEVEN_SEGMENT_USE_CTIMER0
+	if (clock == 4) {
+		CTIMER_Configuration_Seven_Segment(rate);
+	}
+#endif
+	setClockPriority(clock);
+	return true;
 }
 
-
 /*
- * Function: sevenSegmentCarouselInterrupt
+ * Function: startRefreshClock
  * --------------------
- * Interrupt for the carousel mechanism if the seven segment display is used as a carousel
- * Updates the currently displayed characters
- * This function should be called within the interrupt that handles carousel transitions
- *
- * Used when sevenSegmentDisplayTextCarousel is used, where the clock associated with transitions
- * was passing into newTransitionClock
+ * Records the refresh clock of the display and starts it
+ * Displays refreshed by displayMultipleInterrupt keep the shared clock and leave it running
+ * Function called internally by the setup functions
  *
+ * display: the display to act on
+ * refreshClock: from the list: "SysTick", "WKT", "MRT0", "MRT1", "CTIMER0"
+ * refreshRate: speed of cycling through digits
  *
  * Return: no return
  */
-void sevenSegmentCarouselInterrupt() {
-	if (!carouselOverflow && !pauseCarouselTransition){
-		transitionIndex = transitionIndex + 1;
-	}
-
-	int wrapAround = 0;
-	for (int i = 0; i < 4; i++) {
-		if (i + transitionIndex > carouselSequenceLength) {
-			chrSequence[3-i] = carouselSequence[wrapAround];
-			wrapAround = wrapAround + 1;
-		} else {
-			chrSequence[3-i] = carouselSequence[i + transitionIndex];
+void startRefreshClock(SevenSegmentDisplay *display, char refreshClock[], int refreshRate) {
+	display->staticSegments = -1;
+	if (!display->sharedRefresh) {
+		int clock = getClockIndex(refreshClock);
+		int rate = refreshRate;
+#if SEVEN_SEGMENT_USE_ADAPTIVE_REFRESH
+		// A mode with a content clock starts at the active rate, the first step that leaves the screen
+		// unchanged lowers it, a fixed screen has no step to lower it and starts at the static rate
+		bool adaptive = display->adaptiveStaticRate != 0 && loadAdaptiveRates(display, clock);
+		bool active = display->contentMode != SEVEN_SEGMENT_CONTENT_NONE;
+		if (adaptive) {
+			rate = active ? display->adaptiveActiveRate : display->adaptiveStaticRate;
 		}
-
-	}
-
-	if (transitionIndex == carouselSequenceLength && enableContinousCycle) {
-		transitionIndex = -1;
-	} else if (transitionIndex == (carouselSequenceLength-4) && !enableContinousCycle) {
-		carouselOverflow = true;
-	}
-
-	if (transitionClock == 1) {
-		WKT->COUNT = transitionRate;
-	} else if (transitionClock == 4) {
-		 CTIMER0->TCR |= CTIMER_TCR_CRST_MASK; // set bit 1 to 1
-		 CTIMER0->TCR &= ~(CTIMER_TCR_CRST_MASK); // clear bit 1 to 0
+#endif
+		if (!startClock(display, clock, SEVEN_SEGMENT_TIMER_REFRESH, rate)) {
+#if SEVEN_SEGMENT_USE_ADAPTIVE_REFRESH
+			// Back to the reloads of the clock still refreshing the display
+			if (adaptive) {
+				loadAdaptiveRates(display, display->refresh.currentClock);
+			}
+#endif
+			return;
+		}
+		display->refresh.cycleRate = rate;
+		display->refresh.currentClock = clock;
+#if SEVEN_SEGMENT_USE_ADAPTIVE_REFRESH
+		if (adaptive) {
+			display->adaptiveActive = active;
+		}
+#endif
+		SET_IRQ_HANDLER(clock, display4CharactersInterruptCtx, display);
 	}
+	display->refresh.currentDigit = 0;
 }
 
-
-
 /*
- * Function: sevenSegmentSliderInterrupt
+ * Function: restartClock
  * --------------------
- * Interrupt for the slider mechanism if the seven segment display is used as a slider
- * to swap between sets of 4 characters
- * Updates the currently displayed characters
- * This function should be called within the interrupt that handles slider transitions
- *
- * Used when sevenSegmentDisplayTextSlider is used, where the clock associated with transitions
- * was passing into newTransitionClock
+ * Re-arms clocks that do not reload on their own after an interrupt
+ * SysTick and the MRT channels run in repeat mode and need nothing
+ * Function called internally at the end of each interrupt helper
  *
+ * clock: internal clock index (0..4)
+ * rate: reload value for the WKT
  *
  * Return: no return
  */
-void sevenSegmentSliderInterrupt() {
-
-	for (int i = 0; i < 4; i++) {
-		chrSequence[3-i] = sliderSequence[i + sliderTransitionIndex];
+void restartClock(int clock, int rate) {
+	// Unused when the WKT or CTIMER0 is left out by seven_segment_config.h
+	(void)clock;
+	(void)rate;
+#if SEVEN_SEGMENT_USE_WKT
+	if (clock == 1) {
+		WKT->COUNT = getWKTCount(rate);
 	}
-
-	if (!pauseSliderTransition){
-		sliderTransitionIndex = sliderTransitionIndex + 4;
-	}
-	if (sliderTransitionIndex > (sliderSequenceLength - 4) && enableContinousCycle) {
-		sliderTransitionIndex = 0;
-	} else if (sliderTransitionIndex > (sliderSequenceLength - 4)) {
-		sliderTransitionIndex = sliderTransitionIndex - 4;
-		pauseSliderTransition = true;
-	}
-
-	if (transitionClock == 1) {
-		WKT->COUNT = transitionRate;
-	} else if (transitionClock == 4) {
+#endif
+#if SEVEN_SEGMENT_USE_CTIMER0
+	if (clock == 4) {
 		 CTIMER0->TCR |= CTIMER_TCR_CRST_MASK; // set bit 1 to 1
 		 CTIMER0->TCR &= ~(CTIMER_TCR_CRST_MASK); // clear bit 1 to 0
 	}
+#endif
 }
 
-
-
-/************************************************************************************************
- * 																								*
- *							Seven Segment Counter Helper Functions								*
- * 		These functions can be used to make changes to the counter in real time if in use		*
- * 																								*
- ************************************************************************************************/
-
-
 /*
- * Function: getSevenSegmentDisplayCount
+ * Function: holdClockInterrupt
  * --------------------
- * Getter for the current normalized (displayed) count
- * Normalized implies the currently displayed count value (between 0000 and 9999)
- * The actual count value may be larger as the counter wraps around when it hits the edge values
- * To get the actual count value use getSevenSegmentTotalCount instead
+ * Stops the interrupt of a clock from being taken while content is swapped, the timer keeps counting
+ * Each MRT channel is held on its own, so the other channel's display keeps refreshing
+ * A WKT, MRT or CTIMER0 interrupt raised while held is taken once resumed, a SysTick tick is skipped
+ * Function called internally
  *
- * Return: normalizedCount
+ * clock: internal clock index (0..4), -1 is ignored
+ *
+ * Return: true if the interrupt was enabled
  */
-int getSevenSegmentDisplayCount() {
-	return normalizedCount;
+bool holdClockInterrupt(int clock) {
+	bool wasEnabled = false;
+	if (clock == 0) {
+		wasEnabled = (SysTick->CTRL & SysTick_CTRL_TICKINT_Msk) != 0;
+		SysTick->CTRL &= ~(SysTick_CTRL_TICKINT_Msk);
+	} else if (clock == 1) {
+		wasEnabled = NVIC_GetEnableIRQ(WKT_IRQn) != 0;
+		NVIC_DisableIRQ(WKT_IRQn);
+	} else if (clock == 2 || clock == 3) {
+		wasEnabled = (MRT0->CHANNEL[clock - 2].CTRL & MRT_CHANNEL_CTRL_INTEN_MASK) != 0;
+		MRT0->CHANNEL[clock - 2].CTRL &= ~(MRT_CHANNEL_CTRL_INTEN_MASK);
+	} else if (clock == 4) {
+		wasEnabled = NVIC_GetEnableIRQ(CTIMER0_IRQn) != 0;
+		NVIC_DisableIRQ(CTIMER0_IRQn);
+	}
+	return wasEnabled;
 }
 
 /*
- * Function: getSevenSegmentTotalCount
+ * Function: resumeClockInterrupt
  * --------------------
- *  Getter for the actual count
- *  If overflow within the counter has happened and the counter wraps around
- *  the display value may differ from the actual count
- * To get the normalized (currently displayed) count value use getSevenSegmentDisplayCount instead
+ * Lets the interrupt of a clock held by holdClockInterrupt be taken again
+ * Function called internally
  *
- * Return: currentCount
+ * clock: internal clock index (0..4), -1 is ignored
+ * wasEnabled: value returned by holdClockInterrupt, nothing is done if false
+ *
+ * Return: no return
  */
-int getSevenSegmentTotalCount() {
-	return currentCount;
+void resumeClockInterrupt(int clock, bool wasEnabled) {
+	if (!wasEnabled) {
+		return;
+	}
+	if (clock == 0) {
+		SysTick->CTRL |= SysTick_CTRL_TICKINT_Msk;
+	} else if (clock == 1) {
+		NVIC_EnableIRQ(WKT_IRQn);
+	} else if (clock == 2 || clock == 3) {
+		MRT0->CHANNEL[clock - 2].CTRL |= MRT_CHANNEL_CTRL_INTEN_MASK;
+	} else if (clock == 4) {
+		NVIC_EnableIRQ(CTIMER0_IRQn);
+	}
 }
 
 /*
- * Function: toggleSevenSegmentCounterPause
+ * Function: setClockPeriod
  * --------------------
- *  Toggle for the counter to pause or run
+ * Changes the period of a running clock without resetting it
+ * SysTick and the MRT channels pick up the new period at their next reload
+ * The WKT and CTIMER0 pick it up when restartClock is called
+ * Function called internally
  *
+ * clock: internal clock index (0..4)
+ * period: new reload value
  *
  * Return: no return
  */
-void toggleSevenSegmentCounterPause() {
-	pauseCounter = !pauseCounter;
+void setClockPeriod(int clock, int period) {
+	// Unused when every clock is left out by seven_segment_config.h
+	(void)clock;
+	(void)period;
+#if SEVEN_SEGMENT_USE_SYSTICK
+	if (clock == 0) {
+		SysTick->LOAD = (period - 1) & SysTick_LOAD_RELOAD_Msk;
+	}
+#endif
+#if SEVEN_SEGMENT_USE_MRT
+	if (clock == 2) {
+		// Writing INTVAL without the LOAD bit leaves the current interval running
+		MRT0->CHANNEL[MRT_CHAN0].INTVAL = period & MRT_CHANNEL_INTVAL_IVALUE_MASK;
+	} else if (clock == 3) {
+		MRT0->CHANNEL[MRT_CHAN1].INTVAL = period & MRT_CHANNEL_INTVAL_IVALUE_MASK;
+	}
+#endif
+#if SEVEN_SEGMENT_USE_CTIMER0
+	if (clock == 4) {
+		CTIMER0->MR[0] = period;
+	}
+#endif
 }
 
+#if SEVEN_SEGMENT_USE_CAROUSEL || SEVEN_SEGMENT_USE_SLIDER
 /*
- * Function: pauseSevenSegmentCounter
+ * Function: getTransitionDwell
  * --------------------
- *  Pause the counter
+ * Works out how long a carousel or slider frame should stay on the display
+ * Same as easeTransitionDwell with the transition clock and transitionRate of the display
+ * Function called internally
  *
+ * display: the display to act on
+ * frame: position of the frame (0 is the first screen)
+ * frameCount: number of frames in the sequence
  *
- * Return: no return
+ * Return: reload value for the frame
  */
-void pauseSevenSegmentCounter() {
-	pauseCounter = true;
+int getTransitionDwell(SevenSegmentDisplay *display, int frame, int frameCount) {
+	return easeTransitionDwell(display, display->transitionClock, display->transitionRate, frame, frameCount);
 }
 
 /*
- * Function: runSevenSegmentCounter
+ * Function: easeTransitionDwell
  * --------------------
- * Continue running the counter
- *
- *
- * Return: no return
+ * Works out how long a carousel or slider frame should stay on the given clock
+ * Uses the per-frame dwell times if given, otherwise rate,
+ * then stretches frames near the start and/or end for the easing, up to the longest period of the clock
+ * Function called internally, also before the transition clock is recorded in the display
+ *
+ * display: the display to act on
+ * clock: internal clock index (0..4) of the transition clock
+ * rate: period of a frame without dwell times or easing
+ * frame: position of the frame (0 is the first screen)
+ * frameCount: number of frames in the sequence
+ *
+ * Return: reload value for the frame
  */
-void runSevenSegmentCounter() {
-	pauseCounter = false;
+int easeTransitionDwell(SevenSegmentDisplay *display, int clock, int rate, int frame, int frameCount) {
+	// Frame periods near the edges in quarters of the normal period (3x, 2x, 1.5x, 1.25x)
+	static const int easingScale[] = {12, 8, 6, 5};
+	int period = rate;
+	if (frame >= 0 && frame < display->transitionDwellCount) {
+		period = display->transitionDwellTimes[frame];
+	}
+
+	int scale = 4;
+	int fromEnd = frameCount - 1 - frame;
+	if ((display->transitionEasing & TRANSITION_EASE_IN) && frame >= 0 && frame < 4) {
+		scale = easingScale[frame];
+	}
+	if ((display->transitionEasing & TRANSITION_EASE_OUT) && fromEnd >= 0 && fromEnd < 4 && easingScale[fromEnd] > scale) {
+		scale = easingScale[fromEnd];
+	}
+	// Worked out in 64 bits and kept within the clock, a long period stretched 3x would overflow the int
+	// or be masked by the 24 bit SysTick and MRT reloads into a much shorter one
+	int64_t eased = ((int64_t)period * scale) / 4;
+	if (clock >= 0 && eased > (int64_t)getClockMaxReload(clock)) {
+		eased = getClockMaxReload(clock);
+	}
+	return (int)eased;
 }
 
 /*
- * Function: resetSevenSegmentCount
+ * Function: restartTransitionClock
  * --------------------
- * Resets the counter to the original value
- * Will also restart the counting sequence
+ * Re-arms the transition clock with the dwell time for the upcoming frame
+ * Without dwell times or easing this is the same as restartClock with transitionRate
+ * Function called internally by the carousel and slider interrupts
  *
+ * display: the display to act on
+ * frame: position of the frame just put on the display
+ * frameCount: number of frames in the sequence
  *
  * Return: no return
  */
-void resetSevenSegmentCount() {
-	currentCount = startCount;
-	normalizedCount = startCount;
-	pauseCounter = false;
+void restartTransitionClock(SevenSegmentDisplay *display, int frame, int frameCount) {
+	if (display->transitionDwellCount == 0 && display->transitionEasing == TRANSITION_EASE_NONE) {
+		restartClock(display->transitionClock, display->transitionRate);
+	} else if (display->transitionClock == 1 || display->transitionClock == 4) {
+		// The WKT and CTIMER0 start their next interval now
+		int period = getTransitionDwell(display, frame, frameCount);
+		setClockPeriod(display->transitionClock, period);
+		restartClock(display->transitionClock, period);
+	} else {
+		// SysTick and the MRT have already reloaded, the new period applies to the frame after this one
+		int nextFrame = frame + 1;
+		if (nextFrame >= frameCount) {
+			nextFrame = display->enableContinousCycle ? 0 : frameCount - 1;
+		}
+		setClockPeriod(display->transitionClock, getTransitionDwell(display, nextFrame, frameCount));
+	}
 }
+#endif
+
+
+/************************************************************************************************
+ * 																								*
+ * 										Content Loading Functions								*
+ * 			Load the content and mode state for the display without touching any timer			*
+ * 		Used by the timer based functions and by the sequencer when switching between jobs		*
+ * 																								*
+ ************************************************************************************************/
 
 /*
- * Function: setSevenSegmentCount
+ * Function: setScreen
  * --------------------
- * Change the count value to a new number
- * Will update the displayed and normalized value
- * Will also restart the counter, doing this may cause a need to update the users stopValue
+ * Copies 4 characters into the sequence used by the refresh interrupt
+ * The digits are stored in reverse order (digit 0 is the right most character)
+ * Function called internally
  *
- * newCount: new count value to be displayed and stored
+ * display: the display to act on
+ * screen: 4 characters to be displayed
  *
  * Return: no return
  */
-void setSevenSegmentCount(int newCount) {
-	startCount = newCount;
-	currentCount = newCount;
-	normalizedCount = newCount;
-	pauseCounter = false;
+void setScreen(SevenSegmentDisplay *display, char screen[]) {
+	// A screen set directly supersedes one still waiting for the end of the frame
+	display->refresh.screenPending = false;
+	for (int i = 0; i < 4; i++) {
+		display->refresh.chrSequence[3-i] = screen[i];
+	}
 }
 
 /*
- * Function: updateSevenSegmentIncrementer
+ * Function: setScreenNumber
  * --------------------
- * Change the count increment/decrement value to a new number
+ * Converts a number (0000 .. 9999) into the 4 characters used by the refresh interrupt
+ * Function called internally
  *
- * newIncrement: an integer value for changing the increment or decrement amount
+ * display: the display to act on
+ * number: value to be displayed
  *
  * Return: no return
  */
-void updateSevenSegmentIncrementer(int newIncrement) {
-	countIncrement = newIncrement;
+void setScreenNumber(SevenSegmentDisplay *display, int number) {
+	display->refresh.screenPending = false;
+	formatScreenNumber(display->refresh.chrSequence, number);
 }
 
 /*
- * Function: changeSevenSegmentCountDirection
+ * Function: formatScreenNumber
  * --------------------
- * Change the count direction to either "UP" or "DOWN"
- * If an incorrect string is entered, no change will be applied
- *
- * newDirection: either "UP' or "DOWN" as required
+ * Converts a number (0000 .. 9999) into 4 characters stored in reverse order like chrSequence
+ * Function called internally
  *
+ * target: 4 characters to write
+ * number: value to be displayed
  *
  * Return: no return
  */
-void changeSevenSegmentCountDirection(char newDirection[]) {
-	if (strcmp(newDirection, "UP") == 0) {
-		strncpy(countDirection, "UP", 4);
-	} else if (strcmp(newDirection, "DOWN") == 0) {
-		strncpy(countDirection, "DOWN", 4);
+void formatScreenNumber(char target[], int number) {
+	int shifter = 1000;
+	for (int i = 0; i < 4; i++) {
+		target[3-i] = (number -(number % shifter))/shifter +'0';
+		number = (number % shifter);
+		shifter = shifter/10;
 	}
 }
 
+/*
+ * Function: queueScreen
+ * --------------------
+ * Queues 4 characters to replace the displayed ones at the end of the frame being refreshed,
+ * so a frame never shows part of the old screen and part of the new one
+ * Function called internally by the content swap functions
+ *
+ * display: the display to act on
+ * screen: 4 characters to be displayed
+ *
+ * Return: no return
+ */
+void queueScreen(SevenSegmentDisplay *display, char screen[]) {
+	for (int i = 0; i < 4; i++) {
+		display->pendingScreen[3-i] = screen[i];
+	}
+	display->refresh.screenPending = true;
+}
 
 /*
- * Function: setCountStopValue
+ * Function: queueScreenNumber
  * --------------------
- * Change the stop value for the counter
- * Will also enable the stop condition automatically
- * Will also continue the counter if previously paused, but will pause the counter
- * if the new stop value equals the current count
+ * Same as queueScreen for a number (0000 .. 9999)
+ * Function called internally by the content swap functions
  *
- * newStopValue: the new integer value for the counter to stop at
+ * display: the display to act on
+ * number: value to be displayed
+ *
+ * Return: no return
+ */
+void queueScreenNumber(SevenSegmentDisplay *display, int number) {
+	formatScreenNumber(display->pendingScreen, number);
+	display->refresh.screenPending = true;
+}
+
+#if SEVEN_SEGMENT_USE_COUNTER
+/*
+ * Function: loadCounter
+ * --------------------
+ * Loads the counter state without configuring the counter clock
+ * Function called internally
  *
+ * display: the display to act on
+ * clockStart: Starting time for the display
+ * newCountDirection: "UP" or "DOWN"
+ * newCountIncrement: counter increment/decrement depending on direction (negatives are allowed)
+ * newStopValue: early stop point for counting
+ * enableStopValue: true or false
  *
  * Return: no return
  */
-void setCountStopValue(int newStopValue) {
-	enableCountStopValue = true;
-	countStopValue = newStopValue;
-	if (currentCount != countStopValue) {
-		pauseCounter = false;
+void loadCounter(SevenSegmentDisplay *display, int clockStart, char newCountDirection[], int newCountIncrement, int newStopValue,
+		bool enableStopValue) {
+	display->startCount = clockStart;
+	display->normalizedCount = clockStart;
+	display->currentCount = clockStart;
+
+	if (strcmp(newCountDirection, "UP") == 0) {
+		strncpy(display->countDirection, "UP", sizeof display->countDirection);
 	} else {
-		pauseCounter = true;
+		strncpy(display->countDirection, "DOWN", sizeof display->countDirection);
 	}
+
+	display->countStopValue = newStopValue;
+	display->enableCountStopValue = enableStopValue;
+	display->countIncrement = newCountIncrement;
+	display->pauseCounter = false;
 }
+#endif
 
+#if SEVEN_SEGMENT_USE_CAROUSEL
 /*
- * Function: clearCountStopValue
+ * Function: loadCarouselSequence
  * --------------------
- * Change the stop value for the counter
- * Will also enable the stop condition automatically
- * Will also continue the counter if previously paused, but will pause the counter
- * if the new stop value equals the current count
- *
- * newStopValue: the new integer value for the counter to stop at
+ * Builds the carousel sequence and resets the carousel position without configuring any clock
+ * Sequences longer than MAX_SEQUENCE_LENGTH are cut short
+ * Function called internally
  *
+ * display: the display to act on
+ * characterSequence: As long of a sequence as desired of characters ("Hello World")
+ * sequenceLength: Length of Sequence
+ * newEnableContinousCycle: true implies the coaursel will cycle, false implies a one shot action
+ * newEnablePadding: Pad the sequence with a blank start and end screen
  *
  * Return: no return
  */
-void clearCountStopValue(){
-	enableCountStopValue = false;
-	countStopValue = 0;
-	pauseCounter = false;
+void loadCarouselSequence(SevenSegmentDisplay *display, char characterSequence[], int sequenceLength, bool newEnableContinousCycle,
+		bool newEnablePadding) {
+	if (sequenceLength > MAX_SEQUENCE_LENGTH) {
+		sequenceLength = MAX_SEQUENCE_LENGTH;
+	}
+	display->carouselSequenceLength = sequenceLength;
+	int padding = 0;
+	// 4 Character Padding
+	if (newEnablePadding) {
+		for (int i = 0; i < 4; i++) {
+			display->carouselSequence[i] = ' ';
+		}
+		padding = 4;
+		display->carouselSequenceLength = display->carouselSequenceLength + 3;
+	}
+	for (int i = 0; i < sequenceLength; i++) {
+		display->carouselSequence[i + padding] = characterSequence[i];
+	}
+
+	if (newEnablePadding && !newEnableContinousCycle) {
+		for (int i = 0; i < 4; i++) {
+			display->carouselSequence[4 + sequenceLength + i] = ' ';
+		}
+		display->carouselSequenceLength = display->carouselSequenceLength + 5;
+	}
+	// Single Character Padding
+	if (newEnableContinousCycle & !newEnablePadding) {
+		display->carouselSequence[sequenceLength] = ' ';
+	}
+	display->enableContinousCycle = newEnableContinousCycle;
+	display->pauseCarouselTransition = false;
+	display->carouselOverflow = false;
+	display->transitionIndex = -1;
 }
+#endif
+
+#if SEVEN_SEGMENT_USE_SLIDER
+/*
+ * Function: loadSliderSequence
+ * --------------------
+ * Builds the slider sequence and resets the slider position without configuring any clock
+ * Sequences longer than MAX_SEQUENCE_LENGTH are cut short
+ * Function called internally
+ *
+ * display: the display to act on
+ * characterSequence: As long of a sequence as desired of characters ("Hello World")
+ * sequenceLength: Length of Sequence
+ * newEnableContinousCycle: true implies the slider will cycle, false implies a one shot action
+ * newEnablePadding: Pad the sequence with a blank start and end screen
+ * ignoreSingleSpaces: True or False, sequences with single spaces will have the spaces ignored
+ *
+ * Return: no return
+ */
+void loadSliderSequence(SevenSegmentDisplay *display, char characterSequence[], int sequenceLength, bool newEnableContinousCycle,
+		bool newEnablePadding, bool ignoreSingleSpaces) {
+	if (sequenceLength > MAX_SEQUENCE_LENGTH) {
+		sequenceLength = MAX_SEQUENCE_LENGTH;
+	}
+	display->sliderSequenceLength = sequenceLength;
+	int padding = 0;
+	// 4 Character Padding
+	if (newEnablePadding) {
+		for (int i = 0; i < 4; i++) {
+			display->sliderSequence[i] = ' ';
+		}
+		padding = 4;
+		display->sliderSequenceLength = display->sliderSequenceLength + 4;
+	}
+	int spaceAdjuster = 0;
+	for (int i = 0; i < sequenceLength; i++) {
+		if(ignoreSingleSpaces) {
+			if(i == 0 && characterSequence[i] == ' ' && characterSequence[i + 1] != ' ') {
+				spaceAdjuster = spaceAdjuster + 1;
+			 	display->sliderSequenceLength = display->sliderSequenceLength - 1;
+			} else if (i == (sequenceLength-1) && characterSequence[i] == ' ' && characterSequence[i - 1] != ' ') {
+				spaceAdjuster = spaceAdjuster + 1;
+				display->sliderSequenceLength = display->sliderSequenceLength - 1;
+			} else if (characterSequence[i] == ' ' && characterSequence[i - 1] != ' ' && characterSequence[i + 1] != ' ') {
+				spaceAdjuster = spaceAdjuster + 1;
+				display->sliderSequenceLength = display->sliderSequenceLength - 1;
+			} else {
+				display->sliderSequence[i + padding - spaceAdjuster] = characterSequence[i];
+			}
+		} else {
+			display->sliderSequence[i + padding] = characterSequence[i];
+		}
 
+	}
 
-/************************************************************************************************
- * 																								*
- *							Seven Segment Carousel Helper Functions								*
- * 		These functions can be used to make changes to the carousel in real time if in use		*
- * 																								*
- ************************************************************************************************/
+	for (int i =0; i < 4 - ((sequenceLength - spaceAdjuster) % 4); i++) {
+		if ((sequenceLength - spaceAdjuster) % 4 != 0) {
+			display->sliderSequence[sequenceLength + padding - spaceAdjuster + i] = ' ';
+		}
+	}
+	if ((sequenceLength - spaceAdjuster) % 4 != 0) {
+		display->sliderSequenceLength = display->sliderSequenceLength + (4 - ((sequenceLength - spaceAdjuster) % 4));
+	}
+
+	display->enableContinousCycle = newEnableContinousCycle;
+	display->pauseSliderTransition = false;
+	display->sliderTransitionIndex = 0;
+	display->sliderPagesShown = 0;
+}
+#endif
 
 
+#if SEVEN_SEGMENT_USE_SEQUENCER
 /*
- * Function: togglePauseSevenSegmentDisplayCarousel
+ * Function: loadSequencerJob
  * --------------------
- *  Toggle the pause on the carousel motion
+ * Loads the content of a sequencer job and displays its first screen
+ * The refresh and transition clocks are left running as they are
+ * Function called internally
  *
+ * display: the display to act on
+ * jobIndex: position of the job within the playlist
  *
  * Return: no return
  */
-void togglePauseSevenSegmentDisplayCarousel() {
-	pauseCarouselTransition = !pauseCarouselTransition;
+void loadSequencerJob(SevenSegmentDisplay *display, int jobIndex) {
+	SevenSegmentJob *job = &display->sequencerJobs[jobIndex];
+	display->sequencerJobIndex = jobIndex;
+	display->sequencerJobTicks = 0;
+
+	// Jobs of a mode left out of the library show the first 4 characters of their text
+	if (job->jobType == SEQUENCER_JOB_STATIC) {
+		setScreen(display, job->text);
+#if SEVEN_SEGMENT_USE_CAROUSEL
+	} else if (job->jobType == SEQUENCER_JOB_CAROUSEL) {
+		loadCarouselSequence(display, job->text, job->textLength, job->enableContinousCycle, job->enablePadding);
+		setScreen(display, display->carouselSequence);
+#endif
+#if SEVEN_SEGMENT_USE_SLIDER
+	} else if (job->jobType == SEQUENCER_JOB_SLIDER) {
+		loadSliderSequence(display, job->text, job->textLength, job->enableContinousCycle, job->enablePadding,
+				job->ignoreSingleSpaces);
+		setScreen(display, display->sliderSequence);
+#endif
+#if SEVEN_SEGMENT_USE_COUNTER
+	} else if (job->jobType == SEQUENCER_JOB_COUNTER) {
+		loadCounter(display, job->countStart, job->countDirection, job->countIncrement, job->countStopValue,
+				job->completion == SEQUENCER_DONE_COUNTER);
+		setScreenNumber(display, job->countStart);
+#endif
+	} else {
+		setScreen(display, job->text);
+	}
 }
 
 /*
- * Function: pauseSevenSegmentDisplayCarousel
+ * Function: sequencerJobDone
  * --------------------
- *  Pause the carousel motion
+ * Checks the completion condition of a sequencer job
+ * Function called internally
  *
+ * display: the display to act on
+ * job: the job currently being displayed
  *
- * Return: no return
+ * Return: true if the sequencer should move on to the next job
  */
-void pauseSevenSegmentDisplayCarousel() {
-	pauseCarouselTransition = true;
+bool sequencerJobDone(SevenSegmentDisplay *display, SevenSegmentJob *job) {
+	if (job->completion == SEQUENCER_DONE_TICKS) {
+		return display->sequencerJobTicks >= job->completionValue;
+#if SEVEN_SEGMENT_USE_CAROUSEL
+	} else if (job->completion == SEQUENCER_DONE_CAROUSEL) {
+		return display->carouselOverflow;
+#endif
+#if SEVEN_SEGMENT_USE_COUNTER
+	} else if (job->completion == SEQUENCER_DONE_COUNTER) {
+		return display->pauseCounter && display->currentCount == display->countStopValue;
+#endif
+#if SEVEN_SEGMENT_USE_SLIDER
+	} else if (job->completion == SEQUENCER_DONE_SLIDER_PAGES) {
+		// A one shot slider pauses itself on the last page
+		return display->sliderPagesShown >= job->completionValue || (display->pauseSliderTransition && !display->enableContinousCycle);
+#endif
+	}
+	return display->sequencerJobTicks >= job->completionValue;
 }
+#endif
+
+
+/****************************************************************************************************
+ * 																									*
+ *									Timer Based Functions											*
+ * 			These functions use at least 1 internal clock of the users choice						*
+ *	Functions include: displaying 4 characters simultaneously, displaying 4 numbers simultaneously,	*
+ *				a counting display, a carousel display, and a slider display						*
+ * 																									*
+ ****************************************************************************************************/
+
 
 /*
- * Function: runSevenSegmentDisplayCarousel
+ * Function: display4CharactersCtx
  * --------------------
- *  Continue the carousel motion if paused
+ * Function used to display 4 characters continuously on the 7 segment display
+ * This function calls the timer configurations internally
  *
+ * display: the display to act on
+ * inputSequence: Takes 4 character input
+ * clockType: from the list "SysTick", "WKT", "MRT0", "MRT1", "CTIMER0" as input
+ * refreshRate: how fast the 4 characters are cycled through on the 7-segment display
  *
  * Return: no return
  */
-void runSevenSegmentDisplayCarousel() {
-	pauseCarouselTransition = false;
+void display4CharactersCtx(SevenSegmentDisplay *display, char inputSequence[], char clockType[], int refreshRate) {
+	setScreen(display, inputSequence);
+	startRefreshClock(display, clockType, refreshRate);
 }
 
+
 /*
- * Function: restartSevenSegmentDisplayCarousel
+ * Function: display4NumbersCtx
  * --------------------
- *  Start carousel from beginning sequence again
- *  Removes the pause on the carousel if any
+ * Function used to display 4 numbers continuously on the 7 segment display
+ * This function calls the timer configurations internally
  *
+ * display: the display to act on
+ * inputSequence: Takes 4 character input
+ * clockType: from the list "SysTick", "WKT", "MRT0", "MRT1", "CTIMER0" as input
+ * refreshRate: how fast the 4 numbers are cycled through on the 7-segment display
  *
  * Return: no return
  */
-void restartSevenSegmentDisplayCarousel() {
-	transitionIndex = -1;
-	carouselOverflow = false;
-	pauseCarouselTransition = false;
+void display4NumbersCtx(SevenSegmentDisplay *display, int inputNumber, char clockType[], int refreshRate) {
+	int shifter = 1000;
+	int number = inputNumber;
+	char inputSequence[4] = "    ";
+	for (int i = 0; i < 4; i++) {
+		inputSequence[i] = (number -(number % shifter))/shifter +'0';
+		number = (number % shifter);
+		shifter = shifter/10;
+	}
+	display4CharactersCtx(display, inputSequence, clockType, refreshRate);
 }
 
 
+#if SEVEN_SEGMENT_USE_COUNTER
+/*
+ * Function: setupSevenSegmentCounterCtx
+ * --------------------
+ * Function used to display a counter on the 7 segment display
+ * This function calls the 2 timers configurations internally
+ * Calling the respective interrupts will refresh the display and update the counter
+ *
+ * display: the display to act on
+ * clockStart: Starting time for the display
+ * clockType: from the list "SysTick", "WKT", "MRT0", "MRT1", "CTIMER0" as input
+ * newCountDirection: "UP" or "DOWN"
+ * newCountIncrement: counter increment/decrement depending on direction (negatives are allowed)
+ * newStopValue: early stop point for counting
+ * enableStopValue: true or false
+ * newCountRate: Speed of counting progression
+ * refreshClock: from the list: "SysTick", "WKT", "MRT0", "MRT1", "CTIMER0"
+ * refreshRate: how fast the numbers are cycled through on the 7-segment display
+ * NOTE: counterClock & refreshClock cannot be the same clock
+ *
+ * Return: no return
+ */
+void setupSevenSegmentCounterCtx(SevenSegmentDisplay *display, int clockStart, char counterClock[],  char newCountDirection[],
+		int newCountIncrement, int newStopValue, bool enableStopValue, int newCountRate, char refreshClock[], int refreshRate) {
 
-/************************************************************************************************
- * 																								*
- *							Seven Segment Slider Helper Functions								*
- * 		These functions can be used to make changes to the slider in real time if in use		*
- * 																								*
- ************************************************************************************************/
+	if (strcmp(counterClock, refreshClock) != 0) {
+		loadCounter(display, clockStart, newCountDirection, newCountIncrement, newStopValue, enableStopValue);
+		int clock = getClockIndex(counterClock);
+		if (!startClock(display, clock, SEVEN_SEGMENT_TIMER_COUNTER, newCountRate)) {
+			return;
+		}
+		display->countRate = newCountRate;
+		display->countClock = clock;
+		SET_IRQ_HANDLER(display->countClock, updateSevenSegmentCounterInterruptCtx, display);
+		display->contentMode = SEVEN_SEGMENT_CONTENT_COUNTER;
+
+		display4NumbersCtx(display, clockStart, refreshClock, refreshRate);
+	}
+}
+#endif
 
+
+#if SEVEN_SEGMENT_USE_CAROUSEL
 /*
- * Function: pauseSevenSegmentDisplaySlider
+ * Function: sevenSegmentDisplayTextCarouselCtx
  * --------------------
- * Pause slider animation for the display
+ * Function used to display a carousel of characters on the 7 segment display
+ * This function calls the 2 timers configurations internally
+ * Calling the respective interrupts will refresh the display and update the transition of the carousel
+ * Creating a carousel sequence of text (loops on the display counter clockwise)
  *
+ * display: the display to act on
+ * characterSequence: As long of a sequence as desired of characters ("Hello World")
+ * sequenceLength: Length of Sequence
+ * newTransitionClock: from the list "SysTick", "WKT", "MRT0", "MRT1", "CTIMER0" as input
+ * transitionSpeed: Speed of carousel motion
+ * newEnableContinousCycle: true implies the coaursel will cycle, false implies a one shot action
+ * newEnablePadding: Pad the sequence with a blank start and end screen
+ * refreshClock: from the list: "SysTick", "WKT", "MRT0", "MRT1", "CTIMER0"
+ * refreshRate: speed of cycling through digits
+ * NOTE: newTransitionClock & refreshClock cannot be the same clock
  *
  * Return: no return
  */
-void pauseSevenSegmentDisplaySlider() {
-	pauseSliderTransition = true;
+void sevenSegmentDisplayTextCarouselCtx(SevenSegmentDisplay *display, char characterSequence[], int sequenceLength, char newTransitionClock[],
+		int transitionSpeed, bool newEnableContinousCycle, bool newEnablePadding, char refreshClock[], int refreshRate) {
+	if (strcmp(newTransitionClock, refreshClock) != 0) {
+		loadCarouselSequence(display, characterSequence, sequenceLength, newEnableContinousCycle, newEnablePadding);
+		int clock = getClockIndex(newTransitionClock);
+		int frameCount = getCarouselFrameCount(display);
+		// The first screen gets its own dwell time and easing from the start
+		if (!startClock(display, clock, SEVEN_SEGMENT_TIMER_TRANSITION,
+				easeTransitionDwell(display, clock, transitionSpeed, 0, frameCount))) {
+			return;
+		}
+		display->transitionRate = transitionSpeed;
+		display->transitionClock = clock;
+		// Loads the period of the second screen into SysTick and the MRT for their first reload
+		restartTransitionClock(display, 0, frameCount);
+		SET_IRQ_HANDLER(display->transitionClock, sevenSegmentCarouselInterruptCtx, display);
+		display->contentMode = SEVEN_SEGMENT_CONTENT_CAROUSEL;
+
+		char firstScreen[] = {display->carouselSequence[0], display->carouselSequence[1], display->carouselSequence[2], display->carouselSequence[3]};
+		display4CharactersCtx(display, firstScreen, refreshClock, refreshRate);
+	}
 }
+#endif
 
 
+
+#if SEVEN_SEGMENT_USE_SLIDER
 /*
- * Function: togglePauseSevenSegmentDisplaySlider
+ * Function: sevenSegmentDisplayTextSliderCtx
  * --------------------
- * Toggle whether the slider animation is running or not for the display
+ * Creating a slider for text to display 4 characters at a time and switch between character sets
+ * This function calls the 2 timers configurations internally
+ * Calling the respective interrupts will refresh the display and update the transition of the slider
  *
+ * display: the display to act on
+ * characterSequence: As long of a sequence as desired of characters ("Hello World")
+ * sequenceLength: Length of Sequence
+ * newTransitionClock: from the list "SysTick", "WKT", "MRT0", "MRT1", "CTIMER0" as input
+ * transitionSpeed: Speed of slider swapping
+ * newEnableContinousCycle: true implies the slider will cycle, false implies a one shot action
+ * newEnablePadding: Pad the sequence with a blank start and end screen
+ * ignoreSingleSpaces: True or False, sequences with single spaces will have the spaces ignored
+ * double spaces are not affected
+ * Sample input and output of using the IgnoreSingleSpaces "A B C D  E F  G" -> "ABCD  EF  G"
+ * refreshClock: from the list: "SysTick", "WKT", "MRT0", "MRT1", "CTIMER0"
+ * refreshRate: speed of cycling through digits
+ * NOTE: newTransitionClock & refreshClock cannot be the same clock
  *
  * Return: no return
  */
-void togglePauseSevenSegmentDisplaySlider() {
-	pauseSliderTransition = !pauseSliderTransition;
+void sevenSegmentDisplayTextSliderCtx(SevenSegmentDisplay *display, char characterSequence[], int sequenceLength, char newTransitionClock[],
+		int transitionSpeed, bool newEnableContinousCycle, bool newEnablePadding, bool ignoreSingleSpaces, char refreshClock[], int refreshRate) {
+	if (strcmp(newTransitionClock, refreshClock) != 0) {
+		loadSliderSequence(display, characterSequence, sequenceLength, newEnableContinousCycle, newEnablePadding, ignoreSingleSpaces);
+		int clock = getClockIndex(newTransitionClock);
+		int frameCount = display->sliderSequenceLength / 4;
+		// The first screen gets its own dwell time and easing from the start
+		if (!startClock(display, clock, SEVEN_SEGMENT_TIMER_TRANSITION,
+				easeTransitionDwell(display, clock, transitionSpeed, 0, frameCount))) {
+			return;
+		}
+		display->transitionRate = transitionSpeed;
+		display->transitionClock = clock;
+		// Loads the period of the second screen into SysTick and the MRT for their first reload
+		restartTransitionClock(display, 0, frameCount);
+		SET_IRQ_HANDLER(display->transitionClock, sevenSegmentSliderInterruptCtx, display);
+		display->contentMode = SEVEN_SEGMENT_CONTENT_SLIDER;
+
+		char firstScreen[] = {display->sliderSequence[0], display->sliderSequence[1], display->sliderSequence[2], display->sliderSequence[3]};
+		display4CharactersCtx(display, firstScreen, refreshClock, refreshRate);
+	}
 }
+#endif
 
+#if SEVEN_SEGMENT_USE_CAROUSEL
 /*
- * Function: runSevenSegmentDisplaySlider
+ * Function: sevenSegmentDisplayTextCarouselWithDwellCtx
  * --------------------
- * Run slider animation for the display
+ * Same as sevenSegmentDisplayTextCarousel, with a different period for each screen of the carousel
+ * The transition clock period is changed between screens without resetting the clock
  *
+ * display: the display to act on
+ * characterSequence .. refreshRate: as for sevenSegmentDisplayTextCarousel
+ * dwellTimes: period of each screen in the same units as transitionSpeed, NULL to use transitionSpeed
+ * dwellCount: number of entries in dwellTimes, later screens use transitionSpeed
+ * easing: TRANSITION_EASE_NONE, TRANSITION_EASE_IN, TRANSITION_EASE_OUT or TRANSITION_EASE_IN_OUT
  *
  * Return: no return
  */
-void runSevenSegmentDisplaySlider() {
-	pauseSliderTransition = false;
+void sevenSegmentDisplayTextCarouselWithDwellCtx(SevenSegmentDisplay *display, char characterSequence[], int sequenceLength, char newTransitionClock[],
+		int transitionSpeed, bool newEnableContinousCycle, bool newEnablePadding, char refreshClock[], int refreshRate,
+		int dwellTimes[], int dwellCount, int easing) {
+	setSevenSegmentTransitionDwellCtx(display, dwellTimes, dwellCount, easing);
+	sevenSegmentDisplayTextCarouselCtx(display, characterSequence, sequenceLength, newTransitionClock, transitionSpeed,
+			newEnableContinousCycle, newEnablePadding, refreshClock, refreshRate);
 }
+#endif
 
-
+#if SEVEN_SEGMENT_USE_SLIDER
 /*
- * Function: restartSevenSegmentDisplaySlider
+ * Function: sevenSegmentDisplayTextSliderWithDwellCtx
  * --------------------
- * Restart slider animation for the display
- * Will also run the display if previously paused
+ * Same as sevenSegmentDisplayTextSlider, with a different period for each page of the slider
+ * The transition clock period is changed between pages without resetting the clock
  *
+ * display: the display to act on
+ * characterSequence .. refreshRate: as for sevenSegmentDisplayTextSlider
+ * dwellTimes: period of each page in the same units as transitionSpeed, NULL to use transitionSpeed
+ * dwellCount: number of entries in dwellTimes, later pages use transitionSpeed
+ * easing: TRANSITION_EASE_NONE, TRANSITION_EASE_IN, TRANSITION_EASE_OUT or TRANSITION_EASE_IN_OUT
  *
  * Return: no return
  */
-void restartSevenSegmentDisplaySlider() {
-	sliderTransitionIndex = 0;
-	pauseSliderTransition = false;
+void sevenSegmentDisplayTextSliderWithDwellCtx(SevenSegmentDisplay *display, char characterSequence[], int sequenceLength, char newTransitionClock[],
+		int transitionSpeed, bool newEnableContinousCycle, bool newEnablePadding, bool ignoreSingleSpaces,
+		char refreshClock[], int refreshRate, int dwellTimes[], int dwellCount, int easing) {
+	setSevenSegmentTransitionDwellCtx(display, dwellTimes, dwellCount, easing);
+	sevenSegmentDisplayTextSliderCtx(display, characterSequence, sequenceLength, newTransitionClock, transitionSpeed,
+			newEnableContinousCycle, newEnablePadding, ignoreSingleSpaces, refreshClock, refreshRate);
+}
+#endif
+
+#if SEVEN_SEGMENT_USE_SEQUENCER
+/*
+ * Function: setupSevenSegmentSequencerCtx
+ * --------------------
+ * Runs a playlist of display jobs (static screens, carousels, sliders and counters) one after another
+ * This function calls the 2 timers configurations internally, once for the whole playlist
+ * Calling the respective interrupts will refresh the display and step through the playlist
+ * Jobs move on when their completion condition is met, without reconfiguring either clock
+ *
+ * display: the display to act on
+ * jobs: playlist of jobs, must stay valid while the sequencer is running
+ * jobCount: number of jobs in the playlist
+ * loopPlaylist: true implies the playlist starts over after the last job, false stops on the last screen
+ * newTransitionClock: from the list "SysTick", "WKT", "MRT0", "MRT1", "CTIMER0" as input
+ * transitionSpeed: Speed of all carousel, slider and counter steps as well as the unit of job durations
+ * refreshClock: from the list: "SysTick", "WKT", "MRT0", "MRT1", "CTIMER0"
+ * refreshRate: speed of cycling through digits
+ * NOTE: newTransitionClock & refreshClock cannot be the same clock
+ *
+ * Return: no return
+ */
+void setupSevenSegmentSequencerCtx(SevenSegmentDisplay *display, SevenSegmentJob jobs[], int jobCount, bool loopPlaylist, char newTransitionClock[],
+		int transitionSpeed, char refreshClock[], int refreshRate) {
+	if (strcmp(newTransitionClock, refreshClock) != 0 && jobCount > 0) {
+		display->sequencerJobs = jobs;
+		display->sequencerJobCount = jobCount;
+		display->sequencerLoop = loopPlaylist;
+		display->pauseSequencer = false;
+		display->sequencerFinished = false;
+		loadSequencerJob(display, 0);
+
+		int clock = getClockIndex(newTransitionClock);
+		if (!startClock(display, clock, SEVEN_SEGMENT_TIMER_TRANSITION, transitionSpeed)) {
+			return;
+		}
+		display->transitionRate = transitionSpeed;
+		display->transitionClock = clock;
+		SET_IRQ_HANDLER(display->transitionClock, sevenSegmentSequencerInterruptCtx, display);
+		display->contentMode = SEVEN_SEGMENT_CONTENT_SEQUENCER;
+
+		startRefreshClock(display, refreshClock, refreshRate);
+	}
+}
+#endif
+
+/************************************************************************************************
+ * 																								*
+ *									Content Swap Functions										*
+ * 		Replace what a running display shows without reconfiguring the refresh clock or the		*
+ * 		counter/transition clock, the new first screen is shown from the next frame on			*
+ * 																								*
+ ************************************************************************************************/
+
+/*
+ * Function: getContentClock
+ * --------------------
+ * Clock running the mode of the display, the counter clock for a counter, the transition clock otherwise
+ * Function called internally
+ *
+ * display: the display to act on
+ *
+ * Return: internal clock index (0..4), -1 if no mode is running or the display does not own the clock
+ */
+int getContentClock(SevenSegmentDisplay *display) {
+	int clock = display->transitionClock;
+	if (display->contentMode == SEVEN_SEGMENT_CONTENT_NONE) {
+		return -1;
+	} else if (display->contentMode == SEVEN_SEGMENT_CONTENT_COUNTER) {
+		clock = display->countClock;
+	}
+	if (clock < 0 || sevenSegmentTimers[clock].display != display) {
+		return -1;
+	}
+	return clock;
+}
+
+/*
+ * Function: beginContentSwap
+ * --------------------
+ * Holds the refresh and content clock interrupts of the display so neither sees half swapped content
+ * Both timers keep counting, see holdClockInterrupt
+ * Function called internally by the content swap functions
+ *
+ * display: the display to act on
+ *
+ * Return: interrupts to resume, handed to finishContentSwap
+ */
+int beginContentSwap(SevenSegmentDisplay *display) {
+	int held = 0;
+	if (holdClockInterrupt(getContentClock(display))) {
+		held = held | 1;
+	}
+	if (holdClockInterrupt(display->refresh.currentClock)) {
+		held = held | 2;
+	}
+	return held;
+}
+
+/*
+ * Function: moveContentClock
+ * --------------------
+ * Hands the running content clock and its period over to the new mode
+ * A counter runs on countClock and the other modes on transitionClock, the timer itself is not touched
+ * Function called internally by the content swap functions
+ *
+ * display: the display to act on
+ * newMode: SEVEN_SEGMENT_CONTENT_... mode about to be loaded
+ *
+ * Return: no return
+ */
+void moveContentClock(SevenSegmentDisplay *display, int newMode) {
+	int clock = getContentClock(display);
+	if (clock < 0) {
+		display->contentMode = newMode;
+		return;
+	}
+
+	int role = SEVEN_SEGMENT_TIMER_TRANSITION;
+	if (newMode == SEVEN_SEGMENT_CONTENT_COUNTER && display->contentMode != SEVEN_SEGMENT_CONTENT_COUNTER) {
+		display->countClock = display->transitionClock;
+		display->countRate = display->transitionRate;
+		display->countPeriodUs = display->transitionPeriodUs;
+		display->transitionClock = -1;
+		role = SEVEN_SEGMENT_TIMER_COUNTER;
+	} else if (newMode != SEVEN_SEGMENT_CONTENT_COUNTER && display->contentMode == SEVEN_SEGMENT_CONTENT_COUNTER) {
+		display->transitionClock = display->countClock;
+		display->transitionRate = display->countRate;
+		display->transitionPeriodUs = display->countPeriodUs;
+		display->countClock = -1;
+	} else {
+		role = sevenSegmentTimers[clock].role;
+	}
+	sevenSegmentTimers[clock].role = role;
+	display->contentMode = newMode;
+}
+
+/*
+ * Function: finishContentSwap
+ * --------------------
+ * Resumes the interrupts held by beginContentSwap
+ * A display that is not being refreshed has no frame to wait for, its queued screen is shown at once
+ * Function called internally by the content swap functions
+ *
+ * display: the display to act on
+ * held: value returned by beginContentSwap
+ *
+ * Return: no return
+ */
+void finishContentSwap(SevenSegmentDisplay *display, int held) {
+	if (display->refresh.currentClock < 0 && display->refresh.screenPending) {
+		for (int i = 0; i < 4; i++) {
+			display->refresh.chrSequence[i] = display->pendingScreen[i];
+		}
+		display->refresh.screenPending = false;
+	}
+	resumeClockInterrupt(display->refresh.currentClock, (held & 2) != 0);
+	resumeClockInterrupt(getContentClock(display), (held & 1) != 0);
+}
+
+#if SEVEN_SEGMENT_USE_CAROUSEL
+/*
+ * Function: setCarouselTextCtx
+ * --------------------
+ * Replaces the content with a carousel, keeping the clocks of the running mode
+ * The counter or transition clock moves on the carousel at its current period
+ * If no mode is running the carousel only shows its first screen until a clock is started
+ *
+ * display: the display to act on
+ * characterSequence: As long of a sequence as desired of characters ("Hello World")
+ * sequenceLength: Length of Sequence
+ * newEnableContinousCycle: true implies the coaursel will cycle, false implies a one shot action
+ * newEnablePadding: Pad the sequence with a blank start and end screen
+ *
+ * Return: no return
+ */
+void setCarouselTextCtx(SevenSegmentDisplay *display, char characterSequence[], int sequenceLength,
+		bool newEnableContinousCycle, bool newEnablePadding) {
+	int held = beginContentSwap(display);
+	loadCarouselSequence(display, characterSequence, sequenceLength, newEnableContinousCycle, newEnablePadding);
+	moveContentClock(display, SEVEN_SEGMENT_CONTENT_CAROUSEL);
+	SET_IRQ_HANDLER(getContentClock(display), sevenSegmentCarouselInterruptCtx, display);
+	queueScreen(display, display->carouselSequence);
+	finishContentSwap(display, held);
+}
+#endif
+
+#if SEVEN_SEGMENT_USE_SLIDER
+/*
+ * Function: setSliderTextCtx
+ * --------------------
+ * Replaces the content with a slider, keeping the clocks of the running mode
+ * The counter or transition clock moves on the slider at its current period
+ * If no mode is running the slider only shows its first page until a clock is started
+ *
+ * display: the display to act on
+ * characterSequence: As long of a sequence as desired of characters ("Hello World")
+ * sequenceLength: Length of Sequence
+ * newEnableContinousCycle: true implies the slider will cycle, false implies a one shot action
+ * newEnablePadding: Pad the sequence with a blank start and end screen
+ * ignoreSingleSpaces: True or False, sequences with single spaces will have the spaces ignored
+ *
+ * Return: no return
+ */
+void setSliderTextCtx(SevenSegmentDisplay *display, char characterSequence[], int sequenceLength,
+		bool newEnableContinousCycle, bool newEnablePadding, bool ignoreSingleSpaces) {
+	int held = beginContentSwap(display);
+	loadSliderSequence(display, characterSequence, sequenceLength, newEnableContinousCycle, newEnablePadding, ignoreSingleSpaces);
+	moveContentClock(display, SEVEN_SEGMENT_CONTENT_SLIDER);
+	SET_IRQ_HANDLER(getContentClock(display), sevenSegmentSliderInterruptCtx, display);
+	queueScreen(display, display->sliderSequence);
+	finishContentSwap(display, held);
+}
+#endif
+
+#if SEVEN_SEGMENT_USE_COUNTER
+/*
+ * Function: setCounterValueCtx
+ * --------------------
+ * Replaces the content with a counter, keeping the clocks of the running mode
+ * The counter or transition clock counts at its current period
+ * If no mode is running the counter only shows its start value until a clock is started
+ *
+ * display: the display to act on
+ * clockStart: Starting count for the display
+ * newCountDirection: "UP" or "DOWN"
+ * newCountIncrement: counter increment/decrement depending on direction (negatives are allowed)
+ * newStopValue: early stop point for counting
+ * enableStopValue: true or false
+ *
+ * Return: no return
+ */
+void setCounterValueCtx(SevenSegmentDisplay *display, int clockStart, char newCountDirection[], int newCountIncrement,
+		int newStopValue, bool enableStopValue) {
+	int held = beginContentSwap(display);
+	loadCounter(display, clockStart, newCountDirection, newCountIncrement, newStopValue, enableStopValue);
+	moveContentClock(display, SEVEN_SEGMENT_CONTENT_COUNTER);
+	SET_IRQ_HANDLER(getContentClock(display), updateSevenSegmentCounterInterruptCtx, display);
+	queueScreenNumber(display, clockStart);
+	finishContentSwap(display, held);
+}
+#endif
+
+/*
+ * Function: getSevenSegmentContentModeCtx
+ * --------------------
+ * Tells which mode the counter or transition clock is running
+ *
+ * display: the display to act on
+ *
+ * Return: SEVEN_SEGMENT_CONTENT_NONE, _COUNTER, _CAROUSEL, _SLIDER, _SEQUENCER or _SCRIPT
+ */
+int getSevenSegmentContentModeCtx(SevenSegmentDisplay *display) {
+	return display->contentMode;
+}
+
+/************************************************************************************************
+ * 																								*
+ *									Multiple Display Functions									*
+ * 			Each display has its own SevenSegmentDisplay and its own pins						*
+ * 																								*
+ ************************************************************************************************/
+
+/*
+ * Function: initSevenSegmentDisplay
+ * --------------------
+ * Puts a display back to its starting values
+ * Must be called on a display before its pins are set up unless it was
+ * declared with SEVEN_SEGMENT_DISPLAY_DEFAULTS
+ *
+ * display: the display to initialise
+ *
+ * Return: no return
+ */
+void initSevenSegmentDisplay(SevenSegmentDisplay *display) {
+	SevenSegmentDisplay defaults = SEVEN_SEGMENT_DISPLAY_DEFAULTS;
+	*display = defaults;
+}
+
+/*
+ * Function: setupSevenSegmentMultiRefresh
+ * --------------------
+ * Refreshes several displays from one clock, one display per interrupt in turn
+ * Each interrupt costs the same as refreshing a single display however many displays there are
+ * Must be called before the display/setup functions of the displays, which then leave the refresh
+ * clock alone and only start their own counter or transition clocks
+ * Calling displayMultipleInterrupt will refresh the displays
+ *
+ * displays: displays to refresh, their pins must not overlap
+ * displayCount: number of displays, at most MAX_SEVEN_SEGMENT_DISPLAYS
+ * refreshClock: from the list: "SysTick", "WKT", "MRT0", "MRT1", "CTIMER0"
+ * refreshRate: time between interrupts, each display is refreshed every displayCount interrupts
+ * NOTE: refreshClock cannot be used as a counter or transition clock by any of the displays
+ *
+ * Return: no return
+ */
+void setupSevenSegmentMultiRefresh(SevenSegmentDisplay *displays[], int displayCount, char refreshClock[], int refreshRate) {
+	int clock = getClockIndex(refreshClock);
+	// Claimed before any display is changed, a refused clock leaves the displays refreshing as they were
+	if (displayCount > 0 && displayCount <= MAX_SEVEN_SEGMENT_DISPLAYS
+			&& (clock < 0 || claimClock(displays[0], clock, SEVEN_SEGMENT_TIMER_REFRESH))) {
+		multiClock = clock;
+		multiRate = refreshRate;
+		for (int i = 0; i < displayCount; i++) {
+			multiDisplays[i] = displays[i];
+			displays[i]->sharedRefresh = true;
+			displays[i]->refresh.currentClock = multiClock;
+			displays[i]->refresh.cycleRate = refreshRate;
+			displays[i]->refresh.currentDigit = 0;
+		}
+		multiDisplayCount = displayCount;
+		multiDisplayIndex = 0;
+		// The displays stop refreshing themselves, their own refresh clocks are freed
+		for (int i = 0; i < displayCount; i++) {
+			releaseDisplayClocks(displays[i], 1 << SEVEN_SEGMENT_TIMER_REFRESH, -1);
+		}
+		startClock(displays[0], multiClock, SEVEN_SEGMENT_TIMER_REFRESH, multiRate);
+		SET_IRQ_HANDLER(multiClock, multipleRefreshIRQHandler, displays[0]);
+	}
+}
+
+/************************************************************************************************
+ * 																								*
+ *									Timer Interrupt Functions									*
+ * 			These functions should be called in the respective timer interrupt routine			*
+ *			Allows flexibility to still use other logic within the interrupt as desired			*
+ * 																								*
+ ************************************************************************************************/
+
+
+/*
+ * Function: refreshDigit
+ * --------------------
+ * Shows the next digit of the display, handling brightness and blinking at the end of each frame
+ * Does not re-arm any clock so it can be shared by the single and multiple display interrupts
+ * Function called internally
+ *
+ * display: the display to act on
+ *
+ *
+ * Return: no return
+ */
+void refreshDigit(SevenSegmentDisplay *display) {
+	int digitBit = 1 << display->refresh.currentDigit;
+	int segmentBits = 0;
+	if (!(display->refresh.blinkOff && (display->refresh.blinkDigitMask & digitBit))) {
+		segmentBits = getSegmentPattern(display->refresh.chrSequence[display->refresh.currentDigit]);
+	}
+	if (display->refresh.enableDP && (display->refresh.decimalPointMask & digitBit) && !(display->refresh.blinkOff && (display->refresh.blinkDPMask & digitBit))) {
+		segmentBits = segmentBits | SEGMENT_DP_BIT;
+	}
+	display->refresh.backend->writeDigit(display, display->refresh.currentDigit, segmentBits, display->refresh.frameLit);
+
+#ifdef SEVEN_SEGMENT_TRACE
+	recordRefreshTick(display->refresh.currentDigit == 3);
+#endif
+	HEALTH_REFRESH(display, display->refresh.currentDigit == 3);
+	display->refresh.currentDigit = display->refresh.currentDigit + 1;
+	if (display->refresh.currentDigit == 4) {
+		display->refresh.currentDigit = 0;
+		// Content swapped in while the frame was being refreshed starts with the next frame
+		if (display->refresh.screenPending) {
+			for (int i = 0; i < 4; i++) {
+				display->refresh.chrSequence[i] = display->pendingScreen[i];
+			}
+			display->refresh.screenPending = false;
+		}
+#ifdef SEVEN_SEGMENT_AUTO_DIM
+		// Ahead of the brightness so a new level is used from this frame on
+		sampleAutoDim(display);
+#endif
+		// Spread the lit frames evenly so dimming does not show up as a slow flicker
+		display->refresh.brightnessAccumulator = display->refresh.brightnessAccumulator + display->refresh.brightnessLevel;
+		if (display->refresh.brightnessAccumulator >= MAX_BRIGHTNESS) {
+			display->refresh.brightnessAccumulator = display->refresh.brightnessAccumulator - MAX_BRIGHTNESS;
+			display->refresh.frameLit = true;
+		} else {
+			display->refresh.frameLit = false;
+		}
+
+		// The blink phase is counted in frames so blinking needs no timer of its own
+		if (display->refresh.blinkPeriod > 0) {
+			display->refresh.blinkFrameCount = display->refresh.blinkFrameCount + 1;
+			if (display->refresh.blinkFrameCount >= display->refresh.blinkPeriod) {
+				display->refresh.blinkFrameCount = 0;
+				display->refresh.blinkOff = !display->refresh.blinkOff;
+			}
+		}
+	}
+}
+
+/*
+ * Function: display4CharactersInterruptCtx
+ * --------------------
+ * Used to swap between digits quickly on the display
+ * Should be called in the interrupt from the timer associated with the refreshRate
+ * Used when display4Characters is used
+ *
+ * display: the display to act on
+ *
+ *
+ * Return: no return
+ */
+void display4CharactersInterruptCtx(SevenSegmentDisplay *display) {
+	STATS_START(STATS_REFRESH);
+	refreshDigit(display);
+
+	// Handle Specific Details for Each Clock
+	// 0 == SysTick, 1 == WKT, 2 == MRT0, 3 = MRT1, 4 = CTIMER0
+	restartClock(display->refresh.currentClock, display->refresh.cycleRate);
+	STATS_END(STATS_REFRESH);
+}
+
+
+/*
+ * Function: display4NumbersInterruptCtx
+ * --------------------
+ * Used to swap between digits quickly on the display
+ * Should be called in the interrupt from the timer associated with the refreshRate
+ * Just a Wrapper Function For Clarity
+ * Called when digits are used, in reality display4CharactersInterrupt could be called instead
+ *
+ * Used when display4Numbers is used
+ *
+ * display: the display to act on
+ *
+ *
+ * Return: no return
+ */
+void display4NumbersInterruptCtx(SevenSegmentDisplay *display) {
+	display4CharactersInterruptCtx(display);
+}
+
+
+#if SEVEN_SEGMENT_USE_CAROUSEL
+/*
+ * Function: displayCarouselInterruptCtx
+ * --------------------
+ * Used to swap between digits quickly on the display
+ * Should be called in the interrupt from the timer associated with the refreshRate
+ * Just a Wrapper Function For Clarity
+ * Called when the carousel is used, in reality display4CharactersInterrupt could be called instead
+ *
+ * Used when sevenSegmentDisplayTextCarousel is used
+ *
+ * display: the display to act on
+ *
+ *
+ * Return: no return
+ */
+void displayCarouselInterruptCtx(SevenSegmentDisplay *display) {
+	display4CharactersInterruptCtx(display);
+}
+#endif
+
+
+#if SEVEN_SEGMENT_USE_SLIDER
+/*
+ * Function: displaySliderInterruptCtx
+ * --------------------
+ * Used to swap between digits quickly on the display
+ * Should be called in the interrupt from the timer associated with the refreshRate
+ * Just a Wrapper Function For Clarity
+ * Called when the slider is used, in reality display4CharactersInterrupt could be called instead
+ *
+ * Used when sevenSegmentDisplayTextSlider is used
+ *
+ * display: the display to act on
+ *
+ *
+ * Return: no return
+ */
+void displaySliderInterruptCtx(SevenSegmentDisplay *display) {
+	display4CharactersInterruptCtx(display);
+}
+#endif
+
+
+
+/*
+ * Function: displayMultipleInterrupt
+ * --------------------
+ * Refreshes the next display in turn, one digit per interrupt
+ * Should be called in the interrupt from the timer associated with the refreshRate
+ * Used when setupSevenSegmentMultiRefresh is used
+ *
+ *
+ * Return: no return
+ */
+void displayMultipleInterrupt() {
+	STATS_START(STATS_REFRESH);
+	if (multiDisplayCount > 0) {
+		refreshDigit(multiDisplays[multiDisplayIndex]);
+		multiDisplayIndex = multiDisplayIndex + 1;
+		if (multiDisplayIndex >= multiDisplayCount) {
+			multiDisplayIndex = 0;
+		}
+	}
+
+	restartClock(multiClock, multiRate);
+	STATS_END(STATS_REFRESH);
+}
+
+
+
+#if SEVEN_SEGMENT_USE_COUNTER
+/*
+ * Function: stepCounter
+ * --------------------
+ * Advances the counter by one increment and updates the displayed characters
+ * Function called internally by the counter and sequencer interrupts
+ *
+ * display: the display to act on
+ *
+ * Return: no return
+ */
+void stepCounter(SevenSegmentDisplay *display) {
+	if (display->pauseCounter == false) {
+		if (strcmp(display->countDirection, "UP") == 0) {
+			display->currentCount = display->currentCount + display->countIncrement;
+			display->normalizedCount = display->normalizedCount + display->countIncrement;
+		} else {
+			display->currentCount = display->currentCount - display->countIncrement;
+			display->normalizedCount = display->normalizedCount - display->countIncrement;
+		}
+
+		if (display->normalizedCount > 9999) {
+			display->normalizedCount = display->normalizedCount - 10000;
+		} else if(display->normalizedCount < 0) {
+			display->normalizedCount = 10000 + display->normalizedCount;
+		}
+
+		if(display->currentCount == display->countStopValue && display->enableCountStopValue == true) {
+			display->pauseCounter = true;
+		}
+
+		// Also drops a screen queued by setCounterValue, the stepped count supersedes it
+		setScreenNumber(display, display->normalizedCount);
+	}
+}
+#endif
+
+#if SEVEN_SEGMENT_USE_CAROUSEL
+/*
+ * Function: stepCarousel
+ * --------------------
+ * Moves the carousel by one character and updates the displayed characters
+ * Function called internally by the carousel and sequencer interrupts
+ *
+ * display: the display to act on
+ *
+ * Return: no return
+ */
+void stepCarousel(SevenSegmentDisplay *display) {
+	if (!display->carouselOverflow && !display->pauseCarouselTransition){
+		display->transitionIndex = display->transitionIndex + 1;
+	}
+
+	// The stepped screen supersedes one queued by setCarouselText, which the end of the frame would put back
+	display->refresh.screenPending = false;
+	int wrapAround = 0;
+	for (int i = 0; i < 4; i++) {
+		if (i + display->transitionIndex > display->carouselSequenceLength) {
+			display->refresh.chrSequence[3-i] = display->carouselSequence[wrapAround];
+			wrapAround = wrapAround + 1;
+		} else {
+			display->refresh.chrSequence[3-i] = display->carouselSequence[i + display->transitionIndex];
+		}
+
+	}
+
+	if (display->transitionIndex == display->carouselSequenceLength && display->enableContinousCycle) {
+		display->transitionIndex = -1;
+	} else if (display->transitionIndex == (display->carouselSequenceLength-4) && !display->enableContinousCycle) {
+		display->carouselOverflow = true;
+	}
+}
+#endif
+
+#if SEVEN_SEGMENT_USE_SLIDER
+/*
+ * Function: stepSlider
+ * --------------------
+ * Displays the next set of 4 characters of the slider
+ * Function called internally by the slider and sequencer interrupts
+ *
+ * display: the display to act on
+ *
+ * Return: no return
+ */
+void stepSlider(SevenSegmentDisplay *display) {
+	// The stepped screen supersedes one queued by setSliderText, which the end of the frame would put back
+	display->refresh.screenPending = false;
+	for (int i = 0; i < 4; i++) {
+		display->refresh.chrSequence[3-i] = display->sliderSequence[i + display->sliderTransitionIndex];
+	}
+
+	if (!display->pauseSliderTransition){
+		display->sliderTransitionIndex = display->sliderTransitionIndex + 4;
+		display->sliderPagesShown = display->sliderPagesShown + 1;
+	}
+	if (display->sliderTransitionIndex > (display->sliderSequenceLength - 4) && display->enableContinousCycle) {
+		display->sliderTransitionIndex = 0;
+	} else if (display->sliderTransitionIndex > (display->sliderSequenceLength - 4)) {
+		display->sliderTransitionIndex = display->sliderTransitionIndex - 4;
+		display->pauseSliderTransition = true;
+	}
+}
+#endif
+
+
+#if SEVEN_SEGMENT_USE_COUNTER
+/*
+ * Function: updateSevenSegmentCounterInterruptCtx
+ * --------------------
+ * Interrupt for the counter mechanism if the seven segment display is used as a counter
+ * Updates the count for the 7-segment
+ * This function should be called within the interrupt that handles clock incrementing/decrementing
+ *
+ * Used when setupSevenSegmentCounter is used, where the clock associated with counting was passing in to counterClock
+ *
+ * display: the display to act on
+ *
+ *
+ * Return: no return
+ */
+void updateSevenSegmentCounterInterruptCtx(SevenSegmentDisplay *display) {
+	STATS_START(STATS_COUNTER);
+	HEALTH_TRANSITION(display, display->countClock, display->countRate);
+	ADAPTIVE_REFRESH_START(display);
+	stepCounter(display);
+	ADAPTIVE_REFRESH_END(display);
+	restartClock(display->countClock, display->countRate);
+	STATS_END(STATS_COUNTER);
+}
+#endif
+
+
+#if SEVEN_SEGMENT_USE_CAROUSEL
+/*
+ * Function: getCarouselFrameCount
+ * --------------------
+ * Number of screens the carousel shows in one pass, for the dwell times and easing
+ * Function called internally
+ *
+ * display: the display to act on
+ *
+ * Return: number of frames
+ */
+int getCarouselFrameCount(SevenSegmentDisplay *display) {
+	if (display->enableContinousCycle) {
+		return display->carouselSequenceLength + 1;
+	}
+	return display->carouselSequenceLength - 3;
+}
+
+/*
+ * Function: sevenSegmentCarouselInterruptCtx
+ * --------------------
+ * Interrupt for the carousel mechanism if the seven segment display is used as a carousel
+ * Updates the currently displayed characters
+ * This function should be called within the interrupt that handles carousel transitions
+ *
+ * Used when sevenSegmentDisplayTextCarousel is used, where the clock associated with transitions
+ * was passing into newTransitionClock
+ *
+ * display: the display to act on
+ *
+ *
+ * Return: no return
+ */
+void sevenSegmentCarouselInterruptCtx(SevenSegmentDisplay *display) {
+	STATS_START(STATS_CAROUSEL);
+	int frameCount = getCarouselFrameCount(display);
+	HEALTH_TRANSITION(display, display->transitionClock, getTransitionDwell(display, display->transitionIndex, frameCount));
+	ADAPTIVE_REFRESH_START(display);
+	stepCarousel(display);
+	ADAPTIVE_REFRESH_END(display);
+
+	// A continuous carousel resets to -1 right after showing its last frame
+	int frame = display->transitionIndex;
+	if (frame == -1) {
+		frame = display->carouselSequenceLength;
+	}
+	restartTransitionClock(display, frame, frameCount);
+	STATS_END(STATS_CAROUSEL);
+}
+#endif
+
+
+
+#if SEVEN_SEGMENT_USE_SLIDER
+/*
+ * Function: sevenSegmentSliderInterruptCtx
+ * --------------------
+ * Interrupt for the slider mechanism if the seven segment display is used as a slider
+ * to swap between sets of 4 characters
+ * Updates the currently displayed characters
+ * This function should be called within the interrupt that handles slider transitions
+ *
+ * Used when sevenSegmentDisplayTextSlider is used, where the clock associated with transitions
+ * was passing into newTransitionClock
+ *
+ * display: the display to act on
+ *
+ *
+ * Return: no return
+ */
+void sevenSegmentSliderInterruptCtx(SevenSegmentDisplay *display) {
+	STATS_START(STATS_SLIDER);
+	int frame = display->sliderTransitionIndex / 4;
+	HEALTH_TRANSITION(display, display->transitionClock, getTransitionDwell(display, frame, display->sliderSequenceLength / 4));
+	ADAPTIVE_REFRESH_START(display);
+	stepSlider(display);
+	ADAPTIVE_REFRESH_END(display);
+	restartTransitionClock(display, frame, display->sliderSequenceLength / 4);
+	STATS_END(STATS_SLIDER);
+}
+#endif
+
+
+#if SEVEN_SEGMENT_USE_SEQUENCER
+/*
+ * Function: sevenSegmentSequencerInterruptCtx
+ * --------------------
+ * Interrupt for the sequencer if the seven segment display runs a playlist of jobs
+ * Steps the current job, then moves on to the next job once its completion condition is met
+ * Switching jobs only reloads the content, the refresh and transition clocks keep running
+ * This function should be called within the interrupt that handles transitions
+ *
+ * Used when setupSevenSegmentSequencer is used, where the clock associated with transitions
+ * was passing into newTransitionClock
+ *
+ * display: the display to act on
+ *
+ *
+ * Return: no return
+ */
+void sevenSegmentSequencerInterruptCtx(SevenSegmentDisplay *display) {
+	STATS_START(STATS_SEQUENCER);
+	HEALTH_TRANSITION(display, display->transitionClock, display->transitionRate);
+	ADAPTIVE_REFRESH_START(display);
+	if (!display->pauseSequencer && !display->sequencerFinished) {
+		SevenSegmentJob *job = &display->sequencerJobs[display->sequencerJobIndex];
+		// Checked before stepping so the last screen of a job is shown for a full transition
+		if (sequencerJobDone(display, job)) {
+			if (display->sequencerJobIndex + 1 < display->sequencerJobCount) {
+				loadSequencerJob(display, display->sequencerJobIndex + 1);
+			} else if (display->sequencerLoop) {
+				loadSequencerJob(display, 0);
+			} else {
+				// Leave the last screen of the final job on the display
+				display->sequencerFinished = true;
+			}
+		} else {
+			if (job->jobType == SEQUENCER_JOB_STATIC) {
+				// Held on the display until the job is done
+#if SEVEN_SEGMENT_USE_CAROUSEL
+			} else if (job->jobType == SEQUENCER_JOB_CAROUSEL) {
+				stepCarousel(display);
+#endif
+#if SEVEN_SEGMENT_USE_SLIDER
+			} else if (job->jobType == SEQUENCER_JOB_SLIDER) {
+				stepSlider(display);
+#endif
+#if SEVEN_SEGMENT_USE_COUNTER
+			} else if (job->jobType == SEQUENCER_JOB_COUNTER) {
+				stepCounter(display);
+#endif
+			}
+			display->sequencerJobTicks = display->sequencerJobTicks + 1;
+		}
+	}
+	ADAPTIVE_REFRESH_END(display);
+
+	restartClock(display->transitionClock, display->transitionRate);
+	STATS_END(STATS_SEQUENCER);
+}
+#endif
+
+/*
+ * Function: sevenSegmentContentInterruptCtx
+ * --------------------
+ * Calls the interrupt function of the mode the counter or transition clock is running
+ * Can be called instead of the mode's own interrupt function, so content swapped in by
+ * setCarouselText, setSliderText or setCounterValue is stepped whatever its mode
+ *
+ * display: the display to act on
+ *
+ *
+ * Return: no return
+ */
+void sevenSegmentContentInterruptCtx(SevenSegmentDisplay *display) {
+	if (display->contentMode == SEVEN_SEGMENT_CONTENT_NONE) {
+		return;
+#if SEVEN_SEGMENT_USE_SCRIPT
+	} else if (display->contentMode == SEVEN_SEGMENT_CONTENT_SCRIPT) {
+		sevenSegmentScriptInterruptCtx(display);
+#endif
+#if SEVEN_SEGMENT_USE_COUNTER
+	} else if (display->contentMode == SEVEN_SEGMENT_CONTENT_COUNTER) {
+		updateSevenSegmentCounterInterruptCtx(display);
+#endif
+#if SEVEN_SEGMENT_USE_CAROUSEL
+	} else if (display->contentMode == SEVEN_SEGMENT_CONTENT_CAROUSEL) {
+		sevenSegmentCarouselInterruptCtx(display);
+#endif
+#if SEVEN_SEGMENT_USE_SLIDER
+	} else if (display->contentMode == SEVEN_SEGMENT_CONTENT_SLIDER) {
+		sevenSegmentSliderInterruptCtx(display);
+#endif
+#if SEVEN_SEGMENT_USE_SEQUENCER
+	} else if (display->contentMode == SEVEN_SEGMENT_CONTENT_SEQUENCER) {
+		sevenSegmentSequencerInterruptCtx(display);
+#endif
+	}
+}
+
+
+
+/************************************************************************************************
+ * 																								*
+ *							Seven Segment Counter Helper Functions								*
+ * 		These functions can be used to make changes to the counter in real time if in use		*
+ * 																								*
+ ************************************************************************************************/
+
+
+#if SEVEN_SEGMENT_USE_COUNTER
+/*
+ * Function: getSevenSegmentDisplayCountCtx
+ * --------------------
+ * Getter for the current normalized (displayed) count
+ * Normalized implies the currently displayed count value (between 0000 and 9999)
+ * The actual count value may be larger as the counter wraps around when it hits the edge values
+ * To get the actual count value use getSevenSegmentTotalCount instead
+ *
+ * display: the display to act on
+ *
+ * Return: normalizedCount
+ */
+int getSevenSegmentDisplayCountCtx(SevenSegmentDisplay *display) {
+	return display->normalizedCount;
+}
+
+/*
+ * Function: getSevenSegmentTotalCountCtx
+ * --------------------
+ *  Getter for the actual count
+ *  If overflow within the counter has happened and the counter wraps around
+ *  the display value may differ from the actual count
+ * To get the normalized (currently displayed) count value use getSevenSegmentDisplayCount instead
+ *
+ * display: the display to act on
+ *
+ * Return: currentCount
+ */
+int getSevenSegmentTotalCountCtx(SevenSegmentDisplay *display) {
+	return display->currentCount;
+}
+
+/*
+ * Function: toggleSevenSegmentCounterPauseCtx
+ * --------------------
+ *  Toggle for the counter to pause or run
+ *
+ * display: the display to act on
+ *
+ *
+ * Return: no return
+ */
+void toggleSevenSegmentCounterPauseCtx(SevenSegmentDisplay *display) {
+	display->pauseCounter = !display->pauseCounter;
+}
+
+/*
+ * Function: pauseSevenSegmentCounterCtx
+ * --------------------
+ *  Pause the counter
+ *
+ * display: the display to act on
+ *
+ *
+ * Return: no return
+ */
+void pauseSevenSegmentCounterCtx(SevenSegmentDisplay *display) {
+	display->pauseCounter = true;
+}
+
+/*
+ * Function: runSevenSegmentCounterCtx
+ * --------------------
+ * Continue running the counter
+ *
+ * display: the display to act on
+ *
+ *
+ * Return: no return
+ */
+void runSevenSegmentCounterCtx(SevenSegmentDisplay *display) {
+	display->pauseCounter = false;
+}
+
+/*
+ * Function: resetSevenSegmentCountCtx
+ * --------------------
+ * Resets the counter to the original value
+ * Will also restart the counting sequence
+ *
+ * display: the display to act on
+ *
+ *
+ * Return: no return
+ */
+void resetSevenSegmentCountCtx(SevenSegmentDisplay *display) {
+	display->currentCount = display->startCount;
+	display->normalizedCount = display->startCount;
+	display->pauseCounter = false;
+}
+
+/*
+ * Function: setSevenSegmentCountCtx
+ * --------------------
+ * Change the count value to a new number
+ * Will update the displayed and normalized value
+ * Will also restart the counter, doing this may cause a need to update the users stopValue
+ *
+ * display: the display to act on
+ * newCount: new count value to be displayed and stored
+ *
+ * Return: no return
+ */
+void setSevenSegmentCountCtx(SevenSegmentDisplay *display, int newCount) {
+	display->startCount = newCount;
+	display->currentCount = newCount;
+	display->normalizedCount = newCount;
+	display->pauseCounter = false;
+}
+
+/*
+ * Function: updateSevenSegmentIncrementerCtx
+ * --------------------
+ * Change the count increment/decrement value to a new number
+ *
+ * display: the display to act on
+ * newIncrement: an integer value for changing the increment or decrement amount
+ *
+ * Return: no return
+ */
+void updateSevenSegmentIncrementerCtx(SevenSegmentDisplay *display, int newIncrement) {
+	display->countIncrement = newIncrement;
+}
+
+/*
+ * Function: changeSevenSegmentCountDirectionCtx
+ * --------------------
+ * Change the count direction to either "UP" or "DOWN"
+ * If an incorrect string is entered, no change will be applied
+ *
+ * display: the display to act on
+ * newDirection: either "UP' or "DOWN" as required
+ *
+ *
+ * Return: no return
+ */
+void changeSevenSegmentCountDirectionCtx(SevenSegmentDisplay *display, char newDirection[]) {
+	if (strcmp(newDirection, "UP") == 0) {
+		strncpy(display->countDirection, "UP", sizeof display->countDirection);
+	} else if (strcmp(newDirection, "DOWN") == 0) {
+		strncpy(display->countDirection, "DOWN", sizeof display->countDirection);
+	}
+}
+
+
+/*
+ * Function: setCountStopValueCtx
+ * --------------------
+ * Change the stop value for the counter
+ * Will also enable the stop condition automatically
+ * Will also continue the counter if previously paused, but will pause the counter
+ * if the new stop value equals the current count
+ *
+ * display: the display to act on
+ * newStopValue: the new integer value for the counter to stop at
+ *
+ *
+ * Return: no return
+ */
+void setCountStopValueCtx(SevenSegmentDisplay *display, int newStopValue) {
+	display->enableCountStopValue = true;
+	display->countStopValue = newStopValue;
+	if (display->currentCount != display->countStopValue) {
+		display->pauseCounter = false;
+	} else {
+		display->pauseCounter = true;
+	}
+}
+
+/*
+ * Function: clearCountStopValueCtx
+ * --------------------
+ * Change the stop value for the counter
+ * Will also enable the stop condition automatically
+ * Will also continue the counter if previously paused, but will pause the counter
+ * if the new stop value equals the current count
+ *
+ * display: the display to act on
+ * newStopValue: the new integer value for the counter to stop at
+ *
+ *
+ * Return: no return
+ */
+void clearCountStopValueCtx(SevenSegmentDisplay *display){
+	display->enableCountStopValue = false;
+	display->countStopValue = 0;
+	display->pauseCounter = false;
+}
+#endif
+
+
+/************************************************************************************************
+ * 																								*
+ *							Seven Segment Carousel Helper Functions								*
+ * 		These functions can be used to make changes to the carousel in real time if in use		*
+ * 																								*
+ ************************************************************************************************/
+
+
+#if SEVEN_SEGMENT_USE_CAROUSEL
+/*
+ * Function: togglePauseSevenSegmentDisplayCarouselCtx
+ * --------------------
+ *  Toggle the pause on the carousel motion
+ *
+ * display: the display to act on
+ *
+ *
+ * Return: no return
+ */
+void togglePauseSevenSegmentDisplayCarouselCtx(SevenSegmentDisplay *display) {
+	display->pauseCarouselTransition = !display->pauseCarouselTransition;
+}
+
+/*
+ * Function: pauseSevenSegmentDisplayCarouselCtx
+ * --------------------
+ *  Pause the carousel motion
+ *
+ * display: the display to act on
+ *
+ *
+ * Return: no return
+ */
+void pauseSevenSegmentDisplayCarouselCtx(SevenSegmentDisplay *display) {
+	display->pauseCarouselTransition = true;
+}
+
+/*
+ * Function: runSevenSegmentDisplayCarouselCtx
+ * --------------------
+ *  Continue the carousel motion if paused
+ *
+ * display: the display to act on
+ *
+ *
+ * Return: no return
+ */
+void runSevenSegmentDisplayCarouselCtx(SevenSegmentDisplay *display) {
+	display->pauseCarouselTransition = false;
+}
+
+/*
+ * Function: restartSevenSegmentDisplayCarouselCtx
+ * --------------------
+ *  Start carousel from beginning sequence again
+ *  Removes the pause on the carousel if any
+ *
+ * display: the display to act on
+ *
+ *
+ * Return: no return
+ */
+void restartSevenSegmentDisplayCarouselCtx(SevenSegmentDisplay *display) {
+	display->transitionIndex = -1;
+	display->carouselOverflow = false;
+	display->pauseCarouselTransition = false;
+}
+#endif
+
+
+
+/************************************************************************************************
+ * 																								*
+ *							Seven Segment Slider Helper Functions								*
+ * 		These functions can be used to make changes to the slider in real time if in use		*
+ * 																								*
+ ************************************************************************************************/
+
+#if SEVEN_SEGMENT_USE_SLIDER
+/*
+ * Function: pauseSevenSegmentDisplaySliderCtx
+ * --------------------
+ * Pause slider animation for the display
+ *
+ * display: the display to act on
+ *
+ *
+ * Return: no return
+ */
+void pauseSevenSegmentDisplaySliderCtx(SevenSegmentDisplay *display) {
+	display->pauseSliderTransition = true;
+}
+
+
+/*
+ * Function: togglePauseSevenSegmentDisplaySliderCtx
+ * --------------------
+ * Toggle whether the slider animation is running or not for the display
+ *
+ * display: the display to act on
+ *
+ *
+ * Return: no return
+ */
+void togglePauseSevenSegmentDisplaySliderCtx(SevenSegmentDisplay *display) {
+	display->pauseSliderTransition = !display->pauseSliderTransition;
+}
+
+/*
+ * Function: runSevenSegmentDisplaySliderCtx
+ * --------------------
+ * Run slider animation for the display
+ *
+ * display: the display to act on
+ *
+ *
+ * Return: no return
+ */
+void runSevenSegmentDisplaySliderCtx(SevenSegmentDisplay *display) {
+	display->pauseSliderTransition = false;
+}
+
+
+/*
+ * Function: restartSevenSegmentDisplaySliderCtx
+ * --------------------
+ * Restart slider animation for the display
+ * Will also run the display if previously paused
+ *
+ * display: the display to act on
+ *
+ *
+ * Return: no return
+ */
+void restartSevenSegmentDisplaySliderCtx(SevenSegmentDisplay *display) {
+	display->sliderTransitionIndex = 0;
+	display->pauseSliderTransition = false;
+}
+#endif
+
+
+
+/************************************************************************************************
+ * 																								*
+ *							Seven Segment Transition Helper Functions							*
+ * 		These functions can be used to change the carousel and slider timing in real time		*
+ * 																								*
+ ************************************************************************************************/
+
+#if SEVEN_SEGMENT_USE_CAROUSEL || SEVEN_SEGMENT_USE_SLIDER
+/*
+ * Function: setSevenSegmentTransitionDwellCtx
+ * --------------------
+ * Change the per-screen periods and easing of a running carousel or slider
+ * Called before the carousel or slider is set up, the first screen gets its period from the start
+ * Passing NULL, 0 and TRANSITION_EASE_NONE goes back to a fixed transitionSpeed
+ *
+ * display: the display to act on
+ * dwellTimes: period of each screen in the same units as transitionSpeed, NULL to use transitionSpeed
+ * dwellCount: number of entries in dwellTimes, later screens use transitionSpeed
+ * easing: TRANSITION_EASE_NONE, TRANSITION_EASE_IN, TRANSITION_EASE_OUT or TRANSITION_EASE_IN_OUT
+ *
+ * Return: no return
+ */
+void setSevenSegmentTransitionDwellCtx(SevenSegmentDisplay *display, int dwellTimes[], int dwellCount, int easing) {
+	if (dwellTimes == NULL) {
+		dwellCount = 0;
+	}
+	display->transitionDwellTimes = dwellTimes;
+	display->transitionDwellCount = dwellCount;
+	display->transitionEasing = easing;
+	if (dwellCount == 0 && easing == TRANSITION_EASE_NONE) {
+		// Put back the fixed period in case a stretched one is still loaded
+		setClockPeriod(display->transitionClock, display->transitionRate);
+	}
+}
+#endif
+
+
+
+/************************************************************************************************
+ * 																								*
+ *							Seven Segment Sequencer Helper Functions							*
+ * 		These functions can be used to make changes to the sequencer in real time if in use		*
+ * 																								*
+ ************************************************************************************************/
+
+#if SEVEN_SEGMENT_USE_SEQUENCER
+/*
+ * Function: pauseSevenSegmentSequencerCtx
+ * --------------------
+ * Pause the sequencer, the current screen stays on the display
+ *
+ * display: the display to act on
+ *
+ *
+ * Return: no return
+ */
+void pauseSevenSegmentSequencerCtx(SevenSegmentDisplay *display) {
+	display->pauseSequencer = true;
+}
+
+/*
+ * Function: runSevenSegmentSequencerCtx
+ * --------------------
+ * Continue the sequencer if paused
+ *
+ * display: the display to act on
+ *
+ *
+ * Return: no return
+ */
+void runSevenSegmentSequencerCtx(SevenSegmentDisplay *display) {
+	display->pauseSequencer = false;
+}
+
+/*
+ * Function: restartSevenSegmentSequencerCtx
+ * --------------------
+ * Start the playlist from the first job again
+ * Removes the pause on the sequencer if any
+ *
+ * display: the display to act on
+ *
+ *
+ * Return: no return
+ */
+void restartSevenSegmentSequencerCtx(SevenSegmentDisplay *display) {
+	if (display->sequencerJobCount > 0) {
+		display->sequencerFinished = false;
+		display->pauseSequencer = false;
+		loadSequencerJob(display, 0);
+	}
+}
+
+/*
+ * Function: getSevenSegmentSequencerJobCtx
+ * --------------------
+ * Getter for the position of the job currently displayed in the playlist
+ *
+ * display: the display to act on
+ *
+ *
+ * Return: sequencerJobIndex
+ */
+int getSevenSegmentSequencerJobCtx(SevenSegmentDisplay *display) {
+	return display->sequencerJobIndex;
+}
+
+/*
+ * Function: isSevenSegmentSequencerFinishedCtx
+ * --------------------
+ * Check if a playlist without looping has completed its last job
+ *
+ * display: the display to act on
+ *
+ *
+ * Return: true if finished
+ */
+bool isSevenSegmentSequencerFinishedCtx(SevenSegmentDisplay *display) {
+	return display->sequencerFinished;
+}
+#endif
+
+
+/************************************************************************************************
+ * 																								*
+ *							Seven Segment Timing Functions										*
+ * 		Set the clocks of a running display in Hz or milliseconds instead of reload values		*
+ * 																								*
+ ************************************************************************************************/
+
+/*
+ * Function: getClockInputHz
+ * --------------------
+ * Frequency a clock counts at
+ * SysTick runs from the processor clock, the MRT and CTIMER0 (prescaler 0) from the system clock,
+ * which are both SystemCoreClock on the LPC802, the WKT counts the low power oscillator
+ * The WKT is taken at its nominal frequency, the calibration is applied as its count is written
+ * Function called internally
+ *
+ * clock: internal clock index (0..4)
+ *
+ * Return: counts per second
+ */
+int getClockInputHz(int clock) {
+	if (clock == 1) {
+		return WKT_CLOCK_HZ;
+	}
+	return SystemCoreClock;
+}
+
+/*
+ * Function: getClockMaxReload
+ * --------------------
+ * Largest reload value a clock takes
+ * SysTick reloads with LOAD + 1 and the MRT interval is 24 bits, the WKT count and CTIMER0
+ * match are 32 bits but the rates are kept in an int
+ * Function called internally
+ *
+ * clock: internal clock index (0..4)
+ *
+ * Return: largest reload value
+ */
+uint32_t getClockMaxReload(int clock) {
+	if (clock == 0) {
+		return SysTick_LOAD_RELOAD_Msk + 1;
+	} else if (clock == 2 || clock == 3) {
+		return MRT_CHANNEL_INTVAL_IVALUE_MASK;
+	}
+	return INT32_MAX;
+}
+
+/*
+ * Function: periodToReload
+ * --------------------
+ * Converts a period into the reload value of a clock, rounded to the nearest count
+ * Function called internally
+ *
+ * clock: internal clock index (0..4)
+ * periodUs: period in microseconds
+ *
+ * Return: reload value, -1 if the clock is not valid or the period is too short or too long for it
+ */
+int periodToReload(int clock, uint32_t periodUs) {
+	if (clock < 0 || clock > 4 || periodUs == 0) {
+		return -1;
+	}
+	uint64_t reload = ((uint64_t)getClockInputHz(clock) * periodUs + 500000) / 1000000;
+	// A reload of 1 would interrupt on every count
+	if (reload < 2 || reload > getClockMaxReload(clock)) {
+		return -1;
+	}
+	return (int)reload;
+}
+
+/*
+ * Function: applyClockReload
+ * --------------------
+ * Gives a running clock a new reload and records it in the rate of the role the clock is owned in,
+ * so restartClock re-arms the WKT and CTIMER0 with it
+ * Function called internally
+ *
+ * display: the display owning the clock
+ * clock: internal clock index (0..4)
+ * reload: new reload value
+ *
+ * Return: no return
+ */
+void applyClockReload(SevenSegmentDisplay *display, int clock, int reload) {
+	int role = sevenSegmentTimers[clock].role;
+	if (role == SEVEN_SEGMENT_TIMER_REFRESH) {
+		display->refresh.cycleRate = reload;
+	} else if (role == SEVEN_SEGMENT_TIMER_COUNTER) {
+		display->countRate = reload;
+	} else {
+		display->transitionRate = reload;
+	}
+	setClockPeriod(clock, reload);
+}
+
+/*
+ * Function: getSevenSegmentReloadForHz
+ * --------------------
+ * Works out the reload value to pass as a refreshRate, countRate or transitionSpeed for an
+ * interrupt frequency, from the clock the timer is counting right now
+ * SysTick and the MRT take up to 24 bit reloads, the WKT and CTIMER0 up to 31 bits
+ *
+ * clock: from the list "SysTick", "WKT", "MRT0", "MRT1", "CTIMER0"
+ * hz: interrupts per second
+ *
+ * Return: reload value, -1 if the timer cannot run at that frequency
+ */
+int getSevenSegmentReloadForHz(char clock[], int hz) {
+	if (hz <= 0) {
+		return -1;
+	}
+	return periodToReload(getClockIndex(clock), (1000000 + hz / 2) / hz);
+}
+
+/*
+ * Function: getSevenSegmentReloadForMs
+ * --------------------
+ * Same as getSevenSegmentReloadForHz for a period in milliseconds
+ *
+ * clock: from the list "SysTick", "WKT", "MRT0", "MRT1", "CTIMER0"
+ * ms: time between interrupts
+ *
+ * Return: reload value, -1 if the timer cannot count that period
+ */
+int getSevenSegmentReloadForMs(char clock[], int ms) {
+	if (ms <= 0 || ms > (int)(UINT32_MAX / 1000)) {
+		return -1;
+	}
+	return periodToReload(getClockIndex(clock), (uint32_t)ms * 1000);
+}
+
+/*
+ * Function: setSevenSegmentRefreshHzCtx
+ * --------------------
+ * Changes the rate of the running refresh clock, one digit is refreshed per interrupt
+ * Must be called after the display or setup function has started the refresh clock
+ * Not available to displays refreshed by setupSevenSegmentMultiRefresh or the SPI chain
+ * Turns off adaptive refresh, see setSevenSegmentAdaptiveRefresh
+ *
+ * display: the display to act on
+ * hz: refresh interrupts per second, a frame of 4 digits takes 4 interrupts
+ *
+ * Return: true if the rate was changed, false if the clock cannot run at hz or is not owned
+ */
+bool setSevenSegmentRefreshHzCtx(SevenSegmentDisplay *display, int hz) {
+	int clock = display->refresh.currentClock;
+	if (hz <= 0 || display->sharedRefresh || clock < 0 || sevenSegmentTimers[clock].display != display) {
+		return false;
+	}
+	uint32_t periodUs = (1000000 + hz / 2) / hz;
+	int reload = periodToReload(clock, periodUs);
+	if (reload < 0) {
+		return false;
+	}
+	display->refreshPeriodUs = periodUs;
+#if SEVEN_SEGMENT_USE_ADAPTIVE_REFRESH
+	display->adaptiveStaticRate = 0;
+#endif
+	applyClockReload(display, clock, reload);
+	return true;
+}
+
+/*
+ * Function: setContentPeriod
+ * --------------------
+ * Changes the period of the running counter or transition clock
+ * Function called internally by setSevenSegmentTransitionHz and setSevenSegmentTransitionMs
+ *
+ * display: the display to act on
+ * periodUs: period in microseconds
+ *
+ * Return: true if the period was changed, false if the clock cannot count it or no mode is running
+ */
+bool setContentPeriod(SevenSegmentDisplay *display, uint32_t periodUs) {
+	int clock = getContentClock(display);
+	int reload = periodToReload(clock, periodUs);
+	if (reload < 0) {
+		return false;
+	}
+	if (sevenSegmentTimers[clock].role == SEVEN_SEGMENT_TIMER_COUNTER) {
+		display->countPeriodUs = periodUs;
+	} else {
+		display->transitionPeriodUs = periodUs;
+	}
+	applyClockReload(display, clock, reload);
+	return true;
+}
+
+/*
+ * Function: setSevenSegmentTransitionHzCtx
+ * --------------------
+ * Changes the rate of the running counter or transition clock
+ * Must be called after the setup function has started the clock
+ * Dwell times set with setSevenSegmentTransitionDwell stay raw reload values
+ *
+ * display: the display to act on
+ * hz: counter or transition steps per second
+ *
+ * Return: true if the rate was changed, false if the clock cannot run at hz or no mode is running
+ */
+bool setSevenSegmentTransitionHzCtx(SevenSegmentDisplay *display, int hz) {
+	if (hz <= 0) {
+		return false;
+	}
+	return setContentPeriod(display, (1000000 + hz / 2) / hz);
+}
+
+/*
+ * Function: setSevenSegmentTransitionMsCtx
+ * --------------------
+ * Same as setSevenSegmentTransitionHz for a period in milliseconds
+ *
+ * display: the display to act on
+ * ms: time between counter or transition steps
+ *
+ * Return: true if the period was changed, false if the clock cannot count ms or no mode is running
+ */
+bool setSevenSegmentTransitionMsCtx(SevenSegmentDisplay *display, int ms) {
+	if (ms <= 0 || ms > (int)(UINT32_MAX / 1000)) {
+		return false;
+	}
+	return setContentPeriod(display, (uint32_t)ms * 1000);
+}
+
+/*
+ * Function: updateSevenSegmentTiming
+ * --------------------
+ * Recomputes the reloads of every clock set with the timing functions, for every display
+ * Call after changing the system clock (and SystemCoreClock) so the displays keep their rates
+ * Clocks given raw reload values are left alone, as are clocks that cannot count their period
+ * at the new clock speed
+ *
+ *
+ * Return: no return
+ */
+void updateSevenSegmentTiming() {
+	for (int clock = 0; clock < 5; clock++) {
+		SevenSegmentDisplay *display = sevenSegmentTimers[clock].display;
+		if (display == NULL) {
+			continue;
+		}
+		uint32_t periodUs = display->transitionPeriodUs;
+		if (sevenSegmentTimers[clock].role == SEVEN_SEGMENT_TIMER_REFRESH) {
+#if SEVEN_SEGMENT_USE_ADAPTIVE_REFRESH
+			if (display->adaptiveStaticRate != 0) {
+				if (loadAdaptiveRates(display, clock)) {
+					int rate = display->adaptiveActive ? display->adaptiveActiveRate : display->adaptiveStaticRate;
+					applyClockReload(display, clock, rate);
+				}
+				continue;
+			}
+#endif
+			periodUs = display->refreshPeriodUs;
+		} else if (sevenSegmentTimers[clock].role == SEVEN_SEGMENT_TIMER_COUNTER) {
+			periodUs = display->countPeriodUs;
+		}
+		int reload = periodToReload(clock, periodUs);
+		if (reload >= 0) {
+			applyClockReload(display, clock, reload);
+		}
+	}
+}
+
+#if SEVEN_SEGMENT_USE_ADAPTIVE_REFRESH
+/*
+ * Function: getScreenWord
+ * --------------------
+ * Packs the 4 characters on the screen into one word, so a step can be checked with one compare
+ * Function called internally by ADAPTIVE_REFRESH_START
+ *
+ * display: the display to act on
+ *
+ * Return: chrSequence as a word
+ */
+uint32_t getScreenWord(SevenSegmentDisplay *display) {
+	uint32_t word;
+	memcpy(&word, display->refresh.chrSequence, sizeof(word));
+	return word;
+}
+
+/*
+ * Function: adaptRefreshRate
+ * --------------------
+ * Moves the refresh clock to the active rate if the step changed the screen or queued a new one,
+ * and back to the static rate if it did not
+ * The reload is only written when the state flips, the running interval is not cut short
+ * Function called internally by ADAPTIVE_REFRESH_END
+ *
+ * display: the display to act on
+ * shownBefore: getScreenWord before the step
+ *
+ * Return: no return
+ */
+void adaptRefreshRate(SevenSegmentDisplay *display, uint32_t shownBefore) {
+	if (display->adaptiveStaticRate == 0) {
+		return;
+	}
+	bool active = display->refresh.screenPending || getScreenWord(display) != shownBefore;
+	if (active == display->adaptiveActive) {
+		return;
+	}
+	display->adaptiveActive = active;
+	int rate = active ? display->adaptiveActiveRate : display->adaptiveStaticRate;
+	display->refresh.cycleRate = rate;
+	setClockPeriod(display->refresh.currentClock, rate);
+}
+
+/*
+ * Function: loadAdaptiveRates
+ * --------------------
+ * Works out the static and active reloads from their periods for the clock refreshing the display
+ * Function called internally
+ *
+ * display: the display to act on
+ * clock: internal clock index (0..4) of the refresh clock
+ *
+ * Return: true if the clock can count both periods, the reloads are left alone otherwise
+ */
+bool loadAdaptiveRates(SevenSegmentDisplay *display, int clock) {
+	int staticRate = periodToReload(clock, display->adaptiveStaticUs);
+	int activeRate = periodToReload(clock, display->adaptiveActiveUs);
+	if (staticRate < 0 || activeRate < 0) {
+		return false;
+	}
+	display->adaptiveStaticRate = staticRate;
+	display->adaptiveActiveRate = activeRate;
+	return true;
+}
+
+/*
+ * Function: setSevenSegmentAdaptiveRefreshCtx
+ * --------------------
+ * Runs the refresh clock at staticHz while the screen does not change and at activeHz while a
+ * counter, carousel, slider, sequencer or script is changing it
+ * The counter and transition interrupts compare the screen before and after each step and change
+ * the reload of the running refresh clock only when the state flips, the clock is not reset
+ * Replaces the refresh rate given to the display and setup functions until turned off
+ * Not available to displays refreshed by setupSevenSegmentMultiRefresh or the SPI chain
+ *
+ * display: the display to act on
+ * staticHz: refresh interrupts per second for a static screen, the lowest rate without flicker
+ * (4 interrupts per frame, so 240 gives 60 frames per second), 0 turns adaptive refresh off
+ * activeHz: refresh interrupts per second while the screen is changing, at least staticHz
+ *
+ * Return: true if set, false if the refresh clock cannot run at either rate or is not owned
+ */
+bool setSevenSegmentAdaptiveRefreshCtx(SevenSegmentDisplay *display, int staticHz, int activeHz) {
+	int clock = display->refresh.currentClock;
+	if (display->sharedRefresh || clock < 0 || sevenSegmentTimers[clock].display != display) {
+		return false;
+	}
+	if (staticHz == 0) {
+		// Left at the rate it is running at, which the refresh interrupt keeps using
+		display->adaptiveStaticRate = 0;
+		display->adaptiveActive = false;
+		return true;
+	}
+	if (staticHz < 0 || activeHz < staticHz) {
+		return false;
+	}
+	uint32_t staticUs = display->adaptiveStaticUs;
+	uint32_t activeUs = display->adaptiveActiveUs;
+	display->adaptiveStaticUs = (1000000 + staticHz / 2) / staticHz;
+	display->adaptiveActiveUs = (1000000 + activeHz / 2) / activeHz;
+	if (!loadAdaptiveRates(display, clock)) {
+		display->adaptiveStaticUs = staticUs;
+		display->adaptiveActiveUs = activeUs;
+		return false;
+	}
+	// The adaptive periods take over from a period set with setSevenSegmentRefreshHz
+	display->refreshPeriodUs = 0;
+	// A running mode raises the rate again on its next step if the screen keeps changing
+	display->adaptiveActive = false;
+	applyClockReload(display, clock, display->adaptiveStaticRate);
+	return true;
+}
+#endif
+
+
+#if SEVEN_SEGMENT_USE_WKT
+/************************************************************************************************
+ * 																								*
+ *							Seven Segment WKT Calibration Functions								*
+ * 		The low power oscillator clocking the WKT is off by tens of percent between parts		*
+ * 		and over temperature, the calibration scales WKT rates back to WKT_CLOCK_HZ				*
+ * 																								*
+ ************************************************************************************************/
+
+/*
+ * Function: getWKTCount
+ * --------------------
+ * Scales a WKT rate given in nominal WKT_CLOCK_HZ ticks by the calibration
+ * Function called internally whenever the WKT count is written
+ *
+ * rate: count at the nominal frequency
+ *
+ * Return: count at the calibrated frequency rounded to the nearest tick, at least 1
+ */
+uint32_t getWKTCount(int rate) {
+	// Uncalibrated parts skip the 64 bit multiply in the interrupt
+	if (sevenSegmentWKTScale == WKT_SCALE_ONE) {
+		return rate;
+	}
+	uint32_t count = ((uint64_t)rate * sevenSegmentWKTScale + WKT_SCALE_ONE / 2) >> 16;
+	if (count == 0) {
+		count = 1;
+	}
+	return count;
+}
+
+/*
+ * Function: setSevenSegmentWKTMeasurement
+ * --------------------
+ * Stores the WKT correction from a measurement of the low power oscillator, every WKT count
+ * written afterwards is scaled so the WKT rates keep their nominal WKT_CLOCK_HZ meaning
+ * Called by calibrateSevenSegmentWKT, also usable with a measurement made by the application
+ *
+ * lpoTicks: low power oscillator ticks counted
+ * referenceCycles: system clock cycles (SystemCoreClock) that passed meanwhile
+ *
+ * Return: true if stored, false if the measurement is more than a factor 2 off the nominal frequency
+ */
+bool setSevenSegmentWKTMeasurement(uint32_t lpoTicks, uint32_t referenceCycles) {
+	if (lpoTicks == 0 || referenceCycles == 0) {
+		return false;
+	}
+	uint64_t measuredHz = ((uint64_t)lpoTicks * SystemCoreClock + referenceCycles / 2) / referenceCycles;
+	if (measuredHz < WKT_CLOCK_HZ / 2 || measuredHz > (uint64_t)WKT_CLOCK_HZ * 2) {
+		return false;
+	}
+	sevenSegmentWKTScale = (measuredHz * WKT_SCALE_ONE + WKT_CLOCK_HZ / 2) / WKT_CLOCK_HZ;
+	return true;
+}
+
+#if SEVEN_SEGMENT_USE_MRT
+/*
+ * Function: calibrateSevenSegmentWKT
+ * --------------------
+ * Measures the low power oscillator against an MRT channel counting the system clock and stores
+ * the correction applied to all WKT rates, see setSevenSegmentWKTMeasurement
+ * Waits for about lpoTicks low power oscillator ticks, interrupts keep being served meanwhile
+ * Can be called again at any time, for example every few minutes, to follow temperature drift
+ * If the WKT is running a display its period must be longer than the measurement, otherwise
+ * the measurement is dropped
+ *
+ * referenceClock: "MRT0" or "MRT1", must not be in use
+ * lpoTicks: length of the measurement, 10000 takes about 10 ms and resolves the frequency to 0.01%
+ * The measurement must fit in half the 24 bit reference interval, under 0.46 s at 18 MHz
+ *
+ * Return: true if the correction was updated
+ */
+bool calibrateSevenSegmentWKT(char referenceClock[], int lpoTicks) {
+	int reference = getClockIndex(referenceClock);
+	if ((reference != 2 && reference != 3) || sevenSegmentTimers[reference].role != SEVEN_SEGMENT_TIMER_FREE || lpoTicks <= 0) {
+		return false;
+	}
+	int channel = reference - 2;
+	// Longest interval the reference counts down without reloading
+	uint32_t referenceMax = MRT_CHANNEL_INTVAL_IVALUE_MASK;
+
+	initTimerPeripheral(1);
+	initTimerPeripheral(reference);
+	bool wktFree = sevenSegmentTimers[1].role == SEVEN_SEGMENT_TIMER_FREE;
+	if (wktFree) {
+		// Run the WKT without its interrupt for the length of the measurement
+		NVIC_DisableIRQ(WKT_IRQn);
+		WKT->CTRL = WKT_CTRL_CLKSEL_MASK;
+		WKT->COUNT = UINT32_MAX;
+	}
+	MRT0->CHANNEL[channel].CTRL = (MRT_REPEAT << MRT_CHANNEL_CTRL_MODE_SHIFT);
+	MRT0->CHANNEL[channel].INTVAL = referenceMax | MRT_CHANNEL_INTVAL_LOAD_MASK;
+
+	// Both timers count down, each pair of readings is taken with interrupts masked so they line up
+	uint32_t primask = enterSevenSegmentCritical();
+	uint32_t lpoStart = WKT->COUNT;
+	uint32_t referenceStart = MRT0->CHANNEL[channel].TIMER & MRT_CHANNEL_TIMER_VALUE_MASK;
+	exitSevenSegmentCritical(primask);
+
+	uint32_t lpoEnd = lpoStart;
+	uint32_t referenceEnd = referenceStart;
+	bool valid = true;
+	while (valid && lpoStart - lpoEnd < (uint32_t)lpoTicks) {
+		primask = enterSevenSegmentCritical();
+		lpoEnd = WKT->COUNT;
+		referenceEnd = MRT0->CHANNEL[channel].TIMER & MRT_CHANNEL_TIMER_VALUE_MASK;
+		exitSevenSegmentCritical(primask);
+		// A reload of either timer spoils the measurement, so does an oscillator that is not running
+		valid = lpoEnd <= lpoStart && lpoEnd != 0 && referenceEnd <= referenceStart
+				&& referenceStart - referenceEnd < referenceMax / 2;
+	}
+
+	stopClock(reference);
+	if (wktFree) {
+		WKT->CTRL |= WKT_CTRL_CLEARCTR_MASK;
+		WKT->CTRL |= WKT_CTRL_ALARMFLAG_MASK;
+	}
+	if (!valid) {
+		return false;
+	}
+	return setSevenSegmentWKTMeasurement(lpoStart - lpoEnd, referenceStart - referenceEnd);
+}
+#endif
+
+/*
+ * Function: getSevenSegmentWKTClockHz
+ * --------------------
+ * Frequency of the low power oscillator as last calibrated
+ *
+ *
+ * Return: frequency in Hz, WKT_CLOCK_HZ until calibrated
+ */
+int getSevenSegmentWKTClockHz() {
+	return ((uint64_t)WKT_CLOCK_HZ * sevenSegmentWKTScale + WKT_SCALE_ONE / 2) / WKT_SCALE_ONE;
+}
+#endif
+
+
+/************************************************************************************************
+ * 																								*
+ *								Seven Segment Low Power Functions								*
+ * 		Sleep between the refresh and transition interrupts instead of spinning in main			*
+ * 																								*
+ ************************************************************************************************/
+
+/*
+ * Function: setSevenSegmentLowPower
+ * --------------------
+ * Chooses the deepest power mode sevenSegmentIdle may use between interrupts
+ * Deep-sleep stops the system clock, so only the WKT keeps running: it is used only while the
+ * WKT is the one clock in use, for example a display refreshed with "WKT" and no counter or
+ * transition clock, and falls back to sleep otherwise
+ * Wake-up from deep-sleep needs no set up again, the peripherals keep their registers and the
+ * blocks powered before sleeping are powered again on wake-up
+ *
+ * mode: SEVEN_SEGMENT_POWER_RUN, SEVEN_SEGMENT_POWER_SLEEP or SEVEN_SEGMENT_POWER_DEEP_SLEEP
+ *
+ * Return: no return
+ */
+void setSevenSegmentLowPower(int mode) {
+	sevenSegmentPowerMode = mode;
+	if (mode == SEVEN_SEGMENT_POWER_DEEP_SLEEP) {
+		uint32_t primask = enterSevenSegmentCritical();
+		// Keep the low power oscillator running in deep-sleep and let the WKT wake the part
+		SYSCON->PDSLEEPCFG &= ~(SYSCON_PDSLEEPCFG_LPOSC_PD_MASK);
+		SYSCON->STARTERP1 |= SYSCON_STARTERP1_WKT_MASK;
+		exitSevenSegmentCritical(primask);
+	}
+}
+
+/*
+ * Function: canSevenSegmentDeepSleep
+ * --------------------
+ * Checks that deep-sleep would stop nothing the displays need
+ * The WKT must be running to wake the part, every other timer must be free and the SPI chain,
+ * clocked from the system clock, must not be in use
+ * Function called internally by sevenSegmentIdle
+ *
+ *
+ * Return: true if deep-sleep can be used
+ */
+bool canSevenSegmentDeepSleep() {
+	if (sevenSegmentTimers[1].role == SEVEN_SEGMENT_TIMER_FREE || spiChainLength > 0) {
+		return false;
+	}
+	for (int clock = 0; clock < 5; clock++) {
+		if (clock != 1 && sevenSegmentTimers[clock].role != SEVEN_SEGMENT_TIMER_FREE) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/*
+ * Function: sevenSegmentIdle
+ * --------------------
+ * Puts the core to sleep until the next interrupt, in the mode chosen with setSevenSegmentLowPower
+ * Meant to be called over and over from the main loop in place of a busy loop
+ *
+ *
+ * Return: SEVEN_SEGMENT_POWER_... mode that was used
+ */
+int sevenSegmentIdle() {
+	int mode = sevenSegmentPowerMode;
+	if (mode == SEVEN_SEGMENT_POWER_DEEP_SLEEP && !canSevenSegmentDeepSleep()) {
+		mode = SEVEN_SEGMENT_POWER_SLEEP;
+	}
+	if (mode == SEVEN_SEGMENT_POWER_RUN) {
+		return mode;
+	}
+
+	if (mode == SEVEN_SEGMENT_POWER_DEEP_SLEEP) {
+		// Wake up with the same blocks powered as now, so nothing has to be set up again
+		SYSCON->PDAWAKECFG = SYSCON->PDRUNCFG;
+		PMU->PCON = PMU_PCON_PM(1);
+		SCB->SCR |= SCB_SCR_SLEEPDEEP_Msk;
+	} else {
+		PMU->PCON = PMU_PCON_PM(0);
+		SCB->SCR &= ~(SCB_SCR_SLEEPDEEP_Msk);
+	}
+	__DSB();
+	__WFI();
+	return mode;
+}
+
+
+/************************************************************************************************
+ * 																								*
+ *									Default Display Functions									*
+ * 		The original single display API, each acts on defaultSevenSegmentDisplay				*
+ * 		See seven_segment.h and the Ctx version of each function for details					*
+ * 																								*
+ ************************************************************************************************/
+
+void digitGPIOSetup(int channels[]) {
+	digitGPIOSetupCtx(&defaultSevenSegmentDisplay, channels);
+}
+
+void sevenSegmentGPIOSetup(int segs[]) {
+	sevenSegmentGPIOSetupCtx(&defaultSevenSegmentDisplay, segs);
+}
+
+void setSevenSegmentType(int type) {
+	setSevenSegmentTypeCtx(&defaultSevenSegmentDisplay, type);
+}
+
+void enableDecimalSegment(int decimalSegment) {
+	enableDecimalSegmentCtx(&defaultSevenSegmentDisplay, decimalSegment);
+}
+
+void sevenSegmentFullSetup(int channels[], int segs[], int decimalSegment) {
+	sevenSegmentFullSetupCtx(&defaultSevenSegmentDisplay, channels, segs, decimalSegment);
+}
+
+void setupSevenSegmentShiftRegister(int dataPin, int clockPin, int latchPin) {
+	setupSevenSegmentShiftRegisterCtx(&defaultSevenSegmentDisplay, dataPin, clockPin, latchPin);
+}
+
+void setupSevenSegmentTM1637(int clockPin, int dataPin) {
+	setupSevenSegmentTM1637Ctx(&defaultSevenSegmentDisplay, clockPin, dataPin);
+}
+
+void setupSevenSegmentCharlieplex(int lines[], int lineCount) {
+	setupSevenSegmentCharlieplexCtx(&defaultSevenSegmentDisplay, lines, lineCount);
+}
+
+void setSevenSegmentBackend(const struct SevenSegmentBackend *backend) {
+	setSevenSegmentBackendCtx(&defaultSevenSegmentDisplay, backend);
+}
+
+void toggleDecimalPoint() {
+	toggleDecimalPointCtx(&defaultSevenSegmentDisplay);
+}
+
+void setDecimalPoint() {
+	setDecimalPointCtx(&defaultSevenSegmentDisplay);
+}
+
+void clearDecimalPoint() {
+	clearDecimalPointCtx(&defaultSevenSegmentDisplay);
+}
+
+void setDecimalPointDigits(int digitMask) {
+	setDecimalPointDigitsCtx(&defaultSevenSegmentDisplay, digitMask);
+}
+
+void setSevenSegmentBlink(int digitMask, int dpMask, int newBlinkPeriod) {
+	setSevenSegmentBlinkCtx(&defaultSevenSegmentDisplay, digitMask, dpMask, newBlinkPeriod);
+}
+
+void clearSevenSegmentBlink() {
+	clearSevenSegmentBlinkCtx(&defaultSevenSegmentDisplay);
+}
+
+void setSevenSegmentBrightness(int level) {
+	setSevenSegmentBrightnessCtx(&defaultSevenSegmentDisplay, level);
+}
+
+int getSevenSegmentBrightness() {
+	return getSevenSegmentBrightnessCtx(&defaultSevenSegmentDisplay);
+}
+
+void displaySingleCharacter(char inputChar) {
+	displaySingleCharacterCtx(&defaultSevenSegmentDisplay, inputChar);
+}
+
+void displaySingleInt(int inputNum) {
+	displaySingleIntCtx(&defaultSevenSegmentDisplay, inputNum);
+}
+
+void display4Characters(char inputSequence[], char clockType[], int refreshRate) {
+	display4CharactersCtx(&defaultSevenSegmentDisplay, inputSequence, clockType, refreshRate);
+}
+
+void display4Numbers(int inputNumber, char clockType[], int refreshRate) {
+	display4NumbersCtx(&defaultSevenSegmentDisplay, inputNumber, clockType, refreshRate);
+}
+
+#if SEVEN_SEGMENT_USE_COUNTER
+void setupSevenSegmentCounter(int clockStart, char counterClock[], char newCountDirection[],
+		int newCountIncrement, int newStopValue, bool enableStopValue, int newCountRate, char refreshClock[],
+		int refreshRate) {
+	setupSevenSegmentCounterCtx(&defaultSevenSegmentDisplay, clockStart, counterClock, newCountDirection, newCountIncrement, newStopValue, enableStopValue, newCountRate, refreshClock, refreshRate);
+}
+#endif
+
+#if SEVEN_SEGMENT_USE_CAROUSEL
+void sevenSegmentDisplayTextCarousel(char characterSequence[], int sequenceLength, char newTransitionClock[],
+		int transitionSpeed, bool newEnableContinousCycle, bool newEnablePadding, char refreshClock[],
+		int refreshRate) {
+	sevenSegmentDisplayTextCarouselCtx(&defaultSevenSegmentDisplay, characterSequence, sequenceLength, newTransitionClock, transitionSpeed, newEnableContinousCycle, newEnablePadding, refreshClock, refreshRate);
+}
+#endif
+
+#if SEVEN_SEGMENT_USE_SLIDER
+void sevenSegmentDisplayTextSlider(char characterSequence[], int sequenceLength, char newTransitionClock[],
+		int transitionSpeed, bool newEnableContinousCycle, bool newEnablePadding, bool ignoreSingleSpaces,
+		char refreshClock[], int refreshRate) {
+	sevenSegmentDisplayTextSliderCtx(&defaultSevenSegmentDisplay, characterSequence, sequenceLength, newTransitionClock, transitionSpeed, newEnableContinousCycle, newEnablePadding, ignoreSingleSpaces, refreshClock, refreshRate);
+}
+#endif
+
+#if SEVEN_SEGMENT_USE_CAROUSEL
+void sevenSegmentDisplayTextCarouselWithDwell(char characterSequence[], int sequenceLength,
+		char newTransitionClock[], int transitionSpeed, bool newEnableContinousCycle, bool newEnablePadding,
+		char refreshClock[], int refreshRate, int dwellTimes[], int dwellCount, int easing) {
+	sevenSegmentDisplayTextCarouselWithDwellCtx(&defaultSevenSegmentDisplay, characterSequence, sequenceLength, newTransitionClock, transitionSpeed, newEnableContinousCycle, newEnablePadding, refreshClock, refreshRate, dwellTimes, dwellCount, easing);
+}
+#endif
+
+#if SEVEN_SEGMENT_USE_SLIDER
+void sevenSegmentDisplayTextSliderWithDwell(char characterSequence[], int sequenceLength,
+		char newTransitionClock[], int transitionSpeed, bool newEnableContinousCycle, bool newEnablePadding,
+		bool ignoreSingleSpaces, char refreshClock[], int refreshRate, int dwellTimes[], int dwellCount, int easing) {
+	sevenSegmentDisplayTextSliderWithDwellCtx(&defaultSevenSegmentDisplay, characterSequence, sequenceLength, newTransitionClock, transitionSpeed, newEnableContinousCycle, newEnablePadding, ignoreSingleSpaces, refreshClock, refreshRate, dwellTimes, dwellCount, easing);
+}
+#endif
+
+#if SEVEN_SEGMENT_USE_SEQUENCER
+void setupSevenSegmentSequencer(SevenSegmentJob jobs[], int jobCount, bool loopPlaylist,
+		char newTransitionClock[], int transitionSpeed, char refreshClock[], int refreshRate) {
+	setupSevenSegmentSequencerCtx(&defaultSevenSegmentDisplay, jobs, jobCount, loopPlaylist, newTransitionClock, transitionSpeed, refreshClock, refreshRate);
+}
+#endif
+
+#if SEVEN_SEGMENT_USE_CAROUSEL
+void setCarouselText(char characterSequence[], int sequenceLength, bool newEnableContinousCycle, bool newEnablePadding) {
+	setCarouselTextCtx(&defaultSevenSegmentDisplay, characterSequence, sequenceLength, newEnableContinousCycle, newEnablePadding);
+}
+#endif
+
+#if SEVEN_SEGMENT_USE_SLIDER
+void setSliderText(char characterSequence[], int sequenceLength, bool newEnableContinousCycle, bool newEnablePadding,
+		bool ignoreSingleSpaces) {
+	setSliderTextCtx(&defaultSevenSegmentDisplay, characterSequence, sequenceLength, newEnableContinousCycle, newEnablePadding,
+			ignoreSingleSpaces);
+}
+#endif
+
+#if SEVEN_SEGMENT_USE_COUNTER
+void setCounterValue(int clockStart, char newCountDirection[], int newCountIncrement, int newStopValue, bool enableStopValue) {
+	setCounterValueCtx(&defaultSevenSegmentDisplay, clockStart, newCountDirection, newCountIncrement, newStopValue, enableStopValue);
+}
+#endif
+
+int getSevenSegmentContentMode() {
+	return getSevenSegmentContentModeCtx(&defaultSevenSegmentDisplay);
+}
+
+void display4CharactersInterrupt(void) {
+	display4CharactersInterruptCtx(&defaultSevenSegmentDisplay);
+}
+
+void display4NumbersInterrupt() {
+	display4NumbersInterruptCtx(&defaultSevenSegmentDisplay);
+}
+
+#if SEVEN_SEGMENT_USE_CAROUSEL
+void displayCarouselInterrupt() {
+	displayCarouselInterruptCtx(&defaultSevenSegmentDisplay);
+}
+#endif
+
+#if SEVEN_SEGMENT_USE_SLIDER
+void displaySliderInterrupt() {
+	displaySliderInterruptCtx(&defaultSevenSegmentDisplay);
+}
+#endif
+
+#if SEVEN_SEGMENT_USE_COUNTER
+void updateSevenSegmentCounterInterrupt() {
+	updateSevenSegmentCounterInterruptCtx(&defaultSevenSegmentDisplay);
+}
+#endif
+
+#if SEVEN_SEGMENT_USE_CAROUSEL
+void sevenSegmentCarouselInterrupt() {
+	sevenSegmentCarouselInterruptCtx(&defaultSevenSegmentDisplay);
+}
+#endif
+
+#if SEVEN_SEGMENT_USE_SLIDER
+void sevenSegmentSliderInterrupt() {
+	sevenSegmentSliderInterruptCtx(&defaultSevenSegmentDisplay);
+}
+#endif
+
+#if SEVEN_SEGMENT_USE_SEQUENCER
+void sevenSegmentSequencerInterrupt() {
+	sevenSegmentSequencerInterruptCtx(&defaultSevenSegmentDisplay);
+}
+#endif
+
+void sevenSegmentContentInterrupt() {
+	sevenSegmentContentInterruptCtx(&defaultSevenSegmentDisplay);
+}
+
+#if SEVEN_SEGMENT_USE_COUNTER
+int getSevenSegmentDisplayCount() {
+	return getSevenSegmentDisplayCountCtx(&defaultSevenSegmentDisplay);
+}
+
+int getSevenSegmentTotalCount() {
+	return getSevenSegmentTotalCountCtx(&defaultSevenSegmentDisplay);
+}
+
+void toggleSevenSegmentCounterPause() {
+	toggleSevenSegmentCounterPauseCtx(&defaultSevenSegmentDisplay);
+}
+
+void pauseSevenSegmentCounter() {
+	pauseSevenSegmentCounterCtx(&defaultSevenSegmentDisplay);
+}
+
+void runSevenSegmentCounter() {
+	runSevenSegmentCounterCtx(&defaultSevenSegmentDisplay);
+}
+
+void resetSevenSegmentCount() {
+	resetSevenSegmentCountCtx(&defaultSevenSegmentDisplay);
+}
+
+void setSevenSegmentCount(int newCount) {
+	setSevenSegmentCountCtx(&defaultSevenSegmentDisplay, newCount);
+}
+
+void updateSevenSegmentIncrementer(int newIncrement) {
+	updateSevenSegmentIncrementerCtx(&defaultSevenSegmentDisplay, newIncrement);
+}
+
+void changeSevenSegmentCountDirection(char newDirection[]) {
+	changeSevenSegmentCountDirectionCtx(&defaultSevenSegmentDisplay, newDirection);
+}
+
+void setCountStopValue(int newStopValue) {
+	setCountStopValueCtx(&defaultSevenSegmentDisplay, newStopValue);
+}
+
+void clearCountStopValue() {
+	clearCountStopValueCtx(&defaultSevenSegmentDisplay);
+}
+#endif
+
+#if SEVEN_SEGMENT_USE_CAROUSEL
+void togglePauseSevenSegmentDisplayCarousel() {
+	togglePauseSevenSegmentDisplayCarouselCtx(&defaultSevenSegmentDisplay);
+}
+
+void pauseSevenSegmentDisplayCarousel() {
+	pauseSevenSegmentDisplayCarouselCtx(&defaultSevenSegmentDisplay);
+}
+
+void runSevenSegmentDisplayCarousel() {
+	runSevenSegmentDisplayCarouselCtx(&defaultSevenSegmentDisplay);
+}
+
+void restartSevenSegmentDisplayCarousel() {
+	restartSevenSegmentDisplayCarouselCtx(&defaultSevenSegmentDisplay);
+}
+#endif
+
+#if SEVEN_SEGMENT_USE_SLIDER
+void pauseSevenSegmentDisplaySlider() {
+	pauseSevenSegmentDisplaySliderCtx(&defaultSevenSegmentDisplay);
+}
+
+void togglePauseSevenSegmentDisplaySlider() {
+	togglePauseSevenSegmentDisplaySliderCtx(&defaultSevenSegmentDisplay);
+}
+
+void runSevenSegmentDisplaySlider() {
+	runSevenSegmentDisplaySliderCtx(&defaultSevenSegmentDisplay);
+}
+
+void restartSevenSegmentDisplaySlider() {
+	restartSevenSegmentDisplaySliderCtx(&defaultSevenSegmentDisplay);
+}
+#endif
+
+#if SEVEN_SEGMENT_USE_CAROUSEL || SEVEN_SEGMENT_USE_SLIDER
+void setSevenSegmentTransitionDwell(int dwellTimes[], int dwellCount, int easing) {
+	setSevenSegmentTransitionDwellCtx(&defaultSevenSegmentDisplay, dwellTimes, dwellCount, easing);
+}
+#endif
+
+#if SEVEN_SEGMENT_USE_SEQUENCER
+void pauseSevenSegmentSequencer() {
+	pauseSevenSegmentSequencerCtx(&defaultSevenSegmentDisplay);
+}
+
+void runSevenSegmentSequencer() {
+	runSevenSegmentSequencerCtx(&defaultSevenSegmentDisplay);
+}
+
+void restartSevenSegmentSequencer() {
+	restartSevenSegmentSequencerCtx(&defaultSevenSegmentDisplay);
+}
+
+int getSevenSegmentSequencerJob() {
+	return getSevenSegmentSequencerJobCtx(&defaultSevenSegmentDisplay);
+}
+
+bool isSevenSegmentSequencerFinished() {
+	return isSevenSegmentSequencerFinishedCtx(&defaultSevenSegmentDisplay);
+}
+#endif
+
+bool setSevenSegmentRefreshHz(int hz) {
+	return setSevenSegmentRefreshHzCtx(&defaultSevenSegmentDisplay, hz);
+}
+
+bool setSevenSegmentTransitionHz(int hz) {
+	return setSevenSegmentTransitionHzCtx(&defaultSevenSegmentDisplay, hz);
+}
+
+bool setSevenSegmentTransitionMs(int ms) {
+	return setSevenSegmentTransitionMsCtx(&defaultSevenSegmentDisplay, ms);
+}
+
+#if SEVEN_SEGMENT_USE_ADAPTIVE_REFRESH
+bool setSevenSegmentAdaptiveRefresh(int staticHz, int activeHz) {
+	return setSevenSegmentAdaptiveRefreshCtx(&defaultSevenSegmentDisplay, staticHz, activeHz);
 }
+#endif
@@ -12,6 +12,10 @@
 #ifndef SEVEN_SEGMENT_H_
 #define SEVEN_SEGMENT_H_
 
+#include "stdint.h"
+#include "stdbool.h"
+#include "seven_segment_config.h"
+
 // List of available characters for use
 const static char inputCharacterOptions[]  = {
 		'0', '1', '2', '3', '4', '5', '6', '7', '8', '9',
@@ -20,7 +24,7 @@ const static char inputCharacterOptions[]  = {
 		'U', 'V', 'W', 'X', 'Y', 'Z', '-', '=', '_', ' '};
 
 // List of available characters for use within the library in binary form
-const static int displayOptions[]  = {
+const static uint8_t displayOptions[]  = {
 	0b0111111, // 0
 	0b0000110, // 1
 	0b1011011, // 2
@@ -63,6 +67,430 @@ const static int displayOptions[]  = {
 	0b0000000, // _Space_
 };
 
+// Number of brightness steps, brightness is set between 0 (off) and MAX_BRIGHTNESS (full)
+#define MAX_BRIGHTNESS				(8)
+
+// Longest character sequence accepted by the carousel and slider, longer sequences are cut short
+#define MAX_SEQUENCE_LENGTH			(64)
+
+// Deepest nesting of counted LOOPs in a script, a script nesting them deeper stops
+#define SCRIPT_MAX_LOOP_DEPTH		(4)
+
+// Easing for the carousel and slider, frames near the start and/or end stay on the display longer
+#define TRANSITION_EASE_NONE		(0)
+#define TRANSITION_EASE_IN			(1)
+#define TRANSITION_EASE_OUT			(2)
+#define TRANSITION_EASE_IN_OUT		(3)
+
+// Sequencer job types
+#define SEQUENCER_JOB_STATIC		(0)	// 4 characters held on the display
+#define SEQUENCER_JOB_CAROUSEL		(1)
+#define SEQUENCER_JOB_SLIDER		(2)
+#define SEQUENCER_JOB_COUNTER		(3)
+
+// Sequencer completion conditions
+#define SEQUENCER_DONE_TICKS		(0)	// After completionValue transitions
+#define SEQUENCER_DONE_CAROUSEL		(1)	// When a one shot carousel reaches its last screen
+#define SEQUENCER_DONE_COUNTER		(2)	// When the counter reaches countStopValue
+#define SEQUENCER_DONE_SLIDER_PAGES	(3)	// After completionValue slider pages, or when a one shot slider ends
+
+/*
+ * Struct: SevenSegmentJob
+ * --------------------
+ * A single entry in a sequencer playlist
+ * Only the fields used by the job type need to be filled in
+ *
+ * jobType: one of the SEQUENCER_JOB_* values
+ * text: characters to display (exactly 4 for a static job)
+ * textLength: Length of text
+ * enableContinousCycle, enablePadding, ignoreSingleSpaces: as for the carousel and slider functions
+ * countStart, countDirection, countIncrement, countStopValue: as for setupSevenSegmentCounter
+ * completion: one of the SEQUENCER_DONE_* values
+ * completionValue: number of transitions or slider pages, depending on completion
+ */
+typedef struct {
+	int jobType;
+	char *text;
+	int textLength;
+	bool enableContinousCycle;
+	bool enablePadding;
+	bool ignoreSingleSpaces;
+	int countStart;
+	char *countDirection;
+	int countIncrement;
+	int countStopValue;
+	int completion;
+	int completionValue;
+} SevenSegmentJob;
+
+// Output backend of a display, see seven_segment_backend.h
+struct SevenSegmentBackend;
+
+// Lines used by a charlieplexed display: 7 segments + DP + 1
+#define CHARLIEPLEX_MAX_LINES		(9)
+
+// Most displays that can share one round-robin refresh interrupt
+#define MAX_SEVEN_SEGMENT_DISPLAYS	(4)
+
+// What a timer is used for, see getSevenSegmentTimerOwner
+#define SEVEN_SEGMENT_TIMER_FREE		(0)
+#define SEVEN_SEGMENT_TIMER_REFRESH		(1)
+#define SEVEN_SEGMENT_TIMER_COUNTER		(2)
+#define SEVEN_SEGMENT_TIMER_TRANSITION	(3)
+#define SEVEN_SEGMENT_TIMER_USER		(4)
+
+// Power modes sevenSegmentIdle can use between interrupts
+#define SEVEN_SEGMENT_POWER_RUN			(0)	// Returns at once, the core keeps running
+#define SEVEN_SEGMENT_POWER_SLEEP		(1)	// Core clock stopped, every timer keeps running
+#define SEVEN_SEGMENT_POWER_DEEP_SLEEP	(2)	// System clock stopped, only the WKT keeps running
+
+// Mode the content clock of a display is running, see sevenSegmentContentInterrupt
+#define SEVEN_SEGMENT_CONTENT_NONE		(0)
+#define SEVEN_SEGMENT_CONTENT_COUNTER	(1)
+#define SEVEN_SEGMENT_CONTENT_CAROUSEL	(2)
+#define SEVEN_SEGMENT_CONTENT_SLIDER	(3)
+#define SEVEN_SEGMENT_CONTENT_SEQUENCER	(4)
+#define SEVEN_SEGMENT_CONTENT_SCRIPT	(5)
+
+#ifdef SEVEN_SEGMENT_STATS
+/*
+ * Struct: SevenSegmentHealth
+ * --------------------
+ * How well a display keeps up with its clocks, see seven_segment_stats.h
+ * Times are in cycles of the main clock, measured with the stats clock
+ *
+ * refreshTicks: refresh interrupts of the display
+ * frames: frames completed, all 4 digits shown once
+ * framesPerSecond: frames completed in the last full second
+ * longestRefreshGap: longest time between two refresh interrupts of the display
+ *                    (these two stay 0 while the refresh period is a turn of the stats clock or more)
+ * transitions: counter, carousel, slider, sequencer and script transitions
+ * lateTransitions: transitions that came more than 1/8 of their period late
+ * coalescedTransitions: transition periods that passed without an interrupt of their own, the timer
+ *                       fired again before the previous interrupt was handled
+ * lastRefresh, lastTransition: stats clock readings at the last interrupts
+ * windowFrames, windowCycles: frames and time counted towards the next framesPerSecond
+ */
+typedef struct {
+	uint32_t refreshTicks;
+	uint32_t frames;
+	uint32_t framesPerSecond;
+	uint32_t longestRefreshGap;
+	uint32_t transitions;
+	uint32_t lateTransitions;
+	uint32_t coalescedTransitions;
+	uint32_t lastRefresh;
+	uint32_t lastTransition;
+	uint32_t windowFrames;
+	uint32_t windowCycles;
+} SevenSegmentHealth;
+#endif
+
+#ifdef SEVEN_SEGMENT_AUTO_DIM
+/*
+ * Struct: SevenSegmentAutoDim
+ * --------------------
+ * Brightness of a display following a light sensor, see seven_segment_light.h
+ *
+ * sampleFrames: refresh frames between two ADC samples, 0 when auto-dimming is off
+ * frameCount: frames since the last sample
+ * channel: ADC channel the light sensor is on
+ * primed: filtered holds a reading, the first sample is taken as it is
+ * minLevel: brightness in the dark
+ * filtered: low-pass filtered ADC reading in 12.4 fixed point
+ * darkReading: ADC reading at which the display is at minLevel
+ * levelScale: brightness levels per ADC step above darkReading in 20.12 fixed point, negative when
+ *             the reading falls as the light rises
+ * samples: ADC results taken since setupSevenSegmentAutoDim
+ */
+typedef struct {
+	uint16_t sampleFrames;
+	uint16_t frameCount;
+	int8_t channel;
+	bool primed;
+	uint8_t minLevel;
+	int32_t filtered;
+	int32_t darkReading;
+	int32_t levelScale;
+	uint32_t samples;
+} SevenSegmentAutoDim;
+#endif
+
+/*
+ * Struct: SevenSegmentRefreshState
+ * --------------------
+ * The part of a display read and written on every refresh interrupt
+ * Kept first in SevenSegmentDisplay and within 32 bytes, so the refresh interrupt reaches every field
+ * from the display pointer with one immediate offset load on the Cortex-M0+
+ *
+ * backend: backend that turns segment patterns into pin activity
+ * cycleRate: refresh rate for the display
+ * blinkPeriod: length of the on and off phases in refresh frames, 0 disables blinking
+ * blinkFrameCount: frames shown in the current blink phase
+ * chrSequence: characters shown on the 4 digits
+ * currentDigit: digit refreshed by the next interrupt
+ * currentClock: refresh clock index, -1 for none
+ * brightnessLevel: number of lit frames out of every MAX_BRIGHTNESS frames
+ * brightnessAccumulator: spreads the lit frames evenly over the frames
+ * decimalPointMask: digits the decimal point is shown on when enabled, bit n is the digit on channels[n]
+ * blinkDigitMask, blinkDPMask: blinking digits and decimal points, bit n is the digit on channels[n]
+ * sevenSegType: common anode (0) or common cathode (1)
+ * enableDP: the decimal point is shown
+ * frameLit: the current frame is lit, see brightnessLevel
+ * blinkOff: blinking digits are in their off phase
+ * screenPending: the pendingScreen of the display replaces chrSequence at the end of the frame
+ */
+typedef struct {
+	const struct SevenSegmentBackend *backend;
+	int cycleRate;
+	int blinkPeriod;
+	int blinkFrameCount;
+	char chrSequence[4];
+	int8_t currentDigit;
+	int8_t currentClock;
+	uint8_t brightnessLevel;
+	uint8_t brightnessAccumulator;
+	uint8_t decimalPointMask;
+	uint8_t blinkDigitMask;
+	uint8_t blinkDPMask;
+	uint8_t sevenSegType;
+	bool enableDP;
+	bool frameLit;
+	bool blinkOff;
+	bool screenPending;
+} __attribute__((aligned(4))) SevenSegmentRefreshState;
+
+/*
+ * Struct: SevenSegmentDisplay
+ * --------------------
+ * Everything the library knows about one display: pins, content and the state of each mode
+ * Every function has a Ctx version taking a display, the plain version uses defaultSevenSegmentDisplay
+ * New displays should start from SEVEN_SEGMENT_DISPLAY_DEFAULTS or be passed to initSevenSegmentDisplay
+ * The fields are managed by the library and should only be changed through its functions
+ * Flags written by the interrupts are plain bools, never bitfields: a bitfield write is a
+ * read-modify-write of the byte it shares, which can undo a flag set meanwhile in another context
+ */
+typedef struct {
+	// Refresh state, kept first so the refresh interrupt finds it at the display pointer
+	SevenSegmentRefreshState refresh;
+
+	// 7 Segment GPIO Pin outputs
+	int8_t segments[7];
+	//decimalPoint GPIO locations
+	int8_t dp;
+	// Pin Assignments of digits enabled, also controls which digits if not all are used
+	int8_t digits[4];
+	// Serial lines of the shift register and TM1637 backends
+	int8_t serialDataPin;
+	int8_t serialClockPin;
+	int8_t serialLatchPin;
+	// Position of the display on the SPI chain, 0 is nearest the LPC802
+	uint8_t chainPosition;
+	// Segments the TM1637 is showing or the charlieplex schedule was built for, -1 if unknown
+	int16_t shownSegments[4];
+	// Charlieplexed lines, the direction/data masks of each digit place are rebuilt only when its segments change
+	int8_t charlieLines[CHARLIEPLEX_MAX_LINES];
+	uint8_t charlieLineCount;
+	uint32_t charlieLineMask;
+	uint32_t charlieDirMask[4];
+	uint32_t charlieHighMask[4];
+	// Segments shown by displaySingleCharacter, -1 while a timer based function is refreshing
+	int16_t staticSegments;
+	// Periods set with the timing functions in microseconds, recomputed by updateSevenSegmentTiming
+	// 0 when the clock was given a raw reload value
+	uint32_t refreshPeriodUs;
+	uint32_t countPeriodUs;
+	uint32_t transitionPeriodUs;
+
+	// Screen queued by the content swap functions, stored like chrSequence, see screenPending
+	char pendingScreen[4];
+	// Mode run by the counter or transition clock, SEVEN_SEGMENT_CONTENT_...
+	uint8_t contentMode;
+	// Refreshed by a shared round-robin interrupt, the display does not own its refresh clock
+	bool sharedRefresh : 1;
+#if SEVEN_SEGMENT_USE_ADAPTIVE_REFRESH
+	// Refresh reloads while the screen is static and while it is changing, 0 when adaptive refresh is off
+	int adaptiveStaticRate;
+	int adaptiveActiveRate;
+	// Periods the adaptive reloads were worked out from, recomputed by updateSevenSegmentTiming
+	uint32_t adaptiveStaticUs;
+	uint32_t adaptiveActiveUs;
+	// The refresh clock is running at adaptiveActiveRate
+	bool adaptiveActive;
+#endif
+
+	// Speed at which counting happens -> how often the interrupt is triggered
+	int countRate;
+	// Which clock is used for the counter
+	int8_t countClock;
+#if SEVEN_SEGMENT_USE_COUNTER
+	// Count Down Clock
+	int startCount;
+	int currentCount;
+	// Normalized -> count within 9999 & 0000 limit but the counter can exceed this
+	int normalizedCount;
+	// Either "UP" or "DOWN"
+	char countDirection[5];
+	// The increment for the counter
+	int countIncrement;
+	// A preset stop value to end the counting sequence, if not enabled, the counter wraps around
+	int countStopValue;
+	bool pauseCounter;
+	bool enableCountStopValue;
+#endif
+
+	// Transition clock is the clock for the carousel/slider motion & rate determines speed
+	int8_t transitionClock;
+	int transitionRate;
+	// Optional per-frame transition periods and easing for the carousel and slider
+	int *transitionDwellTimes;
+	int transitionDwellCount;
+	uint8_t transitionEasing;
+	// Continuous carousel/slider or one-shot
+	bool enableContinousCycle;
+
+#if SEVEN_SEGMENT_USE_CAROUSEL
+	// Carousel Component -> allows for larger segments of text
+	int transitionIndex;
+	// How long the sentence/characters being displayed is
+	int carouselSequenceLength;
+	// Sized for the longest sequence plus a blank start and end screen
+	char carouselSequence[MAX_SEQUENCE_LENGTH + 8];
+	bool carouselOverflow;
+	bool pauseCarouselTransition;
+#endif
+
+#if SEVEN_SEGMENT_USE_SLIDER
+	// Slider Component -> slides a new set of 4 characters onto the screen
+	char sliderSequence[MAX_SEQUENCE_LENGTH + 8];
+	int sliderSequenceLength;
+	int sliderTransitionIndex;
+	// Number of slider pages displayed since the slider was loaded
+	int sliderPagesShown;
+	bool pauseSliderTransition;
+#endif
+
+#if SEVEN_SEGMENT_USE_SEQUENCER
+	// Sequencer Component -> steps through a playlist of jobs on the transition clock
+	SevenSegmentJob *sequencerJobs;
+	int sequencerJobCount;
+	int sequencerJobIndex;
+	// Transition ticks spent on the current job
+	int sequencerJobTicks;
+	bool sequencerLoop;
+	bool pauseSequencer;
+	bool sequencerFinished;
+#endif
+
+#if SEVEN_SEGMENT_USE_SCRIPT
+	// Script Component -> plays a bytecode script (see seven_segment_script.h)
+	const uint8_t *scriptCode;
+	int scriptLength;
+	int scriptPc;
+	// Opcode that is still running over several transitions
+	int scriptActiveOp;
+	int scriptRemainingTicks;
+	// Brightness restored once a BLINK finishes
+	int scriptBlinkBrightness;
+	// Address and passes left of each LOOP being repeated, innermost last
+	uint16_t scriptLoopPc[SCRIPT_MAX_LOOP_DEPTH];
+	uint8_t scriptLoopRemaining[SCRIPT_MAX_LOOP_DEPTH];
+	uint8_t scriptLoopDepth;
+	bool scriptFinished;
+	bool pauseScript;
+#endif
+
+#ifdef SEVEN_SEGMENT_STATS
+	// Achieved refresh rate and transition lag, see getSevenSegmentHealth
+	SevenSegmentHealth health;
+#endif
+#ifdef SEVEN_SEGMENT_AUTO_DIM
+	// Light sensor sampling, see setupSevenSegmentAutoDim
+	SevenSegmentAutoDim autoDim;
+#endif
+} SevenSegmentDisplay;
+
+// Backend used by displays set up with digitGPIOSetup/sevenSegmentGPIOSetup
+extern const struct SevenSegmentBackend sevenSegmentGPIOBackend;
+
+// Starting values of the state of each mode, empty for modes left out by seven_segment_config.h
+#if SEVEN_SEGMENT_USE_COUNTER
+#define SEVEN_SEGMENT_COUNTER_DEFAULTS \
+	.startCount = -1, \
+	.currentCount = -1, \
+	.normalizedCount = -1, \
+	.enableCountStopValue = true,
+#else
+#define SEVEN_SEGMENT_COUNTER_DEFAULTS
+#endif
+
+#if SEVEN_SEGMENT_USE_CAROUSEL
+#define SEVEN_SEGMENT_CAROUSEL_DEFAULTS \
+	.transitionIndex = -1, \
+	.carouselSequenceLength = -1,
+#else
+#define SEVEN_SEGMENT_CAROUSEL_DEFAULTS
+#endif
+
+#if SEVEN_SEGMENT_USE_SLIDER
+#define SEVEN_SEGMENT_SLIDER_DEFAULTS \
+	.sliderSequenceLength = -1, \
+	.sliderTransitionIndex = -1,
+#else
+#define SEVEN_SEGMENT_SLIDER_DEFAULTS
+#endif
+
+#if SEVEN_SEGMENT_USE_SEQUENCER
+#define SEVEN_SEGMENT_SEQUENCER_DEFAULTS \
+	.sequencerJobIndex = -1,
+#else
+#define SEVEN_SEGMENT_SEQUENCER_DEFAULTS
+#endif
+
+#if SEVEN_SEGMENT_USE_SCRIPT
+#define SEVEN_SEGMENT_SCRIPT_DEFAULTS \
+	.scriptFinished = true, \
+	.scriptBlinkBrightness = MAX_BRIGHTNESS,
+#else
+#define SEVEN_SEGMENT_SCRIPT_DEFAULTS
+#endif
+
+// Starting values for a display, fields not listed start at 0/false/NULL
+#define SEVEN_SEGMENT_DISPLAY_DEFAULTS { \
+	.refresh = { \
+		.backend = &sevenSegmentGPIOBackend, \
+		.cycleRate = -1, \
+		.chrSequence = {' ', ' ', ' ', ' '}, \
+		.currentDigit = -1, \
+		.currentClock = -1, \
+		.brightnessLevel = MAX_BRIGHTNESS, \
+		.decimalPointMask = 0xF, \
+		.sevenSegType = 1, \
+		.frameLit = true, \
+	}, \
+	.segments = {-1, -1, -1, -1, -1, -1, -1}, \
+	.dp = -1, \
+	.digits = {-1, -1, -1, -1}, \
+	.serialDataPin = -1, \
+	.serialClockPin = -1, \
+	.serialLatchPin = -1, \
+	.shownSegments = {-1, -1, -1, -1}, \
+	.staticSegments = -1, \
+	.countRate = -1, \
+	.countClock = -1, \
+	SEVEN_SEGMENT_COUNTER_DEFAULTS \
+	.transitionClock = -1, \
+	.transitionRate = -1, \
+	.transitionEasing = TRANSITION_EASE_NONE, \
+	SEVEN_SEGMENT_CAROUSEL_DEFAULTS \
+	SEVEN_SEGMENT_SLIDER_DEFAULTS \
+	SEVEN_SEGMENT_SEQUENCER_DEFAULTS \
+	SEVEN_SEGMENT_SCRIPT_DEFAULTS \
+}
+
+// The display used by every function without a display parameter
+extern SevenSegmentDisplay defaultSevenSegmentDisplay;
+
 /************************************************************************************************
  * 																								*
  * 								Seven Segment Configuration Functions							*
@@ -132,6 +560,134 @@ void enableDecimalSegment(int decimalSegment);
  */
 void sevenSegmentFullSetup(int channels[], int segs[], int decimalSegment);
 
+/*
+ * Function: setupSevenSegmentShiftRegister
+ * --------------------
+ * Drives the display through two chained 74HC595 shift registers instead of direct GPIOs
+ * The register nearest the LPC802 drives segments A..G and the decimal point on QA..QH,
+ * the second drives the digits on QA..QD (QA is the right most digit)
+ * setSevenSegmentType picks the output levels the same way as for direct GPIOs
+ *
+ * dataPin: GPIO Pin wired to SER of the first register
+ * clockPin: GPIO Pin wired to SRCLK of both registers
+ * latchPin: GPIO Pin wired to RCLK of both registers
+ *
+ * Return: no return
+ */
+void setupSevenSegmentShiftRegister(int dataPin, int clockPin, int latchPin);
+
+/*
+ * Function: setupSevenSegmentTM1637
+ * --------------------
+ * Drives the display through a TM1637 driver chip instead of direct GPIOs
+ * The module must have pull ups on both lines, the LPC802 only ever pulls them low
+ *
+ * clockPin: GPIO Pin wired to CLK
+ * dataPin: GPIO Pin wired to DIO
+ *
+ * Return: no return
+ */
+void setupSevenSegmentTM1637(int clockPin, int dataPin);
+
+/*
+ * Function: setupSevenSegmentCharlieplex
+ * --------------------
+ * Drives a charlieplexed display from 8 lines (no decimal point) or 9 lines (with decimal point)
+ * Lines that are not driven are tri-stated with GPIO->DIRCLR so only one digit conducts at a time
+ * Digit place k has its common on lines[k], segment j (A..G, DP) of digit k is on lines[j] for
+ * j < k and on lines[j + 1] otherwise
+ * Only the timer based functions can be used, displaySingleCharacter lights the right most digit
+ * tools/charlieplex_check.py checks the wiring for LEDs lit through sneak paths
+ *
+ * lines: GPIO Pins of the lines in order
+ * lineCount: 8 or 9
+ *
+ * Return: no return
+ */
+void setupSevenSegmentCharlieplex(int lines[], int lineCount);
+
+/*
+ * Function: setSevenSegmentBackend
+ * --------------------
+ * Drives the display through a user supplied backend (see seven_segment_backend.h)
+ * Any pins the backend needs should be set on the display before calling this
+ *
+ * backend: backend providing init, writeDigit and writeFrame, must stay valid while in use
+ *
+ * Return: no return
+ */
+void setSevenSegmentBackend(const struct SevenSegmentBackend *backend);
+
+/*
+ * Function: setSevenSegmentInterruptPriorities
+ * --------------------
+ * Sets the NVIC priorities given to the timers started from now on, 0 is the most urgent
+ * The refresh clock gets refreshPriority, counter and transition clocks get transitionPriority
+ * Call before the display functions, the defaults come from seven_segment_config.h
+ * MRT0 and MRT1 share one interrupt, when one of them refreshes the interrupt keeps the refresh priority
+ *
+ * refreshPriority: priority of the refresh interrupt (and the SPI interrupt of an SPI chain)
+ * transitionPriority: priority of the counter, carousel, slider, sequencer and script interrupts
+ *
+ * Return: no return
+ */
+void setSevenSegmentInterruptPriorities(int refreshPriority, int transitionPriority);
+
+/*
+ * Function: reserveSevenSegmentTimer
+ * --------------------
+ * Keeps a timer for the application, display functions asked to use it leave it alone and report
+ * a conflict instead
+ *
+ * clock: from the list "SysTick", "WKT", "MRT0", "MRT1", "CTIMER0"
+ *
+ * Return: true if reserved, false if a display already uses the timer
+ */
+bool reserveSevenSegmentTimer(char clock[]);
+
+/*
+ * Function: releaseSevenSegmentTimer
+ * --------------------
+ * Gives a timer reserved with reserveSevenSegmentTimer back to the display functions
+ *
+ * clock: from the list "SysTick", "WKT", "MRT0", "MRT1", "CTIMER0"
+ *
+ * Return: no return
+ */
+void releaseSevenSegmentTimer(char clock[]);
+
+/*
+ * Function: getSevenSegmentTimerOwner
+ * --------------------
+ * Tells what a timer is used for
+ *
+ * clock: from the list "SysTick", "WKT", "MRT0", "MRT1", "CTIMER0"
+ *
+ * Return: SEVEN_SEGMENT_TIMER_FREE, _REFRESH, _COUNTER, _TRANSITION or _USER, -1 if the name is not recognized
+ */
+int getSevenSegmentTimerOwner(char clock[]);
+
+/*
+ * Function: getSevenSegmentTimerConflicts
+ * --------------------
+ * Timers a display function was refused since the last clearSevenSegmentTimerConflicts, because
+ * another display or the application was using them
+ *
+ *
+ * Return: bit n set for each refused timer, 0 == SysTick, 1 == WKT, 2 == MRT0, 3 = MRT1, 4 = CTIMER0
+ */
+int getSevenSegmentTimerConflicts();
+
+/*
+ * Function: clearSevenSegmentTimerConflicts
+ * --------------------
+ * Forgets the conflicts reported by getSevenSegmentTimerConflicts
+ *
+ *
+ * Return: no return
+ */
+void clearSevenSegmentTimerConflicts();
+
 
 /*
  * Function: toggleDecimalPoint
@@ -162,6 +718,63 @@ void setDecimalPoint();
  */
 void clearDecimalPoint();
 
+/*
+ * Function: setDecimalPointDigits
+ * --------------------
+ * Pick which digits show the decimal point when it is turned on
+ * Only applies to the timer based functions, displaySingleCharacter shows it on every digit
+ *
+ * digitMask: bit n is the digit on channels[n] (0xF shows it on every digit)
+ *
+ * Return: no return
+ */
+void setDecimalPointDigits(int digitMask);
+
+/*
+ * Function: setSevenSegmentBlink
+ * --------------------
+ * Blink digits and/or decimal points, handled within the refresh interrupt
+ * Blinking does not use a timer of its own, the phase is counted in refresh frames
+ *
+ * digitMask: digits to blink, bit n is the digit on channels[n]
+ * dpMask: decimal points to blink, bit n is the digit on channels[n]
+ * newBlinkPeriod: length of the on and off phases in refresh frames (4 refresh interrupts each)
+ *
+ * Return: no return
+ */
+void setSevenSegmentBlink(int digitMask, int dpMask, int newBlinkPeriod);
+
+/*
+ * Function: clearSevenSegmentBlink
+ * --------------------
+ * Stop all blinking, every digit and decimal point is shown steadily again
+ *
+ * Return: no return
+ */
+void clearSevenSegmentBlink();
+
+/*
+ * Function: setSevenSegmentBrightness
+ * --------------------
+ * Set the brightness of the display by skipping whole refresh frames
+ * Only applies to the timer based functions, the refresh rate should be high enough
+ * that MAX_BRIGHTNESS frames still pass without visible flicker
+ *
+ * level: 0 (off) .. MAX_BRIGHTNESS (full brightness), values outside the range are clamped
+ *
+ * Return: no return
+ */
+void setSevenSegmentBrightness(int level);
+
+/*
+ * Function: getSevenSegmentBrightness
+ * --------------------
+ * Getter for the current brightness level
+ *
+ * Return: brightnessLevel
+ */
+int getSevenSegmentBrightness();
+
 
 /************************************************************************************************
  * 																								*
@@ -239,6 +852,7 @@ void display4Characters(char inputSequence[], char clockType[], int refreshRate)
 void display4Numbers(int inputNumber, char clockType[], int refreshRate);
 
 
+#if SEVEN_SEGMENT_USE_COUNTER
 /*
  * Function: setupSevenSegmentCounter
  * --------------------
@@ -262,8 +876,10 @@ void display4Numbers(int inputNumber, char clockType[], int refreshRate);
 void setupSevenSegmentCounter(int clockStart, char counterClock[],  char newCountDirection[],
 		int newCountIncrement, int newStopValue, bool enableStopValue, int newCountRate, char refreshClock[],
 		int refreshRate);
+#endif
 
 
+#if SEVEN_SEGMENT_USE_CAROUSEL
 /*
  * Function: sevenSegmentDisplayTextCarousel
  * --------------------
@@ -286,7 +902,9 @@ void setupSevenSegmentCounter(int clockStart, char counterClock[],  char newCoun
  */
 void sevenSegmentDisplayTextCarousel(char characterSequence[], int sequenceLength, char newTransitionClock[],
 		int transitionSpeed, bool newEnableContinousCycle, bool newEnablePadding, char refreshClock[], int refreshRate);
+#endif
 
+#if SEVEN_SEGMENT_USE_SLIDER
 /*
  * Function: sevenSegmentDisplayTextSlider
  * --------------------
@@ -312,8 +930,150 @@ void sevenSegmentDisplayTextCarousel(char characterSequence[], int sequenceLengt
 void sevenSegmentDisplayTextSlider(char characterSequence[], int sequenceLength, char newTransitionClock[],
 		int transitionSpeed, bool newEnableContinousCycle, bool newEnablePadding, bool ignoreSingleSpaces,
 		char refreshClock[], int refreshRate);
+#endif
+
+
+#if SEVEN_SEGMENT_USE_CAROUSEL
+/*
+ * Function: sevenSegmentDisplayTextCarouselWithDwell
+ * --------------------
+ * Same as sevenSegmentDisplayTextCarousel, with a different period for each screen of the carousel
+ * The transition clock period is changed between screens without resetting the clock
+ *
+ * characterSequence .. refreshRate: as for sevenSegmentDisplayTextCarousel
+ * dwellTimes: period of each screen in the same units as transitionSpeed, NULL to use transitionSpeed
+ * dwellCount: number of entries in dwellTimes, later screens use transitionSpeed
+ * easing: TRANSITION_EASE_NONE, TRANSITION_EASE_IN, TRANSITION_EASE_OUT or TRANSITION_EASE_IN_OUT
+ *
+ * Return: no return
+ */
+void sevenSegmentDisplayTextCarouselWithDwell(char characterSequence[], int sequenceLength, char newTransitionClock[],
+		int transitionSpeed, bool newEnableContinousCycle, bool newEnablePadding, char refreshClock[], int refreshRate,
+		int dwellTimes[], int dwellCount, int easing);
+#endif
+
+#if SEVEN_SEGMENT_USE_SLIDER
+/*
+ * Function: sevenSegmentDisplayTextSliderWithDwell
+ * --------------------
+ * Same as sevenSegmentDisplayTextSlider, with a different period for each page of the slider
+ * The transition clock period is changed between pages without resetting the clock
+ *
+ * characterSequence .. refreshRate: as for sevenSegmentDisplayTextSlider
+ * dwellTimes: period of each page in the same units as transitionSpeed, NULL to use transitionSpeed
+ * dwellCount: number of entries in dwellTimes, later pages use transitionSpeed
+ * easing: TRANSITION_EASE_NONE, TRANSITION_EASE_IN, TRANSITION_EASE_OUT or TRANSITION_EASE_IN_OUT
+ *
+ * Return: no return
+ */
+void sevenSegmentDisplayTextSliderWithDwell(char characterSequence[], int sequenceLength, char newTransitionClock[],
+		int transitionSpeed, bool newEnableContinousCycle, bool newEnablePadding, bool ignoreSingleSpaces,
+		char refreshClock[], int refreshRate, int dwellTimes[], int dwellCount, int easing);
+#endif
+
+#if SEVEN_SEGMENT_USE_SEQUENCER
+/*
+ * Function: setupSevenSegmentSequencer
+ * --------------------
+ * Runs a playlist of display jobs (static screens, carousels, sliders and counters) one after another
+ * This function calls the 2 timers configurations internally, once for the whole playlist
+ * Calling the respective interrupts will refresh the display and step through the playlist
+ * Jobs move on when their completion condition is met, without reconfiguring either clock
+ *
+ * jobs: playlist of jobs, must stay valid while the sequencer is running
+ * jobCount: number of jobs in the playlist
+ * loopPlaylist: true implies the playlist starts over after the last job, false stops on the last screen
+ * newTransitionClock: from the list "SysTick", "WKT", "MRT0", "MRT1", "CTIMER0" as input
+ * transitionSpeed: Speed of all carousel, slider and counter steps as well as the unit of job durations
+ * refreshClock: from the list: "SysTick", "WKT", "MRT0", "MRT1", "CTIMER0"
+ * refreshRate: speed of cycling through digits
+ * NOTE: newTransitionClock & refreshClock cannot be the same clock
+ *
+ * Return: no return
+ */
+void setupSevenSegmentSequencer(SevenSegmentJob jobs[], int jobCount, bool loopPlaylist, char newTransitionClock[],
+		int transitionSpeed, char refreshClock[], int refreshRate);
+#endif
 
 
+/************************************************************************************************
+ * 																								*
+ *									Content Swap Functions										*
+ * 		Replace what a running display shows without reconfiguring the refresh clock or the		*
+ * 		counter/transition clock, the new first screen is shown from the next frame on			*
+ * 		The clock keeps the period it was started with, the dwell times stay as they were		*
+ * 		When switching between modes call sevenSegmentContentInterrupt in the clock's			*
+ * 		interrupt, or define SEVEN_SEGMENT_IRQ_HANDLERS, so the new mode is the one stepped		*
+ * 																								*
+ ************************************************************************************************/
+
+#if SEVEN_SEGMENT_USE_CAROUSEL
+/*
+ * Function: setCarouselText
+ * --------------------
+ * Replaces the content with a carousel, keeping the clocks of the running mode
+ * The counter or transition clock moves on the carousel at its current period
+ * If no mode is running the carousel only shows its first screen until a clock is started
+ *
+ * characterSequence: As long of a sequence as desired of characters ("Hello World")
+ * sequenceLength: Length of Sequence
+ * newEnableContinousCycle: true implies the coaursel will cycle, false implies a one shot action
+ * newEnablePadding: Pad the sequence with a blank start and end screen
+ *
+ * Return: no return
+ */
+void setCarouselText(char characterSequence[], int sequenceLength, bool newEnableContinousCycle, bool newEnablePadding);
+#endif
+
+#if SEVEN_SEGMENT_USE_SLIDER
+/*
+ * Function: setSliderText
+ * --------------------
+ * Replaces the content with a slider, keeping the clocks of the running mode
+ * The counter or transition clock moves on the slider at its current period
+ * If no mode is running the slider only shows its first page until a clock is started
+ *
+ * characterSequence: As long of a sequence as desired of characters ("Hello World")
+ * sequenceLength: Length of Sequence
+ * newEnableContinousCycle: true implies the slider will cycle, false implies a one shot action
+ * newEnablePadding: Pad the sequence with a blank start and end screen
+ * ignoreSingleSpaces: True or False, sequences with single spaces will have the spaces ignored
+ *
+ * Return: no return
+ */
+void setSliderText(char characterSequence[], int sequenceLength, bool newEnableContinousCycle, bool newEnablePadding,
+		bool ignoreSingleSpaces);
+#endif
+
+#if SEVEN_SEGMENT_USE_COUNTER
+/*
+ * Function: setCounterValue
+ * --------------------
+ * Replaces the content with a counter, keeping the clocks of the running mode
+ * The counter or transition clock counts at its current period
+ * If no mode is running the counter only shows its start value until a clock is started
+ *
+ * clockStart: Starting count for the display
+ * newCountDirection: "UP" or "DOWN"
+ * newCountIncrement: counter increment/decrement depending on direction (negatives are allowed)
+ * newStopValue: early stop point for counting
+ * enableStopValue: true or false
+ *
+ * Return: no return
+ */
+void setCounterValue(int clockStart, char newCountDirection[], int newCountIncrement, int newStopValue, bool enableStopValue);
+#endif
+
+/*
+ * Function: getSevenSegmentContentMode
+ * --------------------
+ * Tells which mode the counter or transition clock is running
+ *
+ *
+ * Return: SEVEN_SEGMENT_CONTENT_NONE, _COUNTER, _CAROUSEL, _SLIDER, _SEQUENCER or _SCRIPT
+ */
+int getSevenSegmentContentMode();
+
 
 /************************************************************************************************
  * 																								*
@@ -351,6 +1111,7 @@ void display4CharactersInterrupt(void);
  */
 void display4NumbersInterrupt();
 
+#if SEVEN_SEGMENT_USE_CAROUSEL
 /*
  * Function: displayCarouselInterrupt
  * --------------------
@@ -365,7 +1126,9 @@ void display4NumbersInterrupt();
  * Return: no return
  */
 void displayCarouselInterrupt();
+#endif
 
+#if SEVEN_SEGMENT_USE_SLIDER
 /*
  * Function: displaySliderInterrupt
  * --------------------
@@ -380,7 +1143,9 @@ void displayCarouselInterrupt();
  * Return: no return
  */
 void displaySliderInterrupt();
+#endif
 
+#if SEVEN_SEGMENT_USE_COUNTER
 /*
  * Function: updateSevenSegmentCounterInterrupt
  * --------------------
@@ -394,7 +1159,9 @@ void displaySliderInterrupt();
  * Return: no return
  */
 void updateSevenSegmentCounterInterrupt();
+#endif
 
+#if SEVEN_SEGMENT_USE_CAROUSEL
 /*
  * Function: sevenSegmentCarouselInterrupt
  * --------------------
@@ -409,7 +1176,9 @@ void updateSevenSegmentCounterInterrupt();
  * Return: no return
  */
 void sevenSegmentCarouselInterrupt();
+#endif
 
+#if SEVEN_SEGMENT_USE_SLIDER
 /*
  * Function: sevenSegmentSliderInterrupt
  * --------------------
@@ -425,6 +1194,38 @@ void sevenSegmentCarouselInterrupt();
  * Return: no return
  */
 void sevenSegmentSliderInterrupt();
+#endif
+
+
+#if SEVEN_SEGMENT_USE_SEQUENCER
+/*
+ * Function: sevenSegmentSequencerInterrupt
+ * --------------------
+ * Interrupt for the sequencer if the seven segment display runs a playlist of jobs
+ * Steps the current job, then moves on to the next job once its completion condition is met
+ * Switching jobs only reloads the content, the refresh and transition clocks keep running
+ * This function should be called within the interrupt that handles transitions
+ *
+ * Used when setupSevenSegmentSequencer is used, where the clock associated with transitions
+ * was passing into newTransitionClock
+ *
+ *
+ * Return: no return
+ */
+void sevenSegmentSequencerInterrupt();
+#endif
+
+/*
+ * Function: sevenSegmentContentInterrupt
+ * --------------------
+ * Calls the interrupt function of the mode the counter or transition clock is running
+ * Can be called instead of the mode's own interrupt function, so content swapped in by
+ * setCarouselText, setSliderText or setCounterValue is stepped whatever its mode
+ *
+ *
+ * Return: no return
+ */
+void sevenSegmentContentInterrupt();
 
 
 
@@ -434,6 +1235,7 @@ void sevenSegmentSliderInterrupt();
  * 		These functions can be used to make changes to the counter in real time if in use		*
  * 																								*
  ************************************************************************************************/
+#if SEVEN_SEGMENT_USE_COUNTER
 /*
  * Function: getSevenSegmentDisplayCount
  * --------------------
@@ -564,6 +1366,7 @@ void setCountStopValue(int newStopValue);
  * Return: no return
  */
 void clearCountStopValue();
+#endif
 
 
 
@@ -576,6 +1379,7 @@ void clearCountStopValue();
  ************************************************************************************************/
 
 
+#if SEVEN_SEGMENT_USE_CAROUSEL
 /*
  * Function: togglePauseSevenSegmentDisplayCarousel
  * --------------------
@@ -616,6 +1420,7 @@ void runSevenSegmentDisplayCarousel();
  * Return: no return
  */
 void restartSevenSegmentDisplayCarousel();
+#endif
 
 
 
@@ -626,6 +1431,7 @@ void restartSevenSegmentDisplayCarousel();
  * 																								*
  ************************************************************************************************/
 
+#if SEVEN_SEGMENT_USE_SLIDER
 /*
  * Function: pauseSevenSegmentDisplaySlider
  * --------------------
@@ -669,7 +1475,487 @@ void runSevenSegmentDisplaySlider();
  * Return: no return
  */
 void restartSevenSegmentDisplaySlider();
+#endif
+
+
+
+/************************************************************************************************
+ * 																								*
+ *							Seven Segment Transition Helper Functions							*
+ * 		These functions can be used to change the carousel and slider timing in real time		*
+ * 																								*
+ ************************************************************************************************/
+
+#if SEVEN_SEGMENT_USE_CAROUSEL || SEVEN_SEGMENT_USE_SLIDER
+/*
+ * Function: setSevenSegmentTransitionDwell
+ * --------------------
+ * Change the per-screen periods and easing of a running carousel or slider
+ * Called before the carousel or slider is set up, the first screen gets its period from the start
+ * Passing NULL, 0 and TRANSITION_EASE_NONE goes back to a fixed transitionSpeed
+ *
+ * dwellTimes: period of each screen in the same units as transitionSpeed, NULL to use transitionSpeed
+ * dwellCount: number of entries in dwellTimes, later screens use transitionSpeed
+ * easing: TRANSITION_EASE_NONE, TRANSITION_EASE_IN, TRANSITION_EASE_OUT or TRANSITION_EASE_IN_OUT
+ *
+ * Return: no return
+ */
+void setSevenSegmentTransitionDwell(int dwellTimes[], int dwellCount, int easing);
+#endif
+
+
+
+/************************************************************************************************
+ * 																								*
+ *							Seven Segment Sequencer Helper Functions							*
+ * 		These functions can be used to make changes to the sequencer in real time if in use		*
+ * 																								*
+ ************************************************************************************************/
+
+#if SEVEN_SEGMENT_USE_SEQUENCER
+/*
+ * Function: pauseSevenSegmentSequencer
+ * --------------------
+ * Pause the sequencer, the current screen stays on the display
+ *
+ *
+ * Return: no return
+ */
+void pauseSevenSegmentSequencer();
+
+/*
+ * Function: runSevenSegmentSequencer
+ * --------------------
+ * Continue the sequencer if paused
+ *
+ *
+ * Return: no return
+ */
+void runSevenSegmentSequencer();
+
+/*
+ * Function: restartSevenSegmentSequencer
+ * --------------------
+ * Start the playlist from the first job again
+ * Removes the pause on the sequencer if any
+ *
+ *
+ * Return: no return
+ */
+void restartSevenSegmentSequencer();
+
+/*
+ * Function: getSevenSegmentSequencerJob
+ * --------------------
+ * Getter for the position of the job currently displayed in the playlist
+ *
+ *
+ * Return: sequencerJobIndex
+ */
+int getSevenSegmentSequencerJob();
+
+/*
+ * Function: isSevenSegmentSequencerFinished
+ * --------------------
+ * Check if a playlist without looping has completed its last job
+ *
+ *
+ * Return: true if finished
+ */
+bool isSevenSegmentSequencerFinished();
+#endif
+
+
+
+/************************************************************************************************
+ * 																								*
+ *							Seven Segment Timing Functions										*
+ * 		Set the clocks of a running display in Hz or milliseconds instead of reload values		*
+ * 		SysTick, the MRT and CTIMER0 count the system clock (SystemCoreClock), the WKT its		*
+ * 		low power oscillator, so the same rate means very different periods on each timer		*
+ * 																								*
+ ************************************************************************************************/
+
+/*
+ * Function: getSevenSegmentReloadForHz
+ * --------------------
+ * Works out the reload value to pass as a refreshRate, countRate or transitionSpeed for an
+ * interrupt frequency, from the clock the timer is counting right now
+ * SysTick and the MRT take up to 24 bit reloads, the WKT and CTIMER0 up to 31 bits
+ *
+ * clock: from the list "SysTick", "WKT", "MRT0", "MRT1", "CTIMER0"
+ * hz: interrupts per second
+ *
+ * Return: reload value, -1 if the timer cannot run at that frequency
+ */
+int getSevenSegmentReloadForHz(char clock[], int hz);
+
+/*
+ * Function: getSevenSegmentReloadForMs
+ * --------------------
+ * Same as getSevenSegmentReloadForHz for a period in milliseconds
+ *
+ * clock: from the list "SysTick", "WKT", "MRT0", "MRT1", "CTIMER0"
+ * ms: time between interrupts
+ *
+ * Return: reload value, -1 if the timer cannot count that period
+ */
+int getSevenSegmentReloadForMs(char clock[], int ms);
+
+/*
+ * Function: setSevenSegmentRefreshHz
+ * --------------------
+ * Changes the rate of the running refresh clock, one digit is refreshed per interrupt
+ * Must be called after the display or setup function has started the refresh clock
+ * Not available to displays refreshed by setupSevenSegmentMultiRefresh or the SPI chain
+ * Turns off adaptive refresh, see setSevenSegmentAdaptiveRefresh
+ *
+ * hz: refresh interrupts per second, a frame of 4 digits takes 4 interrupts
+ *
+ * Return: true if the rate was changed, false if the clock cannot run at hz or is not owned
+ */
+bool setSevenSegmentRefreshHz(int hz);
+
+/*
+ * Function: setSevenSegmentTransitionHz
+ * --------------------
+ * Changes the rate of the running counter or transition clock
+ * Must be called after the setup function has started the clock
+ * Dwell times set with setSevenSegmentTransitionDwell stay raw reload values
+ *
+ * hz: counter or transition steps per second
+ *
+ * Return: true if the rate was changed, false if the clock cannot run at hz or no mode is running
+ */
+bool setSevenSegmentTransitionHz(int hz);
+
+/*
+ * Function: setSevenSegmentTransitionMs
+ * --------------------
+ * Same as setSevenSegmentTransitionHz for a period in milliseconds
+ *
+ * ms: time between counter or transition steps
+ *
+ * Return: true if the period was changed, false if the clock cannot count ms or no mode is running
+ */
+bool setSevenSegmentTransitionMs(int ms);
+
+/*
+ * Function: updateSevenSegmentTiming
+ * --------------------
+ * Recomputes the reloads of every clock set with the timing functions, for every display
+ * Call after changing the system clock (and SystemCoreClock) so the displays keep their rates
+ * Clocks given raw reload values are left alone
+ *
+ *
+ * Return: no return
+ */
+void updateSevenSegmentTiming();
+
+#if SEVEN_SEGMENT_USE_ADAPTIVE_REFRESH
+/*
+ * Function: setSevenSegmentAdaptiveRefresh
+ * --------------------
+ * Runs the refresh clock at staticHz while the screen does not change and at activeHz while a
+ * counter, carousel, slider, sequencer or script is changing it
+ * The counter and transition interrupts compare the screen before and after each step and change
+ * the reload of the running refresh clock only when the state flips, the clock is not reset
+ * Replaces the refresh rate given to the display and setup functions until turned off
+ * Not available to displays refreshed by setupSevenSegmentMultiRefresh or the SPI chain
+ *
+ * staticHz: refresh interrupts per second for a static screen, the lowest rate without flicker
+ * (4 interrupts per frame, so 240 gives 60 frames per second), 0 turns adaptive refresh off
+ * activeHz: refresh interrupts per second while the screen is changing, at least staticHz
+ *
+ * Return: true if set, false if the refresh clock cannot run at either rate or is not owned
+ */
+bool setSevenSegmentAdaptiveRefresh(int staticHz, int activeHz);
+#endif
+
+#if SEVEN_SEGMENT_USE_WKT
+/************************************************************************************************
+ * 																								*
+ *							Seven Segment WKT Calibration Functions								*
+ * 		The low power oscillator clocking the WKT is off by tens of percent between parts		*
+ * 		and over temperature, the calibration scales WKT rates back to WKT_CLOCK_HZ				*
+ * 																								*
+ ************************************************************************************************/
+
+/*
+ * Function: setSevenSegmentWKTMeasurement
+ * --------------------
+ * Stores the WKT correction from a measurement of the low power oscillator, every WKT count
+ * written afterwards is scaled so the WKT rates keep their nominal WKT_CLOCK_HZ meaning
+ * Called by calibrateSevenSegmentWKT, also usable with a measurement made by the application
+ *
+ * lpoTicks: low power oscillator ticks counted
+ * referenceCycles: system clock cycles (SystemCoreClock) that passed meanwhile
+ *
+ * Return: true if stored, false if the measurement is more than a factor 2 off the nominal frequency
+ */
+bool setSevenSegmentWKTMeasurement(uint32_t lpoTicks, uint32_t referenceCycles);
+
+#if SEVEN_SEGMENT_USE_MRT
+/*
+ * Function: calibrateSevenSegmentWKT
+ * --------------------
+ * Measures the low power oscillator against an MRT channel counting the system clock and stores
+ * the correction applied to all WKT rates, see setSevenSegmentWKTMeasurement
+ * Waits for about lpoTicks low power oscillator ticks, interrupts keep being served meanwhile
+ * Can be called again at any time, for example every few minutes, to follow temperature drift
+ * If the WKT is running a display its period must be longer than the measurement, otherwise
+ * the measurement is dropped
+ *
+ * referenceClock: "MRT0" or "MRT1", must not be in use
+ * lpoTicks: length of the measurement, 10000 takes about 10 ms and resolves the frequency to 0.01%
+ * The measurement must fit in half the 24 bit reference interval, under 0.46 s at 18 MHz
+ *
+ * Return: true if the correction was updated
+ */
+bool calibrateSevenSegmentWKT(char referenceClock[], int lpoTicks);
+#endif
+
+/*
+ * Function: getSevenSegmentWKTClockHz
+ * --------------------
+ * Frequency of the low power oscillator as last calibrated
+ *
+ *
+ * Return: frequency in Hz, WKT_CLOCK_HZ until calibrated
+ */
+int getSevenSegmentWKTClockHz();
+#endif
+
+
+/************************************************************************************************
+ * 																								*
+ *								Seven Segment Low Power Functions								*
+ * 		Sleep between the refresh and transition interrupts instead of spinning in main			*
+ * 																								*
+ ************************************************************************************************/
+
+/*
+ * Function: setSevenSegmentLowPower
+ * --------------------
+ * Chooses the deepest power mode sevenSegmentIdle may use between interrupts
+ * Deep-sleep stops the system clock, so only the WKT keeps running: it is used only while the
+ * WKT is the one clock in use, for example a display refreshed with "WKT" and no counter or
+ * transition clock, and falls back to sleep otherwise
+ * Wake-up from deep-sleep needs no set up again, the peripherals keep their registers and the
+ * blocks powered before sleeping are powered again on wake-up
+ *
+ * mode: SEVEN_SEGMENT_POWER_RUN, SEVEN_SEGMENT_POWER_SLEEP or SEVEN_SEGMENT_POWER_DEEP_SLEEP
+ *
+ * Return: no return
+ */
+void setSevenSegmentLowPower(int mode);
+
+/*
+ * Function: sevenSegmentIdle
+ * --------------------
+ * Puts the core to sleep until the next interrupt, in the mode chosen with setSevenSegmentLowPower
+ * Meant to be called over and over from the main loop in place of a busy loop
+ *
+ *
+ * Return: SEVEN_SEGMENT_POWER_... mode that was used
+ */
+int sevenSegmentIdle();
 
 
+/************************************************************************************************
+ * 																								*
+ *									Multiple Display Functions									*
+ * 			Each display has its own SevenSegmentDisplay and its own pins						*
+ * 																								*
+ ************************************************************************************************/
+
+/*
+ * Function: initSevenSegmentDisplay
+ * --------------------
+ * Puts a display back to its starting values
+ * Must be called on a display before its pins are set up unless it was
+ * declared with SEVEN_SEGMENT_DISPLAY_DEFAULTS
+ *
+ * display: the display to initialise
+ *
+ * Return: no return
+ */
+void initSevenSegmentDisplay(SevenSegmentDisplay *display);
+
+/*
+ * Function: setupSevenSegmentMultiRefresh
+ * --------------------
+ * Refreshes several displays from one clock, one display per interrupt in turn
+ * Each interrupt costs the same as refreshing a single display however many displays there are
+ * Must be called before the display/setup functions of the displays, which then leave the refresh
+ * clock alone and only start their own counter or transition clocks
+ * Calling displayMultipleInterrupt will refresh the displays
+ *
+ * displays: displays to refresh, their pins must not overlap
+ * displayCount: number of displays, at most MAX_SEVEN_SEGMENT_DISPLAYS
+ * refreshClock: from the list: "SysTick", "WKT", "MRT0", "MRT1", "CTIMER0"
+ * refreshRate: time between interrupts, each display is refreshed every displayCount interrupts
+ * NOTE: refreshClock cannot be used as a counter or transition clock by any of the displays
+ *
+ * Return: no return
+ */
+void setupSevenSegmentMultiRefresh(SevenSegmentDisplay *displays[], int displayCount, char refreshClock[], int refreshRate);
+
+/*
+ * Function: displayMultipleInterrupt
+ * --------------------
+ * Refreshes the next display in turn, one digit per interrupt
+ * Should be called in the interrupt from the timer associated with the refreshRate
+ * Used when setupSevenSegmentMultiRefresh is used
+ *
+ *
+ * Return: no return
+ */
+void displayMultipleInterrupt();
+
+
+/************************************************************************************************
+ * 																								*
+ *									Display Context Functions									*
+ * 																								*
+ ************************************************************************************************/
+
+/*
+ * Functions: ...Ctx
+ * --------------------
+ * Each function below behaves like the function of the same name above, acting on the given display
+ * The functions above act on defaultSevenSegmentDisplay
+ * The interrupt functions must be called with the display whose clocks raised the interrupt
+ *
+ * display: the display to act on, set up with SEVEN_SEGMENT_DISPLAY_DEFAULTS or initSevenSegmentDisplay
+ */
+void digitGPIOSetupCtx(SevenSegmentDisplay *display, int channels[]);
+void sevenSegmentGPIOSetupCtx(SevenSegmentDisplay *display, int segs[]);
+void setSevenSegmentTypeCtx(SevenSegmentDisplay *display, int type);
+void enableDecimalSegmentCtx(SevenSegmentDisplay *display, int decimalSegment);
+void sevenSegmentFullSetupCtx(SevenSegmentDisplay *display, int channels[], int segs[], int decimalSegment);
+void setupSevenSegmentShiftRegisterCtx(SevenSegmentDisplay *display, int dataPin, int clockPin, int latchPin);
+void setupSevenSegmentTM1637Ctx(SevenSegmentDisplay *display, int clockPin, int dataPin);
+void setupSevenSegmentCharlieplexCtx(SevenSegmentDisplay *display, int lines[], int lineCount);
+void setSevenSegmentBackendCtx(SevenSegmentDisplay *display, const struct SevenSegmentBackend *backend);
+void toggleDecimalPointCtx(SevenSegmentDisplay *display);
+void setDecimalPointCtx(SevenSegmentDisplay *display);
+void clearDecimalPointCtx(SevenSegmentDisplay *display);
+void setDecimalPointDigitsCtx(SevenSegmentDisplay *display, int digitMask);
+void setSevenSegmentBlinkCtx(SevenSegmentDisplay *display, int digitMask, int dpMask, int newBlinkPeriod);
+void clearSevenSegmentBlinkCtx(SevenSegmentDisplay *display);
+void setSevenSegmentBrightnessCtx(SevenSegmentDisplay *display, int level);
+int getSevenSegmentBrightnessCtx(SevenSegmentDisplay *display);
+void displaySingleCharacterCtx(SevenSegmentDisplay *display, char inputChar);
+void displaySingleIntCtx(SevenSegmentDisplay *display, int inputNum);
+void display4CharactersCtx(SevenSegmentDisplay *display, char inputSequence[], char clockType[],
+		int refreshRate);
+void display4NumbersCtx(SevenSegmentDisplay *display, int inputNumber, char clockType[], int refreshRate);
+#if SEVEN_SEGMENT_USE_COUNTER
+void setupSevenSegmentCounterCtx(SevenSegmentDisplay *display, int clockStart, char counterClock[],
+		char newCountDirection[], int newCountIncrement, int newStopValue, bool enableStopValue, int newCountRate,
+		char refreshClock[], int refreshRate);
+#endif
+#if SEVEN_SEGMENT_USE_CAROUSEL
+void sevenSegmentDisplayTextCarouselCtx(SevenSegmentDisplay *display, char characterSequence[],
+		int sequenceLength, char newTransitionClock[], int transitionSpeed, bool newEnableContinousCycle,
+		bool newEnablePadding, char refreshClock[], int refreshRate);
+#endif
+#if SEVEN_SEGMENT_USE_SLIDER
+void sevenSegmentDisplayTextSliderCtx(SevenSegmentDisplay *display, char characterSequence[],
+		int sequenceLength, char newTransitionClock[], int transitionSpeed, bool newEnableContinousCycle,
+		bool newEnablePadding, bool ignoreSingleSpaces, char refreshClock[], int refreshRate);
+#endif
+#if SEVEN_SEGMENT_USE_CAROUSEL
+void sevenSegmentDisplayTextCarouselWithDwellCtx(SevenSegmentDisplay *display, char characterSequence[],
+		int sequenceLength, char newTransitionClock[], int transitionSpeed, bool newEnableContinousCycle,
+		bool newEnablePadding, char refreshClock[], int refreshRate, int dwellTimes[], int dwellCount, int easing);
+#endif
+#if SEVEN_SEGMENT_USE_SLIDER
+void sevenSegmentDisplayTextSliderWithDwellCtx(SevenSegmentDisplay *display, char characterSequence[],
+		int sequenceLength, char newTransitionClock[], int transitionSpeed, bool newEnableContinousCycle,
+		bool newEnablePadding, bool ignoreSingleSpaces, char refreshClock[], int refreshRate, int dwellTimes[],
+		int dwellCount, int easing);
+#endif
+#if SEVEN_SEGMENT_USE_SEQUENCER
+void setupSevenSegmentSequencerCtx(SevenSegmentDisplay *display, SevenSegmentJob jobs[], int jobCount,
+		bool loopPlaylist, char newTransitionClock[], int transitionSpeed, char refreshClock[], int refreshRate);
+#endif
+#if SEVEN_SEGMENT_USE_CAROUSEL
+void setCarouselTextCtx(SevenSegmentDisplay *display, char characterSequence[], int sequenceLength,
+		bool newEnableContinousCycle, bool newEnablePadding);
+#endif
+#if SEVEN_SEGMENT_USE_SLIDER
+void setSliderTextCtx(SevenSegmentDisplay *display, char characterSequence[], int sequenceLength,
+		bool newEnableContinousCycle, bool newEnablePadding, bool ignoreSingleSpaces);
+#endif
+#if SEVEN_SEGMENT_USE_COUNTER
+void setCounterValueCtx(SevenSegmentDisplay *display, int clockStart, char newCountDirection[], int newCountIncrement,
+		int newStopValue, bool enableStopValue);
+#endif
+int getSevenSegmentContentModeCtx(SevenSegmentDisplay *display);
+bool setSevenSegmentRefreshHzCtx(SevenSegmentDisplay *display, int hz);
+bool setSevenSegmentTransitionHzCtx(SevenSegmentDisplay *display, int hz);
+bool setSevenSegmentTransitionMsCtx(SevenSegmentDisplay *display, int ms);
+#if SEVEN_SEGMENT_USE_ADAPTIVE_REFRESH
+bool setSevenSegmentAdaptiveRefreshCtx(SevenSegmentDisplay *display, int staticHz, int activeHz);
+#endif
+void display4CharactersInterruptCtx(SevenSegmentDisplay *display);
+void display4NumbersInterruptCtx(SevenSegmentDisplay *display);
+#if SEVEN_SEGMENT_USE_CAROUSEL
+void displayCarouselInterruptCtx(SevenSegmentDisplay *display);
+#endif
+#if SEVEN_SEGMENT_USE_SLIDER
+void displaySliderInterruptCtx(SevenSegmentDisplay *display);
+#endif
+#if SEVEN_SEGMENT_USE_COUNTER
+void updateSevenSegmentCounterInterruptCtx(SevenSegmentDisplay *display);
+#endif
+#if SEVEN_SEGMENT_USE_CAROUSEL
+void sevenSegmentCarouselInterruptCtx(SevenSegmentDisplay *display);
+#endif
+#if SEVEN_SEGMENT_USE_SLIDER
+void sevenSegmentSliderInterruptCtx(SevenSegmentDisplay *display);
+#endif
+#if SEVEN_SEGMENT_USE_SEQUENCER
+void sevenSegmentSequencerInterruptCtx(SevenSegmentDisplay *display);
+#endif
+void sevenSegmentContentInterruptCtx(SevenSegmentDisplay *display);
+#if SEVEN_SEGMENT_USE_COUNTER
+int getSevenSegmentDisplayCountCtx(SevenSegmentDisplay *display);
+int getSevenSegmentTotalCountCtx(SevenSegmentDisplay *display);
+void toggleSevenSegmentCounterPauseCtx(SevenSegmentDisplay *display);
+void pauseSevenSegmentCounterCtx(SevenSegmentDisplay *display);
+void runSevenSegmentCounterCtx(SevenSegmentDisplay *display);
+void resetSevenSegmentCountCtx(SevenSegmentDisplay *display);
+void setSevenSegmentCountCtx(SevenSegmentDisplay *display, int newCount);
+void updateSevenSegmentIncrementerCtx(SevenSegmentDisplay *display, int newIncrement);
+void changeSevenSegmentCountDirectionCtx(SevenSegmentDisplay *display, char newDirection[]);
+void setCountStopValueCtx(SevenSegmentDisplay *display, int newStopValue);
+void clearCountStopValueCtx(SevenSegmentDisplay *display);
+#endif
+#if SEVEN_SEGMENT_USE_CAROUSEL
+void togglePauseSevenSegmentDisplayCarouselCtx(SevenSegmentDisplay *display);
+void pauseSevenSegmentDisplayCarouselCtx(SevenSegmentDisplay *display);
+void runSevenSegmentDisplayCarouselCtx(SevenSegmentDisplay *display);
+void restartSevenSegmentDisplayCarouselCtx(SevenSegmentDisplay *display);
+#endif
+#if SEVEN_SEGMENT_USE_SLIDER
+void pauseSevenSegmentDisplaySliderCtx(SevenSegmentDisplay *display);
+void togglePauseSevenSegmentDisplaySliderCtx(SevenSegmentDisplay *display);
+void runSevenSegmentDisplaySliderCtx(SevenSegmentDisplay *display);
+void restartSevenSegmentDisplaySliderCtx(SevenSegmentDisplay *display);
+#endif
+#if SEVEN_SEGMENT_USE_CAROUSEL || SEVEN_SEGMENT_USE_SLIDER
+void setSevenSegmentTransitionDwellCtx(SevenSegmentDisplay *display, int dwellTimes[], int dwellCount,
+		int easing);
+#endif
+#if SEVEN_SEGMENT_USE_SEQUENCER
+void pauseSevenSegmentSequencerCtx(SevenSegmentDisplay *display);
+void runSevenSegmentSequencerCtx(SevenSegmentDisplay *display);
+void restartSevenSegmentSequencerCtx(SevenSegmentDisplay *display);
+int getSevenSegmentSequencerJobCtx(SevenSegmentDisplay *display);
+bool isSevenSegmentSequencerFinishedCtx(SevenSegmentDisplay *display);
+#endif
 
 #endif /* SEVEN_SEGMENT_H_ */
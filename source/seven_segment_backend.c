@@ -0,0 +1,1182 @@
+/****************************************************************
+ * 																*
+ *					Seven Segment Output Backends				*
+ * 		Turn segment patterns into pin activity for the		*
+ * 		different ways a display can be wired to the LPC802		*
+ * 																*
+ ****************************************************************/
+
+#include "LPC802.h"
+#include "seven_segment.h"
+#include "seven_segment_backend.h"
+#include "seven_segment_internal.h"
+#include "seven_segment_irq.h"
+#include "seven_segment_stats.h"
+#include "seven_segment_trace.h"
+#include "stdbool.h"
+#include "stdint.h"
+#include "string.h"
+
+// SPI0 function clock select, 0 = FRO
+#define SPI0_FCLKSEL_INDEX			(9)
+#define SPI0_FCLKSEL_FRO			(0)
+
+// SPI register block used by the SPI chain backend, host builds can point this at a mock
+SPI_Type *sevenSegmentSPI = SPI0;
+
+// Displays on the SPI chain, position 0 is the one nearest the LPC802
+SevenSegmentDisplay *spiChainDisplays[MAX_SPI_CHAIN_DISPLAYS];
+int spiChainLength = 0;
+int spiChainType = SPI_CHAIN_74HC595;
+int spiChainClock = -1;
+int spiChainRate = -1;
+// One 16 bit word per display, sent from the far end of the chain to position 0
+// Volatile as the SPI interrupt reads the words the refresh interrupt and spiChainSendAll write
+volatile uint16_t spiChainFrame[MAX_SPI_CHAIN_DISPLAYS];
+// Position of the word last handed to the SPI, 0 once the whole frame is queued
+// Volatile as the SPI interrupt counts it down while spiChainWait polls it
+volatile int spiChainNext = 0;
+
+
+/************************************************************************************************
+ * 																								*
+ *									Direct GPIO Backend											*
+ * 			One GPIO per segment and per digit, digits are multiplexed by the refresh interrupt	*
+ * 																								*
+ ************************************************************************************************/
+
+/*
+ * Function: gpioBackendInit
+ * --------------------
+ * Sets the digit, segment and decimal point GPIOs as outputs with every digit off
+ * Digits and the decimal point set to -1 are left alone
+ * Function called internally through the backend
+ *
+ * display: the display to act on
+ *
+ * Return: no return
+ */
+void gpioBackendInit(SevenSegmentDisplay *display) {
+	SYSCON->SYSAHBCLKCTRL0 |= (SYSCON_SYSAHBCLKCTRL0_GPIO0_MASK); // GPIO is on
+	// Loop through the digits, turning them on if set to a good value (not -1)
+	for (int i = 0; i < 4; i++) {
+		if (display->digits[i] != -1) {
+			WRITE_GPIO_DIRSET(1UL<<display->digits[i]);
+		}
+	}
+	clearDigits(display);
+
+	// Set the direction of the gpios for the segments, allows for either an enable bit or not
+	for(int i = 0; i < 7; i++) {
+		WRITE_GPIO_DIRSET(1UL<<display->segments[i]);
+	}
+	if (display->dp != -1) {
+		WRITE_GPIO_DIRSET(1UL<<display->dp);
+	}
+}
+
+/*
+ * Function: gpioBackendWriteDigit
+ * --------------------
+ * Turns every digit off, sets the segments and turns the one digit place back on
+ * Function called internally through the backend
+ *
+ * display: the display to act on
+ * digitPlace: digit (0..3) to show
+ * segmentBits: segments A..G in bits 0..6, decimal point in bit 7
+ * lit: false leaves every digit off
+ *
+ * Return: no return
+ */
+void gpioBackendWriteDigit(SevenSegmentDisplay *display, int digitPlace, int segmentBits, bool lit) {
+	clearDigits(display);
+	displaySegments(display, segmentBits);
+	if (display->dp != -1) {
+		displayDPState(display, (segmentBits & SEGMENT_DP_BIT) != 0);
+	}
+	if (lit) {
+		enableDigit(display, digitPlace);
+	}
+}
+
+/*
+ * Function: gpioBackendWriteFrame
+ * --------------------
+ * Sets the segments and turns every digit on
+ * Function called internally through the backend
+ *
+ * display: the display to act on
+ * segmentBits: segments A..G in bits 0..6, decimal point in bit 7
+ *
+ * Return: no return
+ */
+void gpioBackendWriteFrame(SevenSegmentDisplay *display, int segmentBits) {
+	clearDigits(display);
+	displaySegments(display, segmentBits);
+	if (display->dp != -1) {
+		displayDPState(display, (segmentBits & SEGMENT_DP_BIT) != 0);
+	}
+	enableDigits(display);
+}
+
+/*
+ * Function: clearDigits
+ * --------------------
+ * Clear the content being displayed
+ * Used internally by the direct GPIO backend for switching between digits
+ *
+ * display: the display to act on
+ *
+ *
+ * Return: no return
+ */
+void clearDigits(SevenSegmentDisplay *display) {
+	for (int i = 0; i < 4; i++) {
+		if (display->digits[i] != -1) {
+			if (display->refresh.sevenSegType == 1) {
+				WRITE_GPIO_SET(1UL<<display->digits[i]); // Set the Digit bit i to 1
+			} else {
+				WRITE_GPIO_CLR(1UL<<display->digits[i]); // Set the Digit bit i to 0
+			}
+		}
+	}
+}
+
+/*
+ * Function: enableDigits
+ * --------------------
+ * If only 1 character is being displayed then there is no need to loop so all digits are turned on
+ * If a User wishes to display 0000, or 8888, or ---- for example
+ *
+ * display: the display to act on
+ *
+ *
+ * Return: no return
+ */
+void enableDigits(SevenSegmentDisplay *display) {
+	for (int i = 0; i < 4; i++) {
+		if (display->digits[i] != -1) {
+			if (display->refresh.sevenSegType == 1) {
+				WRITE_GPIO_CLR(1UL<<display->digits[i]); // Set the Digit bit i to 0
+			} else {
+				WRITE_GPIO_SET(1UL<<display->digits[i]); // Set the Digit bit i to 1
+			}
+		}
+	}
+}
+
+/*
+ * Function: enableDigit
+ * --------------------
+ * Pick the next digit in the sequence to enable & disable the rest
+ * Function used internally for swapping currently displayed digit
+ *
+ * display: the display to act on
+ * digitPlace: the current digit(0..3) that needs to be updated
+ *
+ * Return: no return
+ */
+void enableDigit(SevenSegmentDisplay *display, int digitPlace) {
+	if (display->digits[digitPlace] != -1) {
+		if (display->refresh.sevenSegType == 1) {
+			WRITE_GPIO_CLR(1UL<<display->digits[digitPlace]); // Set the Digit bit i to 0
+
+		} else {
+			WRITE_GPIO_SET(1UL<<display->digits[digitPlace]); // Set the Digit bit i to 1
+		}
+	}
+
+}
+
+/*
+ * Function: displayDPState
+ * --------------------
+ * Turn the decimal point segment on or off
+ * Function used internally by the direct GPIO backend
+ *
+ * display: the display to act on
+ * dpOn: true turns the decimal point segment on
+ *
+ * Return: no return
+ */
+void displayDPState(SevenSegmentDisplay *display, bool dpOn) {
+	if (dpOn) {
+		if (display->refresh.sevenSegType == 1) {
+			WRITE_GPIO_SET(1UL<<display->dp); // Turn on decimal point Segment
+		} else {
+			WRITE_GPIO_CLR(1UL<<display->dp); // Turn on decimal point Segment
+		}
+	} else {
+		if (display->refresh.sevenSegType == 1) {
+			WRITE_GPIO_CLR(1UL<<display->dp); // Turn off decimal point Segment
+		} else {
+			WRITE_GPIO_SET(1UL<<display->dp); // Turn off decimal point Segment
+		}
+	}
+}
+
+/*
+ * Function: displaySegments
+ * --------------------
+ * Display a single value from binary sequence of 7 segments, leaving the decimal point as it is
+ * Function used internally by the direct GPIO backend
+ *
+ * display: the display to act on
+ * binaryValue: binary representation in 7-segment format wishing to be displayed
+ *
+ * Return: no return
+ */
+void displaySegments(SevenSegmentDisplay *display, int binaryValue) {
+	int segmentCount = 7;
+	for(int i = 0; i < segmentCount; i++) {
+		int bit = (binaryValue >> i) & 1;
+		if ((bit == 1 && display->refresh.sevenSegType == 1) || (bit == 0 && display->refresh.sevenSegType == 0)) {
+			WRITE_GPIO_SET(1UL<<display->segments[i]); // Turn on Segment
+		} else {
+			WRITE_GPIO_CLR(1UL<<display->segments[i]); // Turn on Segment
+		}
+	}
+}
+
+const SevenSegmentBackend sevenSegmentGPIOBackend = {
+	gpioBackendInit,
+	gpioBackendWriteDigit,
+	gpioBackendWriteFrame
+};
+
+
+/************************************************************************************************
+ * 																								*
+ *									74HC595 Backend												*
+ * 		Data, clock and latch lines shared by a chain of two shift registers					*
+ * 		The digit select byte is shifted first so it ends up in the second register			*
+ * 																								*
+ ************************************************************************************************/
+
+// Shifts out one bit, most significant bit first, data is sampled on the rising clock edge
+#define SHIFT_OUT_BIT(value, bit) \
+	if ((value) & (1 << (bit))) { \
+		WRITE_GPIO_SET(dataMask); \
+	} else { \
+		WRITE_GPIO_CLR(dataMask); \
+	} \
+	WRITE_GPIO_SET(clockMask); \
+	WRITE_GPIO_CLR(clockMask);
+
+/*
+ * Function: shiftRegisterWrite
+ * --------------------
+ * Shifts the digit select and segment bytes into the chain and latches them onto the outputs
+ * The bit loop is unrolled so each bit costs a handful of register writes
+ * Function called internally by the 74HC595 backend
+ *
+ * display: the display to act on
+ * digitByte: digit select outputs, bit n drives digit place n
+ * segmentByte: segment outputs, segments A..G in bits 0..6, decimal point in bit 7
+ *
+ * Return: no return
+ */
+void shiftRegisterWrite(SevenSegmentDisplay *display, int digitByte, int segmentByte) {
+	uint32_t dataMask = (1UL<<display->serialDataPin);
+	uint32_t clockMask = (1UL<<display->serialClockPin);
+
+	SHIFT_OUT_BIT(digitByte, 7)
+	SHIFT_OUT_BIT(digitByte, 6)
+	SHIFT_OUT_BIT(digitByte, 5)
+	SHIFT_OUT_BIT(digitByte, 4)
+	SHIFT_OUT_BIT(digitByte, 3)
+	SHIFT_OUT_BIT(digitByte, 2)
+	SHIFT_OUT_BIT(digitByte, 1)
+	SHIFT_OUT_BIT(digitByte, 0)
+
+	SHIFT_OUT_BIT(segmentByte, 7)
+	SHIFT_OUT_BIT(segmentByte, 6)
+	SHIFT_OUT_BIT(segmentByte, 5)
+	SHIFT_OUT_BIT(segmentByte, 4)
+	SHIFT_OUT_BIT(segmentByte, 3)
+	SHIFT_OUT_BIT(segmentByte, 2)
+	SHIFT_OUT_BIT(segmentByte, 1)
+	SHIFT_OUT_BIT(segmentByte, 0)
+
+	// Latch both registers at once so the digit and its segments change together
+	WRITE_GPIO_SET(1UL<<display->serialLatchPin);
+	WRITE_GPIO_CLR(1UL<<display->serialLatchPin);
+}
+
+/*
+ * Function: shiftRegisterWord
+ * --------------------
+ * Applies the display type to the digit selects and segments of a register pair
+ * Common cathode: segments are on when high, digits are on when low
+ * Common anode: segments are on when low, digits are on when high
+ * Function called internally by the 74HC595 and SPI chain backends
+ *
+ * display: the display to act on
+ * digitMask: digit places to turn on
+ * segmentBits: segments A..G in bits 0..6, decimal point in bit 7
+ *
+ * Return: digit select byte in bits 8..15, segment byte in bits 0..7
+ */
+int shiftRegisterWord(SevenSegmentDisplay *display, int digitMask, int segmentBits) {
+	if (display->refresh.sevenSegType == 1) {
+		return ((~digitMask & 0xFF) << 8) | (segmentBits & 0xFF);
+	}
+	return ((digitMask & 0xFF) << 8) | (~segmentBits & 0xFF);
+}
+
+/*
+ * Function: shiftRegisterOutput
+ * --------------------
+ * Shifts out the digit selects and segments with the levels for the display type
+ * Function called internally by the 74HC595 backend
+ *
+ * display: the display to act on
+ * digitMask: digit places to turn on
+ * segmentBits: segments A..G in bits 0..6, decimal point in bit 7
+ *
+ * Return: no return
+ */
+void shiftRegisterOutput(SevenSegmentDisplay *display, int digitMask, int segmentBits) {
+	int word = shiftRegisterWord(display, digitMask, segmentBits);
+	shiftRegisterWrite(display, word >> 8, word & 0xFF);
+}
+
+/*
+ * Function: shiftRegisterBackendInit
+ * --------------------
+ * Sets the data, clock and latch GPIOs as outputs and blanks the display
+ * Function called internally through the backend
+ *
+ * display: the display to act on
+ *
+ * Return: no return
+ */
+void shiftRegisterBackendInit(SevenSegmentDisplay *display) {
+	SYSCON->SYSAHBCLKCTRL0 |= (SYSCON_SYSAHBCLKCTRL0_GPIO0_MASK); // GPIO is on
+	uint32_t pins = (1UL<<display->serialDataPin) | (1UL<<display->serialClockPin) | (1UL<<display->serialLatchPin);
+	WRITE_GPIO_CLR(pins);
+	WRITE_GPIO_DIRSET(pins);
+	shiftRegisterOutput(display, 0, 0);
+}
+
+/*
+ * Function: shiftRegisterBackendWriteDigit
+ * --------------------
+ * Shows one digit place, the other digit selects are turned off in the same latch
+ * Function called internally through the backend
+ *
+ * display: the display to act on
+ * digitPlace: digit (0..3) to show
+ * segmentBits: segments A..G in bits 0..6, decimal point in bit 7
+ * lit: false leaves every digit off
+ *
+ * Return: no return
+ */
+void shiftRegisterBackendWriteDigit(SevenSegmentDisplay *display, int digitPlace, int segmentBits, bool lit) {
+	if (lit) {
+		shiftRegisterOutput(display, 1 << digitPlace, segmentBits);
+	} else {
+		shiftRegisterOutput(display, 0, segmentBits);
+	}
+}
+
+/*
+ * Function: shiftRegisterBackendWriteFrame
+ * --------------------
+ * Turns every digit select on with the same segments
+ * Function called internally through the backend
+ *
+ * display: the display to act on
+ * segmentBits: segments A..G in bits 0..6, decimal point in bit 7
+ *
+ * Return: no return
+ */
+void shiftRegisterBackendWriteFrame(SevenSegmentDisplay *display, int segmentBits) {
+	shiftRegisterOutput(display, 0x0F, segmentBits);
+}
+
+const SevenSegmentBackend sevenSegmentShiftRegisterBackend = {
+	shiftRegisterBackendInit,
+	shiftRegisterBackendWriteDigit,
+	shiftRegisterBackendWriteFrame
+};
+
+
+/************************************************************************************************
+ * 																								*
+ *									TM1637 Backend												*
+ * 		Two wire bus, both lines are open drain: a line is driven low by making it an output	*
+ * 		and released high (through the module's pull ups) by making it an input					*
+ * 		The chip keeps the digits lit by itself so only digits that change are written		*
+ * 																								*
+ ************************************************************************************************/
+
+/*
+ * Function: tm1637Delay
+ * --------------------
+ * Holds a bus level long enough for the TM1637
+ * Function called internally by the TM1637 backend
+ *
+ *
+ * Return: no return
+ */
+void tm1637Delay() {
+	for (volatile int i = 0; i < TM1637_DELAY_LOOPS; i++) {
+	}
+}
+
+// Sends one bit, least significant bit first, data must be stable while the clock is high
+#define TM1637_BIT(value, bit) \
+	WRITE_GPIO_DIRSET(clockMask); \
+	if ((value) & (1 << (bit))) { \
+		WRITE_GPIO_DIRCLR(dataMask); \
+	} else { \
+		WRITE_GPIO_DIRSET(dataMask); \
+	} \
+	tm1637Delay(); \
+	WRITE_GPIO_DIRCLR(clockMask); \
+	tm1637Delay();
+
+/*
+ * Function: tm1637WriteByte
+ * --------------------
+ * Sends a byte and clocks past the acknowledge bit
+ * The acknowledge is not checked, a missing chip just shows nothing
+ * The bit loop is unrolled so each bit costs a handful of register writes
+ * Function called internally by the TM1637 backend
+ *
+ * display: the display to act on
+ * value: byte to send
+ *
+ * Return: no return
+ */
+void tm1637WriteByte(SevenSegmentDisplay *display, int value) {
+	uint32_t dataMask = (1UL<<display->serialDataPin);
+	uint32_t clockMask = (1UL<<display->serialClockPin);
+
+	TM1637_BIT(value, 0)
+	TM1637_BIT(value, 1)
+	TM1637_BIT(value, 2)
+	TM1637_BIT(value, 3)
+	TM1637_BIT(value, 4)
+	TM1637_BIT(value, 5)
+	TM1637_BIT(value, 6)
+	TM1637_BIT(value, 7)
+
+	// Acknowledge clock with the data line released
+	WRITE_GPIO_DIRSET(clockMask);
+	WRITE_GPIO_DIRCLR(dataMask);
+	tm1637Delay();
+	WRITE_GPIO_DIRCLR(clockMask);
+	tm1637Delay();
+	WRITE_GPIO_DIRSET(clockMask);
+}
+
+/*
+ * Function: tm1637Start
+ * --------------------
+ * Start condition: data falls while the clock is high
+ * Function called internally by the TM1637 backend
+ *
+ * display: the display to act on
+ *
+ * Return: no return
+ */
+void tm1637Start(SevenSegmentDisplay *display) {
+	WRITE_GPIO_DIRCLR(1UL<<display->serialClockPin);
+	WRITE_GPIO_DIRCLR(1UL<<display->serialDataPin);
+	tm1637Delay();
+	WRITE_GPIO_DIRSET(1UL<<display->serialDataPin);
+	tm1637Delay();
+}
+
+/*
+ * Function: tm1637Stop
+ * --------------------
+ * Stop condition: data rises while the clock is high
+ * Function called internally by the TM1637 backend
+ *
+ * display: the display to act on
+ *
+ * Return: no return
+ */
+void tm1637Stop(SevenSegmentDisplay *display) {
+	WRITE_GPIO_DIRSET(1UL<<display->serialClockPin);
+	WRITE_GPIO_DIRSET(1UL<<display->serialDataPin);
+	tm1637Delay();
+	WRITE_GPIO_DIRCLR(1UL<<display->serialClockPin);
+	tm1637Delay();
+	WRITE_GPIO_DIRCLR(1UL<<display->serialDataPin);
+	tm1637Delay();
+}
+
+/*
+ * Function: tm1637WriteAddress
+ * --------------------
+ * Writes the segments of one digit place unless the chip already shows them
+ * TM1637 address 0 is the left most digit while digit place 0 is the right most
+ * Function called internally by the TM1637 backend
+ *
+ * display: the display to act on
+ * digitPlace: digit (0..3) to write
+ * segmentBits: segments A..G in bits 0..6, decimal point in bit 7
+ *
+ * Return: no return
+ */
+void tm1637WriteAddress(SevenSegmentDisplay *display, int digitPlace, int segmentBits) {
+	if (display->shownSegments[digitPlace] != segmentBits) {
+		display->shownSegments[digitPlace] = segmentBits;
+		tm1637Start(display);
+		tm1637WriteByte(display, TM1637_CMD_ADDRESS | (3 - digitPlace));
+		tm1637WriteByte(display, segmentBits);
+		tm1637Stop(display);
+	}
+}
+
+/*
+ * Function: tm1637BackendInit
+ * --------------------
+ * Releases both bus lines, selects fixed address mode, blanks and turns on the display
+ * Function called internally through the backend
+ *
+ * display: the display to act on
+ *
+ * Return: no return
+ */
+void tm1637BackendInit(SevenSegmentDisplay *display) {
+	SYSCON->SYSAHBCLKCTRL0 |= (SYSCON_SYSAHBCLKCTRL0_GPIO0_MASK); // GPIO is on
+	uint32_t pins = (1UL<<display->serialDataPin) | (1UL<<display->serialClockPin);
+	// Outputs only ever drive low, a high level comes from releasing the line
+	WRITE_GPIO_DIRCLR(pins);
+	WRITE_GPIO_CLR(pins);
+
+	tm1637Start(display);
+	tm1637WriteByte(display, TM1637_CMD_FIXED_ADDRESS);
+	tm1637Stop(display);
+
+	for (int i = 0; i < 4; i++) {
+		display->shownSegments[i] = -1;
+		tm1637WriteAddress(display, i, 0);
+	}
+
+	tm1637Start(display);
+	tm1637WriteByte(display, TM1637_CMD_DISPLAY_ON | TM1637_MAX_PULSE_WIDTH);
+	tm1637Stop(display);
+}
+
+/*
+ * Function: tm1637BackendWriteDigit
+ * --------------------
+ * Updates one digit place, the chip keeps the other digits lit
+ * Function called internally through the backend
+ *
+ * display: the display to act on
+ * digitPlace: digit (0..3) to show
+ * segmentBits: segments A..G in bits 0..6, decimal point in bit 7
+ * lit: false blanks the digit
+ *
+ * Return: no return
+ */
+void tm1637BackendWriteDigit(SevenSegmentDisplay *display, int digitPlace, int segmentBits, bool lit) {
+	if (lit) {
+		tm1637WriteAddress(display, digitPlace, segmentBits & 0xFF);
+	} else {
+		tm1637WriteAddress(display, digitPlace, 0);
+	}
+}
+
+/*
+ * Function: tm1637BackendWriteFrame
+ * --------------------
+ * Writes the same segments to every digit place
+ * Function called internally through the backend
+ *
+ * display: the display to act on
+ * segmentBits: segments A..G in bits 0..6, decimal point in bit 7
+ *
+ * Return: no return
+ */
+void tm1637BackendWriteFrame(SevenSegmentDisplay *display, int segmentBits) {
+	for (int i = 0; i < 4; i++) {
+		tm1637WriteAddress(display, i, segmentBits & 0xFF);
+	}
+}
+
+const SevenSegmentBackend sevenSegmentTM1637Backend = {
+	tm1637BackendInit,
+	tm1637BackendWriteDigit,
+	tm1637BackendWriteFrame
+};
+
+
+/************************************************************************************************
+ * 																								*
+ *									Charlieplex Backend											*
+ * 		Every line can be a segment line or a common line, lines not in use are tri-stated	*
+ * 		The direction and data masks of each digit place are built once per change of its	*
+ * 		segments, the refresh interrupt only replays them										*
+ * 																								*
+ ************************************************************************************************/
+
+/*
+ * Function: charlieplexSegmentLine
+ * --------------------
+ * Finds the line a segment of a digit place is wired to, skipping the common line of the digit
+ * tools/charlieplex_check.py uses the same wiring
+ * Function called internally by the charlieplex backend
+ *
+ * digitPlace: digit (0..3)
+ * segment: segment (0..6 for A..G, 7 for DP)
+ *
+ * Return: index into charlieLines
+ */
+int charlieplexSegmentLine(int digitPlace, int segment) {
+	if (segment < digitPlace) {
+		return segment;
+	}
+	return segment + 1;
+}
+
+/*
+ * Function: charlieplexBuildStep
+ * --------------------
+ * Builds the direction and data masks that show segments on a digit place
+ * Common cathode drives the common line low and the segment lines high, common anode the reverse
+ * Function called internally by the charlieplex backend
+ *
+ * display: the display to act on
+ * digitPlace: digit (0..3)
+ * segmentBits: segments A..G in bits 0..6, decimal point in bit 7
+ *
+ * Return: no return
+ */
+void charlieplexBuildStep(SevenSegmentDisplay *display, int digitPlace, int segmentBits) {
+	uint32_t commonMask = (1UL<<display->charlieLines[digitPlace]);
+	uint32_t segmentMask = 0;
+	// The decimal point needs the ninth line
+	int segmentCount = display->charlieLineCount - 1;
+	for (int i = 0; i < segmentCount; i++) {
+		if (segmentBits & (1 << i)) {
+			segmentMask = segmentMask | (1UL<<display->charlieLines[charlieplexSegmentLine(digitPlace, i)]);
+		}
+	}
+
+	if (segmentMask == 0) {
+		// Nothing to light, leave every line tri-stated
+		display->charlieDirMask[digitPlace] = 0;
+	} else {
+		display->charlieDirMask[digitPlace] = commonMask | segmentMask;
+	}
+	if (display->refresh.sevenSegType == 1) {
+		display->charlieHighMask[digitPlace] = segmentMask;
+	} else {
+		display->charlieHighMask[digitPlace] = commonMask;
+	}
+	display->shownSegments[digitPlace] = segmentBits;
+}
+
+/*
+ * Function: charlieplexBackendInit
+ * --------------------
+ * Tri-states every line and clears the schedule
+ * Function called internally through the backend
+ *
+ * display: the display to act on
+ *
+ * Return: no return
+ */
+void charlieplexBackendInit(SevenSegmentDisplay *display) {
+	SYSCON->SYSAHBCLKCTRL0 |= (SYSCON_SYSAHBCLKCTRL0_GPIO0_MASK); // GPIO is on
+	display->charlieLineMask = 0;
+	for (int i = 0; i < display->charlieLineCount; i++) {
+		display->charlieLineMask = display->charlieLineMask | (1UL<<display->charlieLines[i]);
+	}
+	WRITE_GPIO_DIRCLR(display->charlieLineMask);
+	WRITE_GPIO_CLR(display->charlieLineMask);
+	for (int i = 0; i < 4; i++) {
+		charlieplexBuildStep(display, i, 0);
+	}
+}
+
+/*
+ * Function: charlieplexBackendWriteDigit
+ * --------------------
+ * Replays the masks of a digit place, rebuilding them first only if its segments changed
+ * Every line is tri-stated before the data changes so no other digit glows during the switch
+ * Function called internally through the backend
+ *
+ * display: the display to act on
+ * digitPlace: digit (0..3) to show
+ * segmentBits: segments A..G in bits 0..6, decimal point in bit 7
+ * lit: false leaves every line tri-stated
+ *
+ * Return: no return
+ */
+void charlieplexBackendWriteDigit(SevenSegmentDisplay *display, int digitPlace, int segmentBits, bool lit) {
+	if (display->shownSegments[digitPlace] != segmentBits) {
+		charlieplexBuildStep(display, digitPlace, segmentBits);
+	}
+	WRITE_GPIO_DIRCLR(display->charlieLineMask);
+	WRITE_GPIO_CLR(display->charlieLineMask);
+	WRITE_GPIO_SET(display->charlieHighMask[digitPlace]);
+	if (lit) {
+		WRITE_GPIO_DIRSET(display->charlieDirMask[digitPlace]);
+	}
+}
+
+/*
+ * Function: charlieplexBackendWriteFrame
+ * --------------------
+ * A charlieplexed display can only light one digit at a time, shows the right most digit
+ * Function called internally through the backend
+ *
+ * display: the display to act on
+ * segmentBits: segments A..G in bits 0..6, decimal point in bit 7
+ *
+ * Return: no return
+ */
+void charlieplexBackendWriteFrame(SevenSegmentDisplay *display, int segmentBits) {
+	charlieplexBackendWriteDigit(display, 0, segmentBits, true);
+}
+
+const SevenSegmentBackend sevenSegmentCharlieplexBackend = {
+	charlieplexBackendInit,
+	charlieplexBackendWriteDigit,
+	charlieplexBackendWriteFrame
+};
+
+
+/************************************************************************************************
+ * 																								*
+ *									Virtual Backend												*
+ * 		Writes no pins, keeps the segments each digit place shows so they can be inspected	*
+ * 		or rendered, for example on a host build or mirrored over a UART					*
+ * 																								*
+ ************************************************************************************************/
+
+/*
+ * Function: virtualBackendInit
+ * --------------------
+ * Blanks every digit place
+ * Function called internally through the backend
+ *
+ * display: the display to act on
+ *
+ * Return: no return
+ */
+void virtualBackendInit(SevenSegmentDisplay *display) {
+	for (int i = 0; i < 4; i++) {
+		display->shownSegments[i] = 0;
+	}
+}
+
+/*
+ * Function: virtualBackendWriteDigit
+ * --------------------
+ * Records the segments of one digit place, the other places keep what they last showed
+ * Unlit frames are recorded as blank
+ * Function called internally through the backend
+ *
+ * display: the display to act on
+ * digitPlace: digit (0..3) to show
+ * segmentBits: segments A..G in bits 0..6, decimal point in bit 7
+ * lit: false records the digit as blank
+ *
+ * Return: no return
+ */
+void virtualBackendWriteDigit(SevenSegmentDisplay *display, int digitPlace, int segmentBits, bool lit) {
+	if (lit) {
+		display->shownSegments[digitPlace] = segmentBits;
+	} else {
+		display->shownSegments[digitPlace] = 0;
+	}
+}
+
+/*
+ * Function: virtualBackendWriteFrame
+ * --------------------
+ * Records the same segments on every digit place
+ * Function called internally through the backend
+ *
+ * display: the display to act on
+ * segmentBits: segments A..G in bits 0..6, decimal point in bit 7
+ *
+ * Return: no return
+ */
+void virtualBackendWriteFrame(SevenSegmentDisplay *display, int segmentBits) {
+	for (int i = 0; i < 4; i++) {
+		display->shownSegments[i] = segmentBits;
+	}
+}
+
+const SevenSegmentBackend sevenSegmentVirtualBackend = {
+	virtualBackendInit,
+	virtualBackendWriteDigit,
+	virtualBackendWriteFrame
+};
+
+/*
+ * Function: renderSevenSegmentAscii
+ * --------------------
+ * Draws the segments recorded by the virtual backend as 3 lines of ASCII art
+ * Each digit is 3 characters wide followed by its decimal point, the left most digit comes first
+ *
+ *  _   _       _
+ * |_|  _|  |  |_
+ * |_|.|_   |   _|
+ *
+ * display: a display using sevenSegmentVirtualBackend
+ * text: buffer of at least SEVEN_SEGMENT_ASCII_SIZE characters, filled with a terminated string
+ *
+ * Return: no return
+ */
+void renderSevenSegmentAscii(SevenSegmentDisplay *display, char text[]) {
+	int position = 0;
+	for (int row = 0; row < 3; row++) {
+		for (int digit = 3; digit >= 0; digit--) {
+			int bits = display->shownSegments[digit];
+			if (bits < 0) {
+				bits = 0;
+			}
+			if (row == 0) {
+				text[position++] = ' ';
+				text[position++] = (bits & (1 << 0)) ? '_' : ' ';	// A
+				text[position++] = ' ';
+				text[position++] = ' ';
+			} else if (row == 1) {
+				text[position++] = (bits & (1 << 5)) ? '|' : ' ';	// F
+				text[position++] = (bits & (1 << 6)) ? '_' : ' ';	// G
+				text[position++] = (bits & (1 << 1)) ? '|' : ' ';	// B
+				text[position++] = ' ';
+			} else {
+				text[position++] = (bits & (1 << 4)) ? '|' : ' ';	// E
+				text[position++] = (bits & (1 << 3)) ? '_' : ' ';	// D
+				text[position++] = (bits & (1 << 2)) ? '|' : ' ';	// C
+				text[position++] = (bits & SEGMENT_DP_BIT) ? '.' : ' ';
+			}
+		}
+		text[position++] = '\n';
+	}
+	text[position] = '\0';
+}
+
+
+/************************************************************************************************
+ * 																								*
+ *									SPI Chain Backend											*
+ * 		SPI0 shifts the words out so the refresh interrupt only prepares them				*
+ * 		SCK drives the shift clocks, MOSI the data and SSEL0 the latches (RCLK or LOAD/CS)	*
+ * 		SSEL0 rises once after the last word, latching every display in the chain together	*
+ * 																								*
+ ************************************************************************************************/
+
+/*
+ * Function: spiChainSendWord
+ * --------------------
+ * Hands the word of one chain position to the SPI, ending the transfer after position 0
+ * Function called internally by the SPI chain backend
+ *
+ * position: chain position of the word
+ *
+ * Return: no return
+ */
+void spiChainSendWord(int position) {
+	uint32_t control = SPI_TXDATCTL_LEN(15) | SPI_TXDATCTL_RXIGNORE_MASK;
+	if (position == 0) {
+		control = control | SPI_TXDATCTL_EOT_MASK;
+	}
+	sevenSegmentSPI->TXDATCTL = control | SPI_TXDATCTL_TXDAT(spiChainFrame[position]);
+}
+
+/*
+ * Function: spiChainStart
+ * --------------------
+ * Starts sending the frame, the SPI interrupt queues the words after the first
+ * A frame is skipped while the previous one is still queued, the next frame carries the latest words
+ * Function called internally by the SPI chain backend
+ *
+ *
+ * Return: no return
+ */
+void spiChainStart() {
+	if (spiChainNext > 0 || !(sevenSegmentSPI->STAT & SPI_STAT_TXRDY_MASK)) {
+		return;
+	}
+	spiChainNext = spiChainLength - 1;
+	spiChainSendWord(spiChainNext);
+	if (spiChainNext > 0) {
+		sevenSegmentSPI->INTENSET = SPI_INTENSET_TXRDYEN_MASK;
+	}
+}
+
+/*
+ * Function: spiChainWait
+ * --------------------
+ * Waits for the frame being sent to be latched
+ * Only used outside of the refresh interrupt, the SPI interrupt must be able to run
+ * Function called internally by the SPI chain backend
+ *
+ *
+ * Return: no return
+ */
+void spiChainWait() {
+	while (spiChainNext > 0 || !(sevenSegmentSPI->STAT & SPI_STAT_MSTIDLE_MASK)) {
+	}
+}
+
+/*
+ * Function: spiChainSendAll
+ * --------------------
+ * Sends the same word to every display in the chain and waits for it to be latched
+ * Function called internally by the SPI chain backend
+ *
+ * word: word for every position
+ *
+ * Return: no return
+ */
+void spiChainSendAll(int word) {
+	spiChainWait();
+	for (int i = 0; i < spiChainLength; i++) {
+		spiChainFrame[i] = word;
+	}
+	spiChainStart();
+	spiChainWait();
+}
+
+/*
+ * Function: max7219Word
+ * --------------------
+ * Builds the MAX7219 digit register write for a digit place
+ * The MAX7219 keeps DP in bit 7 and segments A..G in bits 6..0
+ * Function called internally by the SPI chain backend
+ *
+ * digitPlace: digit (0..3), written to digit register digitPlace + 1
+ * segmentBits: segments A..G in bits 0..6, decimal point in bit 7
+ *
+ * Return: register address in bits 8..15, data in bits 0..7
+ */
+int max7219Word(int digitPlace, int segmentBits) {
+	int data = segmentBits & SEGMENT_DP_BIT;
+	for (int i = 0; i < 7; i++) {
+		if (segmentBits & (1 << i)) {
+			data = data | (1 << (6 - i));
+		}
+	}
+	return ((MAX7219_REG_DIGIT0 + digitPlace) << 8) | data;
+}
+
+/*
+ * Function: spiBackendInit
+ * --------------------
+ * Blanks the word of the display, the SPI itself is set up by setupSevenSegmentSPIChain
+ * Function called internally through the backend
+ *
+ * display: the display to act on
+ *
+ * Return: no return
+ */
+void spiBackendInit(SevenSegmentDisplay *display) {
+	if (spiChainType == SPI_CHAIN_MAX7219) {
+		spiChainFrame[display->chainPosition] = (MAX7219_REG_NOOP << 8);
+	} else {
+		spiChainFrame[display->chainPosition] = shiftRegisterWord(display, 0, 0);
+	}
+}
+
+/*
+ * Function: spiBackendWriteDigit
+ * --------------------
+ * Stores the word of the display, the display at position 0 is refreshed last and sends the frame
+ * Function called internally through the backend
+ *
+ * display: the display to act on
+ * digitPlace: digit (0..3) to show
+ * segmentBits: segments A..G in bits 0..6, decimal point in bit 7
+ * lit: false leaves every digit off
+ *
+ * Return: no return
+ */
+void spiBackendWriteDigit(SevenSegmentDisplay *display, int digitPlace, int segmentBits, bool lit) {
+	if (!lit) {
+		segmentBits = 0;
+	}
+	if (spiChainType == SPI_CHAIN_MAX7219) {
+		spiChainFrame[display->chainPosition] = max7219Word(digitPlace, segmentBits);
+	} else if (lit) {
+		spiChainFrame[display->chainPosition] = shiftRegisterWord(display, 1 << digitPlace, segmentBits);
+	} else {
+		spiChainFrame[display->chainPosition] = shiftRegisterWord(display, 0, 0);
+	}
+	if (display->chainPosition == 0) {
+		spiChainStart();
+	}
+}
+
+/*
+ * Function: spiBackendWriteFrame
+ * --------------------
+ * Shows the same pattern on every digit of the display and waits for it to be latched
+ * The other displays in the chain are sent their last words again
+ * Function called internally through the backend
+ *
+ * display: the display to act on
+ * segmentBits: segments A..G in bits 0..6, decimal point in bit 7
+ *
+ * Return: no return
+ */
+void spiBackendWriteFrame(SevenSegmentDisplay *display, int segmentBits) {
+	if (spiChainType == SPI_CHAIN_MAX7219) {
+		// The MAX7219 holds each digit so the digit registers are written one frame at a time
+		for (int i = 0; i < 4; i++) {
+			spiChainWait();
+			spiChainFrame[display->chainPosition] = max7219Word(i, segmentBits);
+			spiChainStart();
+		}
+	} else {
+		spiChainWait();
+		spiChainFrame[display->chainPosition] = shiftRegisterWord(display, 0x0F, segmentBits);
+		spiChainStart();
+	}
+	spiChainWait();
+}
+
+const SevenSegmentBackend sevenSegmentSPIBackend = {
+	spiBackendInit,
+	spiBackendWriteDigit,
+	spiBackendWriteFrame
+};
+
+/*
+ * Function: setupSevenSegmentSPIChain
+ * --------------------
+ * Drives a chain of displays through SPI0, all refreshed from one clock
+ * Each interrupt prepares one word per display and starts SPI0, the words are shifted out
+ * by the SPI interrupt while the CPU gets on with other work
+ * Must be called before the display/setup functions of the displays, which then leave the refresh
+ * clock alone and only start their own counter or transition clocks
+ * Calling displaySPIChainInterrupt will refresh the displays, sevenSegmentSPIInterrupt must be
+ * called in the SPI0 interrupt
+ *
+ * displays: displays in chain order, displays[0] is wired nearest the LPC802
+ * displayCount: number of displays, at most MAX_SPI_CHAIN_DISPLAYS
+ * chainType: SPI_CHAIN_74HC595 (register pairs as for setupSevenSegmentShiftRegister) or SPI_CHAIN_MAX7219
+ * sckPin: GPIO Pin for SCK, wired to SRCLK/CLK
+ * mosiPin: GPIO Pin for MOSI, wired to SER/DIN of the far end of the chain from displays[0]
+ * sselPin: GPIO Pin for SSEL0, wired to RCLK/LOAD
+ * spiDivider: SPI clock is the FRO divided by spiDivider (1 .. 65536)
+ * refreshClock: from the list: "SysTick", "WKT", "MRT0", "MRT1", "CTIMER0"
+ * refreshRate: speed of cycling through digits
+ * NOTE: refreshClock cannot be used as a counter or transition clock by any of the displays
+ *
+ * Return: no return
+ */
+void setupSevenSegmentSPIChain(SevenSegmentDisplay *displays[], int displayCount, int chainType, int sckPin, int mosiPin,
+		int sselPin, int spiDivider, char refreshClock[], int refreshRate) {
+	int clock = getClockIndex(refreshClock);
+	// Claimed before any display is changed, a refused clock leaves the displays refreshing as they were
+	if (displayCount < 1 || displayCount > MAX_SPI_CHAIN_DISPLAYS
+			|| (clock >= 0 && !claimClock(displays[0], clock, SEVEN_SEGMENT_TIMER_REFRESH))) {
+		return;
+	}
+
+	// Route SPI0 to the pins through the switch matrix
+	SYSCON->SYSAHBCLKCTRL0 |= (SYSCON_SYSAHBCLKCTRL0_SWM_MASK);
+	SWM0->PINASSIGN.PINASSIGN3 = (SWM0->PINASSIGN.PINASSIGN3 & ~SWM_PINASSIGN3_SPI0_SCK_IO_MASK)
+			| SWM_PINASSIGN3_SPI0_SCK_IO(sckPin);
+	SWM0->PINASSIGN.PINASSIGN4 = (SWM0->PINASSIGN.PINASSIGN4
+			& ~(SWM_PINASSIGN4_SPI0_MOSI_IO_MASK | SWM_PINASSIGN4_SPI0_SSEL0_IO_MASK))
+			| SWM_PINASSIGN4_SPI0_MOSI_IO(mosiPin) | SWM_PINASSIGN4_SPI0_SSEL0_IO(sselPin);
+	SYSCON->SYSAHBCLKCTRL0 &= ~(SYSCON_SYSAHBCLKCTRL0_SWM_MASK);
+
+	NVIC_DisableIRQ(SPI0_IRQn);
+	SYSCON->SYSAHBCLKCTRL0 |= (SYSCON_SYSAHBCLKCTRL0_SPI0_MASK);
+	SYSCON->FCLKSEL[SPI0_FCLKSEL_INDEX] = SPI0_FCLKSEL_FRO;
+	SYSCON->PRESETCTRL0 &= ~(SYSCON_PRESETCTRL0_SPI0_RST_N_MASK);
+	SYSCON->PRESETCTRL0 |= (SYSCON_PRESETCTRL0_SPI0_RST_N_MASK);
+	// Mode 0, most significant bit first, SSEL0 active low
+	sevenSegmentSPI->DIV = SPI_DIV_DIVVAL(spiDivider - 1);
+	sevenSegmentSPI->DLY = 0;
+	sevenSegmentSPI->CFG = SPI_CFG_ENABLE_MASK | SPI_CFG_MASTER_MASK;
+	// The SPI interrupt streams the refresh frames, it has to keep up like a refresh interrupt
+	NVIC_SetPriority(SPI0_IRQn, sevenSegmentRefreshPriority);
+	NVIC_EnableIRQ(SPI0_IRQn);
+
+	spiChainType = chainType;
+	spiChainLength = displayCount;
+	spiChainNext = 0;
+	spiChainClock = clock;
+	spiChainRate = refreshRate;
+	for (int i = 0; i < displayCount; i++) {
+		spiChainDisplays[i] = displays[i];
+		displays[i]->chainPosition = i;
+		displays[i]->refresh.backend = &sevenSegmentSPIBackend;
+		displays[i]->sharedRefresh = true;
+		displays[i]->refresh.currentClock = spiChainClock;
+		displays[i]->refresh.cycleRate = refreshRate;
+		displays[i]->refresh.currentDigit = 0;
+		setupSevenSegment(displays[i]);
+	}
+
+	if (chainType == SPI_CHAIN_MAX7219) {
+		spiChainSendAll((MAX7219_REG_DISPLAY_TEST << 8) | 0);
+		spiChainSendAll((MAX7219_REG_DECODE_MODE << 8) | 0);
+		spiChainSendAll((MAX7219_REG_SCAN_LIMIT << 8) | 3);
+		spiChainSendAll((MAX7219_REG_INTENSITY << 8) | MAX7219_MAX_INTENSITY);
+		for (int i = 0; i < 4; i++) {
+			spiChainSendAll(max7219Word(i, 0));
+		}
+		spiChainSendAll((MAX7219_REG_SHUTDOWN << 8) | 1);
+	} else {
+		spiChainStart();
+	}
+
+	// The displays stop refreshing themselves, their own refresh clocks are freed
+	for (int i = 0; i < displayCount; i++) {
+		releaseDisplayClocks(displays[i], 1 << SEVEN_SEGMENT_TIMER_REFRESH, -1);
+	}
+	startClock(displays[0], spiChainClock, SEVEN_SEGMENT_TIMER_REFRESH, spiChainRate);
+	SET_IRQ_HANDLER(spiChainClock, spiChainRefreshIRQHandler, displays[0]);
+}
+
+/*
+ * Function: displaySPIChainInterrupt
+ * --------------------
+ * Prepares the next digit of every display in the chain and starts sending them
+ * Should be called in the interrupt from the timer associated with the refreshRate
+ * Used when setupSevenSegmentSPIChain is used
+ *
+ *
+ * Return: no return
+ */
+void displaySPIChainInterrupt() {
+	STATS_START(STATS_REFRESH);
+	// Position 0 goes last as its word starts the transfer
+	for (int i = spiChainLength - 1; i >= 0; i--) {
+		refreshDigit(spiChainDisplays[i]);
+	}
+
+	restartClock(spiChainClock, spiChainRate);
+	STATS_END(STATS_REFRESH);
+}
+
+/*
+ * Function: sevenSegmentSPIInterrupt
+ * --------------------
+ * Queues the next word of the frame each time SPI0 can take one
+ * Should be called in the SPI0 interrupt
+ * Used when setupSevenSegmentSPIChain is used
+ *
+ *
+ * Return: no return
+ */
+void sevenSegmentSPIInterrupt() {
+	STATS_START(STATS_SPI);
+	if (spiChainNext > 0 && (sevenSegmentSPI->STAT & SPI_STAT_TXRDY_MASK)) {
+		spiChainNext = spiChainNext - 1;
+		spiChainSendWord(spiChainNext);
+	}
+	if (spiChainNext == 0) {
+		sevenSegmentSPI->INTENCLR = SPI_INTENCLR_TXRDYEN_MASK;
+	}
+	STATS_END(STATS_SPI);
+}
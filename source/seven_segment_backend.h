@@ -0,0 +1,169 @@
+/****************************************************************
+ * 																*
+ *					Seven Segment Output Backends				*
+ * 		Turn segment patterns into pin activity for the		*
+ * 		different ways a display can be wired to the LPC802		*
+ * 																*
+ ****************************************************************/
+
+#ifndef SEVEN_SEGMENT_BACKEND_H_
+#define SEVEN_SEGMENT_BACKEND_H_
+
+#include "LPC802.h"
+#include "stdbool.h"
+#include "seven_segment.h"
+
+// Segment patterns passed to a backend use bits 0..6 for segments A..G and bit 7 for the decimal point
+#define SEGMENT_DP_BIT				(1 << 7)
+
+// Busy loop passes between TM1637 clock edges, keeps the bus below its maximum clock rate
+#define TM1637_DELAY_LOOPS			(4)
+
+// TM1637 commands
+#define TM1637_CMD_FIXED_ADDRESS	(0x44)
+#define TM1637_CMD_ADDRESS			(0xC0)
+#define TM1637_CMD_DISPLAY_ON		(0x88)
+#define TM1637_MAX_PULSE_WIDTH		(7)
+
+// Characters written by renderSevenSegmentAscii: 3 rows of 4 digits, 4 characters each, a newline per row and the terminator
+#define SEVEN_SEGMENT_ASCII_SIZE	(3 * (4 * 4 + 1) + 1)
+
+// Longest chain of displays driven by the SPI chain backend
+#define MAX_SPI_CHAIN_DISPLAYS		(8)
+
+// Devices on an SPI chain
+#define SPI_CHAIN_74HC595			(0)
+#define SPI_CHAIN_MAX7219			(1)
+
+// MAX7219 registers
+#define MAX7219_REG_NOOP			(0x00)
+#define MAX7219_REG_DIGIT0			(0x01)
+#define MAX7219_REG_DECODE_MODE		(0x09)
+#define MAX7219_REG_INTENSITY		(0x0A)
+#define MAX7219_REG_SCAN_LIMIT		(0x0B)
+#define MAX7219_REG_SHUTDOWN		(0x0C)
+#define MAX7219_REG_DISPLAY_TEST	(0x0F)
+#define MAX7219_MAX_INTENSITY		(0x0F)
+
+/*
+ * Struct: SevenSegmentBackend
+ * --------------------
+ * The output operations every backend provides, the modes only ever call these
+ * Digit places follow channels[] of digitGPIOSetup: place 0 is the right most digit
+ *
+ * init: claims and sets up the pins of the display, leaving every digit off
+ * writeDigit: shows one digit place, multiplexed backends turn the other digits off
+ *             lit is false for frames skipped by the brightness control
+ * writeFrame: shows the same pattern on every digit at once
+ */
+typedef struct SevenSegmentBackend {
+	void (*init)(SevenSegmentDisplay *display);
+	void (*writeDigit)(SevenSegmentDisplay *display, int digitPlace, int segmentBits, bool lit);
+	void (*writeFrame)(SevenSegmentDisplay *display, int segmentBits);
+} SevenSegmentBackend;
+
+// Digit and segment lines wired straight to the GPIOs (digitGPIOSetup, sevenSegmentGPIOSetup)
+extern const SevenSegmentBackend sevenSegmentGPIOBackend;
+
+// Two chained 74HC595s: the first holds segments A..G and DP on QA..QH,
+// the second holds the digit selects on QA..QD
+extern const SevenSegmentBackend sevenSegmentShiftRegisterBackend;
+
+// TM1637 driver chip, it multiplexes the digits itself
+extern const SevenSegmentBackend sevenSegmentTM1637Backend;
+
+// Charlieplexed display, set up with setupSevenSegmentCharlieplex
+extern const SevenSegmentBackend sevenSegmentCharlieplexBackend;
+
+// Writes no pins, records the segments of each digit place for renderSevenSegmentAscii
+extern const SevenSegmentBackend sevenSegmentVirtualBackend;
+
+// Displays on SPI0, set up with setupSevenSegmentSPIChain
+extern const SevenSegmentBackend sevenSegmentSPIBackend;
+
+// SPI register block used by the SPI chain backend, SPI0 unless a host build points it at a mock
+extern SPI_Type *sevenSegmentSPI;
+
+
+/************************************************************************************************
+ * 																								*
+ *									Virtual Display Functions									*
+ * 																								*
+ ************************************************************************************************/
+
+/*
+ * Function: renderSevenSegmentAscii
+ * --------------------
+ * Draws the segments recorded by the virtual backend as 3 lines of ASCII art
+ * Each digit is 3 characters wide followed by its decimal point, the left most digit comes first
+ *
+ *  _   _       _
+ * |_|  _|  |  |_
+ * |_|.|_   |   _|
+ *
+ * display: a display using sevenSegmentVirtualBackend
+ * text: buffer of at least SEVEN_SEGMENT_ASCII_SIZE characters, filled with a terminated string
+ *
+ * Return: no return
+ */
+void renderSevenSegmentAscii(SevenSegmentDisplay *display, char text[]);
+
+
+/************************************************************************************************
+ * 																								*
+ *									SPI Chain Functions											*
+ * 																								*
+ ************************************************************************************************/
+
+/*
+ * Function: setupSevenSegmentSPIChain
+ * --------------------
+ * Drives a chain of displays through SPI0, all refreshed from one clock
+ * Each interrupt prepares one word per display and starts SPI0, the words are shifted out
+ * by the SPI interrupt while the CPU gets on with other work
+ * Must be called before the display/setup functions of the displays, which then leave the refresh
+ * clock alone and only start their own counter or transition clocks
+ * Calling displaySPIChainInterrupt will refresh the displays, sevenSegmentSPIInterrupt must be
+ * called in the SPI0 interrupt
+ *
+ * displays: displays in chain order, displays[0] is wired nearest the LPC802
+ * displayCount: number of displays, at most MAX_SPI_CHAIN_DISPLAYS
+ * chainType: SPI_CHAIN_74HC595 (register pairs as for setupSevenSegmentShiftRegister) or SPI_CHAIN_MAX7219
+ * sckPin: GPIO Pin for SCK, wired to SRCLK/CLK
+ * mosiPin: GPIO Pin for MOSI, wired to SER/DIN of the far end of the chain from displays[0]
+ * sselPin: GPIO Pin for SSEL0, wired to RCLK/LOAD
+ * spiDivider: SPI clock is the FRO divided by spiDivider (1 .. 65536)
+ * refreshClock: from the list: "SysTick", "WKT", "MRT0", "MRT1", "CTIMER0"
+ * refreshRate: speed of cycling through digits
+ * NOTE: refreshClock cannot be used as a counter or transition clock by any of the displays
+ *
+ * Return: no return
+ */
+void setupSevenSegmentSPIChain(SevenSegmentDisplay *displays[], int displayCount, int chainType, int sckPin, int mosiPin,
+		int sselPin, int spiDivider, char refreshClock[], int refreshRate);
+
+/*
+ * Function: displaySPIChainInterrupt
+ * --------------------
+ * Prepares the next digit of every display in the chain and starts sending them
+ * Should be called in the interrupt from the timer associated with the refreshRate
+ * Used when setupSevenSegmentSPIChain is used
+ *
+ *
+ * Return: no return
+ */
+void displaySPIChainInterrupt();
+
+/*
+ * Function: sevenSegmentSPIInterrupt
+ * --------------------
+ * Queues the next word of the frame each time SPI0 can take one
+ * Should be called in the SPI0 interrupt
+ * Used when setupSevenSegmentSPIChain is used
+ *
+ *
+ * Return: no return
+ */
+void sevenSegmentSPIInterrupt();
+
+#endif /* SEVEN_SEGMENT_BACKEND_H_ */
@@ -0,0 +1,109 @@
+/****************************************************************
+ * 																*
+ *					Seven Segment Configuration					*
+ * 		Picks the modes and clocks built into the library		*
+ * 		Each option can be set here or with a -D compiler flag	*
+ * 																*
+ ****************************************************************/
+
+#ifndef SEVEN_SEGMENT_CONFIG_H_
+#define SEVEN_SEGMENT_CONFIG_H_
+
+/*
+ * Modes
+ * --------------------
+ * 1 builds the mode in, 0 leaves out its functions and its state in SevenSegmentDisplay
+ * Displaying characters and numbers (display4Characters, displaySingleCharacter ...) is always built in
+ * The sequencer and scripts only offer the jobs and statements of the modes that are built in
+ */
+#ifndef SEVEN_SEGMENT_USE_COUNTER
+#define SEVEN_SEGMENT_USE_COUNTER		(1)
+#endif
+
+#ifndef SEVEN_SEGMENT_USE_CAROUSEL
+#define SEVEN_SEGMENT_USE_CAROUSEL		(1)
+#endif
+
+#ifndef SEVEN_SEGMENT_USE_SLIDER
+#define SEVEN_SEGMENT_USE_SLIDER		(1)
+#endif
+
+#ifndef SEVEN_SEGMENT_USE_SEQUENCER
+#define SEVEN_SEGMENT_USE_SEQUENCER		(1)
+#endif
+
+// The script player of seven_segment_script.c
+#ifndef SEVEN_SEGMENT_USE_SCRIPT
+#define SEVEN_SEGMENT_USE_SCRIPT		(1)
+#endif
+
+/*
+ * Clocks
+ * --------------------
+ * 1 builds in the configuration of the clock, 0 leaves it out
+ * A clock that is left out is not recognized by name, functions given it set up no clock
+ */
+#ifndef SEVEN_SEGMENT_USE_SYSTICK
+#define SEVEN_SEGMENT_USE_SYSTICK		(1)
+#endif
+
+#ifndef SEVEN_SEGMENT_USE_WKT
+#define SEVEN_SEGMENT_USE_WKT			(1)
+#endif
+
+// Covers both "MRT0" and "MRT1"
+#ifndef SEVEN_SEGMENT_USE_MRT
+#define SEVEN_SEGMENT_USE_MRT			(1)
+#endif
+
+#ifndef SEVEN_SEGMENT_USE_CTIMER0
+#define SEVEN_SEGMENT_USE_CTIMER0		(1)
+#endif
+
+/*
+ * Adaptive refresh
+ * --------------------
+ * 1 builds in setSevenSegmentAdaptiveRefresh, which lowers the refresh rate while the screen is static
+ * and raises it while a counter, carousel, slider, sequencer or script is changing it
+ * 0 leaves out the check the counter and transition interrupts make after each step
+ */
+#ifndef SEVEN_SEGMENT_USE_ADAPTIVE_REFRESH
+#define SEVEN_SEGMENT_USE_ADAPTIVE_REFRESH	(1)
+#endif
+
+/*
+ * Interrupt handlers
+ * --------------------
+ * Defining SEVEN_SEGMENT_IRQ_HANDLERS (and adding seven_segment_irq.c) has the library provide the
+ * SysTick, WKT, MRT0, CTIMER0 and SPI0 interrupt handlers, see seven_segment_irq.h
+ * Left undefined, the application writes the handlers and calls the interrupt helpers itself
+ */
+// #define SEVEN_SEGMENT_IRQ_HANDLERS
+
+/*
+ * Ambient light auto-dimming
+ * --------------------
+ * Defining SEVEN_SEGMENT_AUTO_DIM (and adding seven_segment_light.c) lets a display sample a light
+ * sensor on an ADC channel from its refresh interrupt and set its brightness from it, see
+ * seven_segment_light.h
+ */
+// #define SEVEN_SEGMENT_AUTO_DIM
+
+/*
+ * Interrupt priorities
+ * --------------------
+ * NVIC priorities of the interrupts the library sets up, 0 is the most urgent and the Cortex-M0+ has 0..3
+ * The refresh interrupt is more urgent than the counter and transition interrupts, so a slow content
+ * update never delays multiplexing and shows up as flicker
+ * 0 is left for the application's critical interrupts, which then preempt the display
+ * Can also be changed at run time with setSevenSegmentInterruptPriorities
+ */
+#ifndef SEVEN_SEGMENT_REFRESH_PRIORITY
+#define SEVEN_SEGMENT_REFRESH_PRIORITY		(1)
+#endif
+
+#ifndef SEVEN_SEGMENT_TRANSITION_PRIORITY
+#define SEVEN_SEGMENT_TRANSITION_PRIORITY	(2)
+#endif
+
+#endif /* SEVEN_SEGMENT_CONFIG_H_ */
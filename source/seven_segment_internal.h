@@ -0,0 +1,214 @@
+/****************************************************************
+ * 																*
+ *					Seven Segment API Internals					*
+ * 			  Shared between the seven segment modules			*
+ * 			  Not intended to be used by applications			*
+ * 																*
+ ****************************************************************/
+
+#ifndef SEVEN_SEGMENT_INTERNAL_H_
+#define SEVEN_SEGMENT_INTERNAL_H_
+
+#include "seven_segment.h"
+
+/************************************************************************************************
+ * 																								*
+ * 										Output Helpers											*
+ * 																								*
+ ************************************************************************************************/
+
+// Segments A..G in bits 0..6 for a character, 0 if it cannot be shown
+int getSegmentPattern(char inputChar);
+
+// Shows the next digit without re-arming the refresh clock
+void refreshDigit(SevenSegmentDisplay *display);
+
+// Runs the backend init of the display
+void setupSevenSegment(SevenSegmentDisplay *display);
+
+/************************************************************************************************
+ * 																								*
+ * 									Direct GPIO Backend Helpers									*
+ * 																								*
+ ************************************************************************************************/
+
+void clearDigits(SevenSegmentDisplay *display);
+void enableDigits(SevenSegmentDisplay *display);
+void enableDigit(SevenSegmentDisplay *display, int digitPlace);
+// Writes the 7 segments without touching the decimal point
+void displaySegments(SevenSegmentDisplay *display, int binaryValue);
+// Turns the decimal point segment on or off
+void displayDPState(SevenSegmentDisplay *display, bool dpOn);
+
+/************************************************************************************************
+ * 																								*
+ * 										Clock Helpers											*
+ * 																								*
+ ************************************************************************************************/
+
+// MRT channels used for "MRT0" and "MRT1"
+#define MRT_CHAN0					(0)
+#define MRT_CHAN1					(1)
+
+// Converts "SysTick", "WKT", "MRT0", "MRT1", "CTIMER0" into 0..4, -1 if not recognized
+int getClockIndex(char clockType[]);
+
+// Claims the clock for the display in the role and sets it up with the rate, false if it was refused
+bool startClock(SevenSegmentDisplay *display, int clock, int role, int rate);
+
+// Display and role owning a clock, display is NULL for the application
+typedef struct {
+	uint8_t role;
+	SevenSegmentDisplay *display;
+} SevenSegmentTimerOwner;
+
+// Owner of each clock, indexed by the internal clock index
+extern SevenSegmentTimerOwner sevenSegmentTimers[5];
+
+// Records the owner of a clock, false if it belongs to another display or the application
+bool claimClock(SevenSegmentDisplay *display, int clock, int role);
+
+// Stops and frees the clocks the display owns in the roles of roleMask (bit n for role n), except keepClock
+void releaseDisplayClocks(SevenSegmentDisplay *display, int roleMask, int keepClock);
+
+// Stops a clock without touching the rest of its peripheral
+void stopClock(int clock);
+
+// Powers and resets the peripheral of the clock the first time only
+void initTimerPeripheral(int clock);
+
+// NVIC priorities of the refresh and of the counter/transition interrupts
+extern int sevenSegmentRefreshPriority;
+extern int sevenSegmentTransitionPriority;
+
+// Gives the NVIC line of the clock the refresh or transition priority, depending on the role it is owned in
+void setClockPriority(int clock);
+
+// Records and starts the refresh clock unless the display is refreshed by displayMultipleInterrupt
+void startRefreshClock(SevenSegmentDisplay *display, char refreshClock[], int refreshRate);
+
+// Re-arms the WKT or CTIMER0 at the end of an interrupt helper
+void restartClock(int clock, int rate);
+
+// Changes the reload of a running clock, taking effect from its next interval
+void setClockPeriod(int clock, int period);
+
+// Frequency a clock counts at, from the current SystemCoreClock for all but the WKT
+int getClockInputHz(int clock);
+// Largest reload the clock's counter takes
+uint32_t getClockMaxReload(int clock);
+// Reload giving a period in microseconds on the clock, -1 if the clock cannot count it
+int periodToReload(int clock, uint32_t periodUs);
+// Gives a clock the display owns a new reload, in the rate of the role it is owned in
+void applyClockReload(SevenSegmentDisplay *display, int clock, int reload);
+// Changes the period of the running counter or transition clock, false if it cannot count it
+bool setContentPeriod(SevenSegmentDisplay *display, uint32_t periodUs);
+
+// Stops the interrupt of a clock from being taken, the timer keeps counting, returns whether it was enabled
+bool holdClockInterrupt(int clock);
+// Lets the interrupt of a clock be taken again if it was enabled before holdClockInterrupt
+void resumeClockInterrupt(int clock, bool wasEnabled);
+
+// Counter or transition clock running the mode of the display, -1 if none or not owned by the display
+int getContentClock(SevenSegmentDisplay *display);
+// Hold and resume the interrupts of the display around a content swap
+int beginContentSwap(SevenSegmentDisplay *display);
+void finishContentSwap(SevenSegmentDisplay *display, int held);
+// Hands the content clock and its period to newMode, SEVEN_SEGMENT_CONTENT_...
+void moveContentClock(SevenSegmentDisplay *display, int newMode);
+
+#if SEVEN_SEGMENT_USE_ADAPTIVE_REFRESH
+// The 4 characters on the screen in one word, compared before and after a step
+uint32_t getScreenWord(SevenSegmentDisplay *display);
+// Switches the refresh clock between the static and active rates if the screen changing state flipped
+void adaptRefreshRate(SevenSegmentDisplay *display, uint32_t shownBefore);
+// Works out the adaptive reloads from their periods for the refresh clock, false if it cannot count one
+bool loadAdaptiveRates(SevenSegmentDisplay *display, int clock);
+
+// Placed around the step of the counter and transition interrupts
+#define ADAPTIVE_REFRESH_START(display)		uint32_t adaptiveShown = getScreenWord(display)
+#define ADAPTIVE_REFRESH_END(display)		adaptRefreshRate(display, adaptiveShown)
+#else
+#define ADAPTIVE_REFRESH_START(display)
+#define ADAPTIVE_REFRESH_END(display)
+#endif
+
+// Masks interrupts around a short read-modify-write of a shared SYSCON register, restoring the
+// caller's PRIMASK afterwards so interrupts the caller had masked stay masked
+uint32_t enterSevenSegmentCritical();
+void exitSevenSegmentCritical(uint32_t primask);
+
+// Nominal frequency of the low power oscillator clocking the WKT, the WKT rates count this clock
+#define WKT_CLOCK_HZ				(1000000)
+
+// WKT count per nominal count in 16.16 fixed point, set by the WKT calibration
+#define WKT_SCALE_ONE				(1 << 16)
+extern uint32_t sevenSegmentWKTScale;
+
+// Count to write to the WKT for a rate in nominal WKT_CLOCK_HZ ticks
+uint32_t getWKTCount(int rate);
+
+// Displays on the SPI chain, 0 when it is not set up
+extern int spiChainLength;
+
+// True when the WKT is running and no other clock or the SPI is in use, so deep-sleep stops nothing
+bool canSevenSegmentDeepSleep();
+
+#if SEVEN_SEGMENT_USE_CAROUSEL || SEVEN_SEGMENT_USE_SLIDER
+// Period of a carousel or slider frame in the units of the transition clock
+int getTransitionDwell(SevenSegmentDisplay *display, int frame, int frameCount);
+// Same for a given clock and rate, before they are recorded in the display
+int easeTransitionDwell(SevenSegmentDisplay *display, int clock, int rate, int frame, int frameCount);
+// Re-arms the transition clock with the dwell time of the frame after the given one
+void restartTransitionClock(SevenSegmentDisplay *display, int frame, int frameCount);
+#endif
+#if SEVEN_SEGMENT_USE_CAROUSEL
+// Screens of one pass of the carousel
+int getCarouselFrameCount(SevenSegmentDisplay *display);
+#endif
+
+/************************************************************************************************
+ * 																								*
+ * 									Content Loading Helpers										*
+ * 				Load content and mode state without touching any of the clocks					*
+ * 																								*
+ ************************************************************************************************/
+
+void setScreen(SevenSegmentDisplay *display, char screen[]);
+void setScreenNumber(SevenSegmentDisplay *display, int number);
+// Writes a number (0000 .. 9999) as 4 characters stored like chrSequence
+void formatScreenNumber(char target[], int number);
+// Shown by refreshDigit from the next frame on, unless a setScreen comes first
+void queueScreen(SevenSegmentDisplay *display, char screen[]);
+void queueScreenNumber(SevenSegmentDisplay *display, int number);
+#if SEVEN_SEGMENT_USE_COUNTER
+void loadCounter(SevenSegmentDisplay *display, int clockStart, char newCountDirection[], int newCountIncrement, int newStopValue,
+		bool enableStopValue);
+#endif
+#if SEVEN_SEGMENT_USE_CAROUSEL
+void loadCarouselSequence(SevenSegmentDisplay *display, char characterSequence[], int sequenceLength, bool newEnableContinousCycle,
+		bool newEnablePadding);
+#endif
+#if SEVEN_SEGMENT_USE_SLIDER
+void loadSliderSequence(SevenSegmentDisplay *display, char characterSequence[], int sequenceLength, bool newEnableContinousCycle,
+		bool newEnablePadding, bool ignoreSingleSpaces);
+#endif
+
+/************************************************************************************************
+ * 																								*
+ * 										Mode Step Helpers										*
+ * 			Advance a mode by one transition without re-arming the transition clock			*
+ * 																								*
+ ************************************************************************************************/
+
+#if SEVEN_SEGMENT_USE_COUNTER
+void stepCounter(SevenSegmentDisplay *display);
+#endif
+#if SEVEN_SEGMENT_USE_CAROUSEL
+void stepCarousel(SevenSegmentDisplay *display);
+#endif
+#if SEVEN_SEGMENT_USE_SLIDER
+void stepSlider(SevenSegmentDisplay *display);
+#endif
+
+#endif /* SEVEN_SEGMENT_INTERNAL_H_ */
@@ -0,0 +1,163 @@
+/****************************************************************
+ * 																*
+ *				Seven Segment Interrupt Handlers				*
+ * 		Timer interrupt handlers provided by the library		*
+ * 		that call the interrupt helper of the mode using		*
+ * 		each timer, so the application needs no routing			*
+ * 		Only built when SEVEN_SEGMENT_IRQ_HANDLERS is defined	*
+ * 																*
+ ****************************************************************/
+
+#include "seven_segment_irq.h"
+
+#ifdef SEVEN_SEGMENT_IRQ_HANDLERS
+
+#include "seven_segment_backend.h"
+#include "seven_segment_internal.h"
+#include "stddef.h"
+
+// Route of each clock, indexed by the internal clock index
+// 0 == SysTick, 1 == WKT, 2 == MRT0, 3 = MRT1, 4 = CTIMER0
+SevenSegmentIRQRoute sevenSegmentIRQRoutes[5];
+
+
+/*
+ * Function: setSevenSegmentIRQHook
+ * --------------------
+ * Has the interrupt handler of a timer call an application function after the library helper
+ * Also works for a timer the library does not use, the handler then only clears the interrupt
+ * flag and calls the hook
+ *
+ * clock: from the list "SysTick", "WKT", "MRT0", "MRT1", "CTIMER0"
+ * hook: function to call, NULL to remove the hook
+ *
+ * Return: no return
+ */
+void setSevenSegmentIRQHook(char clock[], void (*hook)(void)) {
+	int index = getClockIndex(clock);
+	if (index >= 0) {
+		sevenSegmentIRQRoutes[index].hook = hook;
+	}
+}
+
+/*
+ * Function: setSevenSegmentIRQHandler
+ * --------------------
+ * Records the interrupt helper the handler of a clock calls, replacing the previous one
+ * Function called internally by SET_IRQ_HANDLER
+ *
+ * clock: internal clock index (0..4), -1 is ignored
+ * handler: interrupt helper of the mode using the clock
+ * display: display handed to handler
+ *
+ * Return: no return
+ */
+void setSevenSegmentIRQHandler(int clock, SevenSegmentIRQHandler handler, SevenSegmentDisplay *display) {
+	if (clock >= 0 && clock < 5) {
+		// Both written with the interrupts off, so the handler never sees a new handler with the old display
+		uint32_t primask = enterSevenSegmentCritical();
+		sevenSegmentIRQRoutes[clock].display = display;
+		sevenSegmentIRQRoutes[clock].handler = handler;
+		exitSevenSegmentCritical(primask);
+	}
+}
+
+/*
+ * Function: multipleRefreshIRQHandler
+ * --------------------
+ * Calls displayMultipleInterrupt, the display is not used
+ * Function called internally by the interrupt handler of the shared refresh clock
+ *
+ * display: not used
+ *
+ * Return: no return
+ */
+void multipleRefreshIRQHandler(SevenSegmentDisplay *display) {
+	(void)display;
+	displayMultipleInterrupt();
+}
+
+/*
+ * Function: spiChainRefreshIRQHandler
+ * --------------------
+ * Calls displaySPIChainInterrupt, the display is not used
+ * Function called internally by the interrupt handler of the SPI chain refresh clock
+ *
+ * display: not used
+ *
+ * Return: no return
+ */
+void spiChainRefreshIRQHandler(SevenSegmentDisplay *display) {
+	(void)display;
+	displaySPIChainInterrupt();
+}
+
+/*
+ * Function: runIRQRoute
+ * --------------------
+ * Calls the library helper and then the application hook of a clock
+ * Function called internally by the interrupt handlers
+ *
+ * route: route of the clock that interrupted
+ *
+ * Return: no return
+ */
+void runIRQRoute(SevenSegmentIRQRoute *route) {
+	SevenSegmentIRQHandler handler = route->handler;
+	if (handler != NULL) {
+		handler(route->display);
+	}
+	if (route->hook != NULL) {
+		route->hook();
+	}
+}
+
+
+/************************************************************************************************
+ * 																								*
+ *										Interrupt Handlers										*
+ * 		Strong, so they replace the weak defaults of the startup code							*
+ * 																								*
+ ************************************************************************************************/
+
+#if SEVEN_SEGMENT_USE_SYSTICK
+void SysTick_Handler(void) {
+	runIRQRoute(&sevenSegmentIRQRoutes[0]);
+}
+#endif
+
+#if SEVEN_SEGMENT_USE_WKT
+void WKT_IRQHandler(void) {
+	WKT->CTRL |= WKT_CTRL_ALARMFLAG_MASK;
+	runIRQRoute(&sevenSegmentIRQRoutes[1]);
+}
+#endif
+
+#if SEVEN_SEGMENT_USE_MRT
+// Both channels share the interrupt, each channel that fired is handled in the same call
+void MRT0_IRQHandler(void) {
+	uint32_t flags = MRT0->IRQ_FLAG;
+	if (flags & (1 << MRT_CHAN0)) {
+		MRT0->CHANNEL[MRT_CHAN0].STAT = MRT_CHANNEL_STAT_INTFLAG_MASK;
+		runIRQRoute(&sevenSegmentIRQRoutes[2]);
+	}
+	if (flags & (1 << MRT_CHAN1)) {
+		MRT0->CHANNEL[MRT_CHAN1].STAT = MRT_CHANNEL_STAT_INTFLAG_MASK;
+		runIRQRoute(&sevenSegmentIRQRoutes[3]);
+	}
+}
+#endif
+
+#if SEVEN_SEGMENT_USE_CTIMER0
+void CTIMER0_IRQHandler(void) {
+	CTIMER0->IR = CTIMER_IR_MR0INT_MASK;
+	runIRQRoute(&sevenSegmentIRQRoutes[4]);
+}
+#endif
+
+// Only enabled by setupSevenSegmentSPIChain
+void SPI0_IRQHandler(void) {
+	sevenSegmentSPIInterrupt();
+}
+
+#endif /* SEVEN_SEGMENT_IRQ_HANDLERS */
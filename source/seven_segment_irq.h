@@ -0,0 +1,112 @@
+/****************************************************************
+ * 																*
+ *				Seven Segment Interrupt Handlers				*
+ * 		Timer interrupt handlers provided by the library		*
+ * 		that call the interrupt helper of the mode using		*
+ * 		each timer, so the application needs no routing			*
+ * 		Only built when SEVEN_SEGMENT_IRQ_HANDLERS is defined	*
+ * 																*
+ ****************************************************************/
+
+#ifndef SEVEN_SEGMENT_IRQ_H_
+#define SEVEN_SEGMENT_IRQ_H_
+
+#include "LPC802.h"
+#include "stdbool.h"
+#include "stdint.h"
+#include "seven_segment.h"
+
+#ifdef SEVEN_SEGMENT_IRQ_HANDLERS
+
+// Interrupt helper called by a timer interrupt handler, given the display the timer was started for
+typedef void (*SevenSegmentIRQHandler)(SevenSegmentDisplay *display);
+
+/*
+ * Struct: SevenSegmentIRQRoute
+ * --------------------
+ * What one timer interrupt does
+ *
+ * handler: library interrupt helper of the mode using the timer, NULL if none
+ * display: display handed to handler
+ * hook: application function called after handler, NULL if none
+ */
+typedef struct {
+	SevenSegmentIRQHandler handler;
+	SevenSegmentDisplay *display;
+	void (*hook)(void);
+} SevenSegmentIRQRoute;
+
+// Called by the setup functions as they start a clock, records the helper the clock's interrupt calls
+#define SET_IRQ_HANDLER(clock, handler, display)	setSevenSegmentIRQHandler(clock, handler, display)
+
+/*
+ * Function: setSevenSegmentIRQHook
+ * --------------------
+ * Has the interrupt handler of a timer call an application function after the library helper
+ * Also works for a timer the library does not use, the handler then only clears the interrupt
+ * flag and calls the hook
+ *
+ * clock: from the list "SysTick", "WKT", "MRT0", "MRT1", "CTIMER0"
+ * hook: function to call, NULL to remove the hook
+ *
+ * Return: no return
+ */
+void setSevenSegmentIRQHook(char clock[], void (*hook)(void));
+
+/*
+ * Function: setSevenSegmentIRQHandler
+ * --------------------
+ * Records the interrupt helper the handler of a clock calls, replacing the previous one
+ * Function called internally by SET_IRQ_HANDLER
+ *
+ * clock: internal clock index (0..4), -1 is ignored
+ * handler: interrupt helper of the mode using the clock
+ * display: display handed to handler
+ *
+ * Return: no return
+ */
+void setSevenSegmentIRQHandler(int clock, SevenSegmentIRQHandler handler, SevenSegmentDisplay *display);
+
+/*
+ * Function: multipleRefreshIRQHandler
+ * --------------------
+ * Calls displayMultipleInterrupt, the display is not used
+ * Function called internally by the interrupt handler of the shared refresh clock
+ *
+ * display: not used
+ *
+ * Return: no return
+ */
+void multipleRefreshIRQHandler(SevenSegmentDisplay *display);
+
+/*
+ * Function: spiChainRefreshIRQHandler
+ * --------------------
+ * Calls displaySPIChainInterrupt, the display is not used
+ * Function called internally by the interrupt handler of the SPI chain refresh clock
+ *
+ * display: not used
+ *
+ * Return: no return
+ */
+void spiChainRefreshIRQHandler(SevenSegmentDisplay *display);
+
+/*
+ * Function: runIRQRoute
+ * --------------------
+ * Calls the library helper and then the application hook of a clock
+ * Function called internally by the interrupt handlers
+ *
+ * route: route of the clock that interrupted
+ *
+ * Return: no return
+ */
+void runIRQRoute(SevenSegmentIRQRoute *route);
+
+#else
+
+#define SET_IRQ_HANDLER(clock, handler, display)
+
+#endif /* SEVEN_SEGMENT_IRQ_HANDLERS */
+
+#endif /* SEVEN_SEGMENT_IRQ_H_ */
@@ -0,0 +1,235 @@
+/****************************************************************
+ * 																*
+ *				Seven Segment Ambient Light Dimming				*
+ * 		Samples a light sensor on an ADC channel from the		*
+ * 		refresh interrupt of a display and sets its				*
+ * 		brightness from the filtered reading					*
+ * 		Only built when SEVEN_SEGMENT_AUTO_DIM is defined		*
+ * 																*
+ ****************************************************************/
+
+#include "seven_segment_light.h"
+
+#ifdef SEVEN_SEGMENT_AUTO_DIM
+
+#include "seven_segment_internal.h"
+
+ADC_Type *sevenSegmentADC = ADC0;
+// The ADC has been powered and reset by initAutoDimADC
+bool autoDimADCReady = false;
+
+
+/*
+ * Function: initAutoDimADC
+ * --------------------
+ * Powers, resets and clocks the ADC the first time only, then enables the pin of the channel
+ * Function called internally by setupSevenSegmentAutoDim
+ *
+ * channel: ADC channel the light sensor is on (0..11)
+ *
+ * Return: no return
+ */
+void initAutoDimADC(int channel) {
+	uint32_t primask = enterSevenSegmentCritical();
+	if (!autoDimADCReady) {
+		SYSCON->SYSAHBCLKCTRL0 |= (SYSCON_SYSAHBCLKCTRL0_ADC_MASK);
+		SYSCON->PDRUNCFG &= ~(SYSCON_PDRUNCFG_ADC_PD_MASK);
+		SYSCON->PRESETCTRL0 &= ~(SYSCON_PRESETCTRL0_ADC_RST_N_MASK);
+		SYSCON->PRESETCTRL0 |= (SYSCON_PRESETCTRL0_ADC_RST_N_MASK);
+		// ADC clocked by the FRO, well within the ADC's limit without a further divider
+		SYSCON->ADCCLKSEL = 0;
+		SYSCON->ADCCLKDIV = 1;
+		sevenSegmentADC->CTRL = ADC_CTRL_CLKDIV(0);
+		autoDimADCReady = true;
+	}
+
+	// ADC_0 .. ADC_11 are consecutive bits of PINENABLE0, clearing a bit gives the pin to the ADC
+	SYSCON->SYSAHBCLKCTRL0 |= (SYSCON_SYSAHBCLKCTRL0_SWM_MASK);
+	SWM0->PINENABLE0 &= ~(SWM_PINENABLE0_ADC_0_MASK << channel);
+	SYSCON->SYSAHBCLKCTRL0 &= ~(SYSCON_SYSAHBCLKCTRL0_SWM_MASK);
+	exitSevenSegmentCritical(primask);
+}
+
+/*
+ * Function: setupSevenSegmentAutoDimCtx
+ * --------------------
+ * Has the refresh interrupt of the display sample a light sensor and set the brightness from it
+ * No timer is used: every sampleFrames refresh frames the interrupt reads the result of the
+ * conversion it started the time before and starts the next one, it never waits for the ADC
+ * The readings go through an integer low-pass filter and are mapped linearly onto the brightness
+ * levels between minLevel at darkReading and MAX_BRIGHTNESS at brightReading
+ * Powers the ADC and switches the channel's pin to its analog function on the first call
+ * The brightness set by setSevenSegmentBrightness or a script is replaced on the next level change
+ * The ADC is not self-calibrated, which the light readings do not need
+ *
+ * display: the display to act on
+ * channel: ADC channel the light sensor is on (0..11)
+ * darkReading: ADC reading (0..4095) in the dark, may be above brightReading if the reading falls
+ *              as the light rises
+ * brightReading: ADC reading (0..4095) from which the display is at full brightness
+ * minLevel: brightness in the dark, between 0 and MAX_BRIGHTNESS
+ * sampleFrames: refresh frames between two samples, 15 samples 4 times a second at 60 frames per second
+ *
+ * Return: true if set up, false if an argument is out of range
+ */
+bool setupSevenSegmentAutoDimCtx(SevenSegmentDisplay *display, int channel, int darkReading, int brightReading,
+		int minLevel, int sampleFrames) {
+	if (channel < 0 || channel > 11 || darkReading < 0 || darkReading > 4095 || brightReading < 0
+			|| brightReading > 4095 || darkReading == brightReading || minLevel < 0 || minLevel > MAX_BRIGHTNESS
+			|| sampleFrames < 1 || sampleFrames > UINT16_MAX) {
+		return false;
+	}
+	SevenSegmentAutoDim *autoDim = &display->autoDim;
+	// Off while it is changed, so the refresh interrupt does not sample with half of the new settings
+	autoDim->sampleFrames = 0;
+	initAutoDimADC(channel);
+
+	autoDim->channel = channel;
+	autoDim->minLevel = minLevel;
+	autoDim->darkReading = darkReading;
+	// Worked out once here so the interrupt maps a reading with a multiply instead of a division
+	// brightReading lands at the end of the band of MAX_BRIGHTNESS, rounding the scale away from zero keeps
+	// it from falling short of that band
+	int32_t span = (MAX_BRIGHTNESS - minLevel + 1) << AUTO_DIM_LEVEL_SHIFT;
+	int32_t range = brightReading - darkReading;
+	if (range > 0) {
+		autoDim->levelScale = (span + range - 1) / range;
+	} else {
+		autoDim->levelScale = -((span - range - 1) / -range);
+	}
+	autoDim->primed = false;
+	autoDim->filtered = 0;
+	autoDim->samples = 0;
+	autoDim->frameCount = 0;
+	// The first sample reads the result of this conversion
+	sevenSegmentADC->SEQ_CTRL[0] = ADC_SEQ_CTRL_CHANNELS(1 << channel);
+	sevenSegmentADC->SEQ_CTRL[0] = ADC_SEQ_CTRL_CHANNELS(1 << channel) | ADC_SEQ_CTRL_SEQ_ENA_MASK
+			| ADC_SEQ_CTRL_START_MASK;
+	autoDim->sampleFrames = sampleFrames;
+	return true;
+}
+
+/*
+ * Function: stopSevenSegmentAutoDimCtx
+ * --------------------
+ * Stops sampling the light sensor, the display keeps the brightness it has
+ *
+ * display: the display to act on
+ *
+ * Return: no return
+ */
+void stopSevenSegmentAutoDimCtx(SevenSegmentDisplay *display) {
+	display->autoDim.sampleFrames = 0;
+}
+
+/*
+ * Function: getSevenSegmentLightReadingCtx
+ * --------------------
+ * Filtered reading of the light sensor, to pick darkReading and brightReading
+ *
+ * display: the display to act on
+ *
+ * Return: ADC reading (0..4095), -1 before the first sample
+ */
+int getSevenSegmentLightReadingCtx(SevenSegmentDisplay *display) {
+	if (!display->autoDim.primed) {
+		return -1;
+	}
+	return (display->autoDim.filtered + 8) >> 4;
+}
+
+/*
+ * Function: applyAutoDimReading
+ * --------------------
+ * Sets the brightness for a filtered reading, keeping the current level while the reading is
+ * within AUTO_DIM_HYSTERESIS of it
+ * Function called internally by sampleAutoDim
+ *
+ * display: the display to act on
+ * reading: filtered ADC reading (0..4095)
+ *
+ * Return: no return
+ */
+void applyAutoDimReading(SevenSegmentDisplay *display, int reading) {
+	SevenSegmentAutoDim *autoDim = &display->autoDim;
+	// Each level from minLevel to MAX_BRIGHTNESS gets an equal band of positions, in AUTO_DIM_LEVEL_SHIFT fixed point
+	int32_t span = (MAX_BRIGHTNESS - autoDim->minLevel + 1) << AUTO_DIM_LEVEL_SHIFT;
+	int32_t position = (reading - autoDim->darkReading) * autoDim->levelScale;
+	if (position < 0) {
+		position = 0;
+	} else if (position >= span) {
+		position = span - 1;
+	}
+
+	int32_t current = (display->refresh.brightnessLevel - autoDim->minLevel) << AUTO_DIM_LEVEL_SHIFT;
+	if (position >= current - AUTO_DIM_HYSTERESIS && position < current + (1 << AUTO_DIM_LEVEL_SHIFT) + AUTO_DIM_HYSTERESIS) {
+		return;
+	}
+	setSevenSegmentBrightnessCtx(display, autoDim->minLevel + (position >> AUTO_DIM_LEVEL_SHIFT));
+}
+
+/*
+ * Function: sampleAutoDim
+ * --------------------
+ * Every sampleFrames frames, filters the last conversion of the light sensor, updates the brightness
+ * and starts the next conversion
+ * Function called internally by the refresh interrupt at the end of each frame of the display
+ *
+ * display: the display to act on
+ *
+ * Return: no return
+ */
+void sampleAutoDim(SevenSegmentDisplay *display) {
+	SevenSegmentAutoDim *autoDim = &display->autoDim;
+	if (autoDim->sampleFrames == 0) {
+		return;
+	}
+	autoDim->frameCount = autoDim->frameCount + 1;
+	if (autoDim->frameCount < autoDim->sampleFrames) {
+		return;
+	}
+	autoDim->frameCount = 0;
+
+	// Reading the result clears DATAVALID, a conversion that has not finished is skipped rather than waited for
+	uint32_t result = sevenSegmentADC->DAT[autoDim->channel];
+	if (result & ADC_DAT_DATAVALID_MASK) {
+		int32_t sample = (int32_t)((result & ADC_DAT_RESULT_MASK) >> ADC_DAT_RESULT_SHIFT) << 4;
+		if (autoDim->primed) {
+			autoDim->filtered = autoDim->filtered + ((sample - autoDim->filtered) >> SEVEN_SEGMENT_AUTO_DIM_FILTER_SHIFT);
+		} else {
+			autoDim->filtered = sample;
+			autoDim->primed = true;
+		}
+		autoDim->samples = autoDim->samples + 1;
+		// Rounded, the filter stops up to 7/16 short of a rising reading and would never reach 4095
+		applyAutoDimReading(display, (autoDim->filtered + 8) >> 4);
+	}
+
+	// The channels are only changed with the sequence disabled, another display may sample a different channel
+	sevenSegmentADC->SEQ_CTRL[0] = ADC_SEQ_CTRL_CHANNELS(1 << autoDim->channel);
+	sevenSegmentADC->SEQ_CTRL[0] = ADC_SEQ_CTRL_CHANNELS(1 << autoDim->channel) | ADC_SEQ_CTRL_SEQ_ENA_MASK
+			| ADC_SEQ_CTRL_START_MASK;
+}
+
+
+/************************************************************************************************
+ * 																								*
+ *									Default Display Functions									*
+ * 		Each acts on defaultSevenSegmentDisplay, see the Ctx version of each function			*
+ * 																								*
+ ************************************************************************************************/
+
+bool setupSevenSegmentAutoDim(int channel, int darkReading, int brightReading, int minLevel, int sampleFrames) {
+	return setupSevenSegmentAutoDimCtx(&defaultSevenSegmentDisplay, channel, darkReading, brightReading, minLevel,
+			sampleFrames);
+}
+
+void stopSevenSegmentAutoDim() {
+	stopSevenSegmentAutoDimCtx(&defaultSevenSegmentDisplay);
+}
+
+int getSevenSegmentLightReading() {
+	return getSevenSegmentLightReadingCtx(&defaultSevenSegmentDisplay);
+}
+
+#endif /* SEVEN_SEGMENT_AUTO_DIM */
@@ -0,0 +1,139 @@
+/****************************************************************
+ * 																*
+ *				Seven Segment Ambient Light Dimming				*
+ * 		Samples a light sensor on an ADC channel from the		*
+ * 		refresh interrupt of a display and sets its				*
+ * 		brightness from the filtered reading					*
+ * 		Only built when SEVEN_SEGMENT_AUTO_DIM is defined		*
+ * 																*
+ ****************************************************************/
+
+#ifndef SEVEN_SEGMENT_LIGHT_H_
+#define SEVEN_SEGMENT_LIGHT_H_
+
+#include "LPC802.h"
+#include "stdbool.h"
+#include "stdint.h"
+#include "seven_segment.h"
+
+#ifdef SEVEN_SEGMENT_AUTO_DIM
+
+// Weight of a new sample in the low-pass filter is 1 / (1 << SEVEN_SEGMENT_AUTO_DIM_FILTER_SHIFT),
+// the reading settles to a step in the light after about 3 << SEVEN_SEGMENT_AUTO_DIM_FILTER_SHIFT samples
+#ifndef SEVEN_SEGMENT_AUTO_DIM_FILTER_SHIFT
+#define SEVEN_SEGMENT_AUTO_DIM_FILTER_SHIFT	(3)
+#endif
+
+// Fraction bits of SevenSegmentAutoDim.levelScale
+#define AUTO_DIM_LEVEL_SHIFT		(12)
+// The reading must move this far past the edge of the current brightness level, a quarter of a level,
+// before the level changes, so a reading on the edge does not make the display flicker between two levels
+#define AUTO_DIM_HYSTERESIS			(1 << (AUTO_DIM_LEVEL_SHIFT - 2))
+
+// ADC register block sampled by the auto-dimming, ADC0 unless a host build points it at a mock
+extern ADC_Type *sevenSegmentADC;
+
+/*
+ * Function: setupSevenSegmentAutoDim
+ * --------------------
+ * Has the refresh interrupt of the display sample a light sensor and set the brightness from it
+ * No timer is used: every sampleFrames refresh frames the interrupt reads the result of the
+ * conversion it started the time before and starts the next one, it never waits for the ADC
+ * The readings go through an integer low-pass filter and are mapped linearly onto the brightness
+ * levels between minLevel at darkReading and MAX_BRIGHTNESS at brightReading
+ * Powers the ADC and switches the channel's pin to its analog function on the first call
+ * The brightness set by setSevenSegmentBrightness or a script is replaced on the next level change
+ * The ADC is not self-calibrated, which the light readings do not need
+ *
+ * channel: ADC channel the light sensor is on (0..11)
+ * darkReading: ADC reading (0..4095) in the dark, may be above brightReading if the reading falls
+ *              as the light rises
+ * brightReading: ADC reading (0..4095) from which the display is at full brightness
+ * minLevel: brightness in the dark, between 0 and MAX_BRIGHTNESS
+ * sampleFrames: refresh frames between two samples, 15 samples 4 times a second at 60 frames per second
+ *
+ * Return: true if set up, false if an argument is out of range
+ */
+bool setupSevenSegmentAutoDim(int channel, int darkReading, int brightReading, int minLevel, int sampleFrames);
+
+/*
+ * Function: stopSevenSegmentAutoDim
+ * --------------------
+ * Stops sampling the light sensor, the display keeps the brightness it has
+ *
+ *
+ * Return: no return
+ */
+void stopSevenSegmentAutoDim();
+
+/*
+ * Function: getSevenSegmentLightReading
+ * --------------------
+ * Filtered reading of the light sensor, to pick darkReading and brightReading
+ *
+ *
+ * Return: ADC reading (0..4095), -1 before the first sample
+ */
+int getSevenSegmentLightReading();
+
+/*
+ * Function: initAutoDimADC
+ * --------------------
+ * Powers, resets and clocks the ADC the first time only, then enables the pin of the channel
+ * Function called internally by setupSevenSegmentAutoDim
+ *
+ * channel: ADC channel the light sensor is on (0..11)
+ *
+ * Return: no return
+ */
+void initAutoDimADC(int channel);
+
+/*
+ * Function: sampleAutoDim
+ * --------------------
+ * Every sampleFrames frames, filters the last conversion of the light sensor, updates the brightness
+ * and starts the next conversion
+ * Function called internally by the refresh interrupt at the end of each frame of the display
+ *
+ * display: the display to act on
+ *
+ * Return: no return
+ */
+void sampleAutoDim(SevenSegmentDisplay *display);
+
+/*
+ * Function: applyAutoDimReading
+ * --------------------
+ * Sets the brightness for a filtered reading, keeping the current level while the reading is
+ * within AUTO_DIM_HYSTERESIS of it
+ * Function called internally by sampleAutoDim
+ *
+ * display: the display to act on
+ * reading: filtered ADC reading (0..4095)
+ *
+ * Return: no return
+ */
+void applyAutoDimReading(SevenSegmentDisplay *display, int reading);
+
+
+/************************************************************************************************
+ * 																								*
+ *									Display Context Functions									*
+ * 																								*
+ ************************************************************************************************/
+
+/*
+ * Functions: ...Ctx
+ * --------------------
+ * Each function below behaves like the function of the same name above, acting on the given display
+ *
+ * display: the display to act on
+ */
+bool setupSevenSegmentAutoDimCtx(SevenSegmentDisplay *display, int channel, int darkReading, int brightReading,
+		int minLevel, int sampleFrames);
+void stopSevenSegmentAutoDimCtx(SevenSegmentDisplay *display);
+int getSevenSegmentLightReadingCtx(SevenSegmentDisplay *display);
+
+#endif /* SEVEN_SEGMENT_AUTO_DIM */
+
+#endif /* SEVEN_SEGMENT_LIGHT_H_ */
@@ -0,0 +1,442 @@
+/****************************************************************
+ * 																*
+ *					Seven Segment Script Player					*
+ * 		Plays display scripts stored as bytecode in flash		*
+ * 			Scripts are built with tools/seven_segment_asm.py	*
+ * 																*
+ ****************************************************************/
+
+#include "LPC802.h"
+#include "seven_segment.h"
+#include "seven_segment_internal.h"
+#include "seven_segment_irq.h"
+#include "seven_segment_script.h"
+#include "seven_segment_stats.h"
+#include "stdbool.h"
+#include "string.h"
+
+#if SEVEN_SEGMENT_USE_SCRIPT
+// No opcode is waiting on further transitions
+#define SCRIPT_OP_NONE				(0xFF)
+
+
+/************************************************************************************************
+ * 																								*
+ *									Script Decoding Functions									*
+ * 																								*
+ ************************************************************************************************/
+
+/*
+ * Function: scriptOperandsAvailable
+ * --------------------
+ * Checks that an opcode's operands are within the script
+ * Stops the script if they are not so a truncated script can never read past its end
+ * Function called internally
+ *
+ * display: the display to act on
+ * count: number of operand bytes following the opcode
+ *
+ * Return: true if the operands can be read
+ */
+bool scriptOperandsAvailable(SevenSegmentDisplay *display, int count) {
+	if (display->scriptPc + 1 + count > display->scriptLength) {
+		display->scriptFinished = true;
+		return false;
+	}
+	return true;
+}
+
+/*
+ * Function: scriptRead16
+ * --------------------
+ * Reads a 16 bit value stored high byte first
+ * Function called internally
+ *
+ * display: the display to act on
+ * position: offset of the high byte within the script
+ *
+ * Return: the value read
+ */
+int scriptRead16(SevenSegmentDisplay *display, int position) {
+	return (display->scriptCode[position] << 8) | display->scriptCode[position + 1];
+}
+
+/*
+ * Function: continueScriptOp
+ * --------------------
+ * Advances an opcode that takes up several transitions
+ * Completion is checked before stepping so the last screen is shown for a full transition
+ * Function called internally
+ *
+ * display: the display to act on
+ *
+ * Return: true if the opcode is still running and the step should end
+ */
+bool continueScriptOp(SevenSegmentDisplay *display) {
+	if (display->scriptActiveOp == SCRIPT_OP_WAIT) {
+		display->scriptRemainingTicks = display->scriptRemainingTicks - 1;
+		if (display->scriptRemainingTicks > 0) {
+			return true;
+		}
+	} else if (display->scriptActiveOp == SCRIPT_OP_BLINK) {
+		display->scriptRemainingTicks = display->scriptRemainingTicks - 1;
+		if (display->scriptRemainingTicks > 0) {
+			if (getSevenSegmentBrightnessCtx(display) == 0) {
+				setSevenSegmentBrightnessCtx(display, display->scriptBlinkBrightness);
+			} else {
+				setSevenSegmentBrightnessCtx(display, 0);
+			}
+			return true;
+		}
+		setSevenSegmentBrightnessCtx(display, display->scriptBlinkBrightness);
+#if SEVEN_SEGMENT_USE_CAROUSEL
+	} else if (display->scriptActiveOp == SCRIPT_OP_SCROLL) {
+		if (!display->carouselOverflow) {
+			stepCarousel(display);
+			return true;
+		}
+#endif
+#if SEVEN_SEGMENT_USE_SLIDER
+	} else if (display->scriptActiveOp == SCRIPT_OP_SLIDE) {
+		if (!display->pauseSliderTransition) {
+			stepSlider(display);
+			return true;
+		}
+#endif
+#if SEVEN_SEGMENT_USE_COUNTER
+	} else if (display->scriptActiveOp == SCRIPT_OP_COUNT) {
+		if (!display->pauseCounter) {
+			stepCounter(display);
+			return true;
+		}
+#endif
+	}
+
+	display->scriptActiveOp = SCRIPT_OP_NONE;
+	return false;
+}
+
+/*
+ * Function: runScriptOp
+ * --------------------
+ * Decodes and runs the opcode at scriptPc
+ * Function called internally
+ *
+ * display: the display to act on
+ *
+ * Return: true if the opcode yields and the step should end
+ */
+bool runScriptOp(SevenSegmentDisplay *display) {
+	if (display->scriptPc >= display->scriptLength) {
+		display->scriptFinished = true;
+		return true;
+	}
+
+	int op = display->scriptCode[display->scriptPc];
+	if (op == SCRIPT_OP_SHOW) {
+		if (!scriptOperandsAvailable(display, 4)) {
+			return true;
+		}
+		setScreen(display, (char *)&display->scriptCode[display->scriptPc + 1]);
+		display->scriptPc = display->scriptPc + 5;
+		return false;
+	} else if (op == SCRIPT_OP_BRIGHT) {
+		if (!scriptOperandsAvailable(display, 1)) {
+			return true;
+		}
+		setSevenSegmentBrightnessCtx(display, display->scriptCode[display->scriptPc + 1]);
+		display->scriptPc = display->scriptPc + 2;
+		return false;
+	} else if (op == SCRIPT_OP_LOOP) {
+		if (!scriptOperandsAvailable(display, 3)) {
+			return true;
+		}
+		int target = scriptRead16(display, display->scriptPc + 1);
+		int count = display->scriptCode[display->scriptPc + 3];
+		// A count of 0 loops forever and needs no counter
+		if (count == 0) {
+			display->scriptPc = target;
+			return false;
+		}
+		// Each LOOP being repeated has its own counter, the innermost one on top
+		int depth = display->scriptLoopDepth;
+		if (depth == 0 || display->scriptLoopPc[depth - 1] != display->scriptPc) {
+			if (depth == SCRIPT_MAX_LOOP_DEPTH) {
+				display->scriptFinished = true;
+				return true;
+			}
+			display->scriptLoopPc[depth] = display->scriptPc;
+			display->scriptLoopRemaining[depth] = count;
+			depth = depth + 1;
+		}
+		display->scriptLoopRemaining[depth - 1] = display->scriptLoopRemaining[depth - 1] - 1;
+		if (display->scriptLoopRemaining[depth - 1] > 0) {
+			display->scriptPc = target;
+		} else {
+			depth = depth - 1;
+			display->scriptPc = display->scriptPc + 4;
+		}
+		display->scriptLoopDepth = depth;
+		return false;
+	} else if (op == SCRIPT_OP_WAIT || op == SCRIPT_OP_BLINK) {
+		if (!scriptOperandsAvailable(display, 1)) {
+			return true;
+		}
+		display->scriptRemainingTicks = display->scriptCode[display->scriptPc + 1];
+		display->scriptPc = display->scriptPc + 2;
+		if (display->scriptRemainingTicks == 0) {
+			return false;
+		}
+		display->scriptActiveOp = op;
+		if (op == SCRIPT_OP_BLINK) {
+			display->scriptBlinkBrightness = getSevenSegmentBrightnessCtx(display);
+			setSevenSegmentBrightnessCtx(display, 0);
+		}
+		return true;
+	} else if (op == SCRIPT_OP_SCROLL || op == SCRIPT_OP_SLIDE) {
+		if (!scriptOperandsAvailable(display, 2) || !scriptOperandsAvailable(display, 2 + display->scriptCode[display->scriptPc + 2])) {
+			return true;
+		}
+		int length = display->scriptCode[display->scriptPc + 2];
+#if SEVEN_SEGMENT_USE_CAROUSEL || SEVEN_SEGMENT_USE_SLIDER
+		int flags = display->scriptCode[display->scriptPc + 1];
+		char *text = (char *)&display->scriptCode[display->scriptPc + 3];
+#endif
+		// Statements of a mode left out of the library are skipped
+		if (op == SCRIPT_OP_SCROLL) {
+#if SEVEN_SEGMENT_USE_CAROUSEL
+			loadCarouselSequence(display, text, length, false, (flags & SCRIPT_FLAG_PADDING) != 0);
+			setScreen(display, display->carouselSequence);
+#endif
+		} else {
+#if SEVEN_SEGMENT_USE_SLIDER
+			loadSliderSequence(display, text, length, false, (flags & SCRIPT_FLAG_PADDING) != 0,
+					(flags & SCRIPT_FLAG_IGNORE_SPACES) != 0);
+			setScreen(display, display->sliderSequence);
+#endif
+		}
+		display->scriptPc = display->scriptPc + 3 + length;
+		display->scriptActiveOp = op;
+		return true;
+	} else if (op == SCRIPT_OP_COUNT) {
+		if (!scriptOperandsAvailable(display, 5)) {
+			return true;
+		}
+#if SEVEN_SEGMENT_USE_COUNTER
+		int start = scriptRead16(display, display->scriptPc + 1);
+		int stop = scriptRead16(display, display->scriptPc + 3);
+		int increment = display->scriptCode[display->scriptPc + 5];
+		display->scriptPc = display->scriptPc + 6;
+		if (stop >= start) {
+			loadCounter(display, start, "UP", increment, stop, true);
+		} else {
+			loadCounter(display, start, "DOWN", increment, stop, true);
+		}
+		setScreenNumber(display, start);
+		if (start != stop) {
+			display->scriptActiveOp = op;
+			return true;
+		}
+#else
+		display->scriptPc = display->scriptPc + 6;
+#endif
+		return false;
+	}
+
+	// END or an unknown opcode
+	display->scriptFinished = true;
+	return true;
+}
+
+
+/************************************************************************************************
+ * 																								*
+ *									Script Setup Functions										*
+ * 																								*
+ ************************************************************************************************/
+
+/*
+ * Function: setupSevenSegmentScriptCtx
+ * --------------------
+ * Plays a bytecode script on the 7 segment display
+ * This function calls the 2 timers configurations internally
+ * Calling the respective interrupts will refresh the display and step the script
+ *
+ * display: the display to act on
+ * script: bytecode built by tools/seven_segment_asm.py, must stay valid while the script is playing
+ * scriptLength: number of bytes in the script
+ * newTransitionClock: from the list "SysTick", "WKT", "MRT0", "MRT1", "CTIMER0" as input
+ * transitionSpeed: Speed of each script step
+ * refreshClock: from the list: "SysTick", "WKT", "MRT0", "MRT1", "CTIMER0"
+ * refreshRate: speed of cycling through digits
+ * NOTE: newTransitionClock & refreshClock cannot be the same clock
+ *
+ * Return: no return
+ */
+void setupSevenSegmentScriptCtx(SevenSegmentDisplay *display, const uint8_t script[], int newScriptLength, char newTransitionClock[],
+		int transitionSpeed, char refreshClock[], int refreshRate) {
+	if (strcmp(newTransitionClock, refreshClock) != 0) {
+		display->scriptCode = script;
+		display->scriptLength = newScriptLength;
+		char blankScreen[] = {' ', ' ', ' ', ' '};
+		setScreen(display, blankScreen);
+		restartSevenSegmentScriptCtx(display);
+
+		int clock = getClockIndex(newTransitionClock);
+		if (!startClock(display, clock, SEVEN_SEGMENT_TIMER_TRANSITION, transitionSpeed)) {
+			return;
+		}
+		display->transitionRate = transitionSpeed;
+		display->transitionClock = clock;
+		SET_IRQ_HANDLER(display->transitionClock, sevenSegmentScriptInterruptCtx, display);
+		display->contentMode = SEVEN_SEGMENT_CONTENT_SCRIPT;
+
+		startRefreshClock(display, refreshClock, refreshRate);
+	}
+}
+
+
+/************************************************************************************************
+ * 																								*
+ *									Script Interrupt Functions									*
+ * 																								*
+ ************************************************************************************************/
+
+/*
+ * Function: sevenSegmentScriptInterruptCtx
+ * --------------------
+ * Interrupt for the script player
+ * Runs at most SCRIPT_MAX_OPS_PER_STEP opcodes, stopping at the first opcode that yields
+ * This function should be called within the interrupt that handles transitions
+ *
+ * Used when setupSevenSegmentScript is used, where the clock associated with transitions
+ * was passing into newTransitionClock
+ *
+ * display: the display to act on
+ *
+ *
+ * Return: no return
+ */
+void sevenSegmentScriptInterruptCtx(SevenSegmentDisplay *display) {
+	STATS_START(STATS_SCRIPT);
+	HEALTH_TRANSITION(display, display->transitionClock, display->transitionRate);
+	ADAPTIVE_REFRESH_START(display);
+	if (!display->pauseScript && !display->scriptFinished) {
+		bool yielded = false;
+		if (display->scriptActiveOp != SCRIPT_OP_NONE) {
+			yielded = continueScriptOp(display);
+		}
+		for (int i = 0; i < SCRIPT_MAX_OPS_PER_STEP && !yielded && !display->scriptFinished; i++) {
+			yielded = runScriptOp(display);
+		}
+	}
+	ADAPTIVE_REFRESH_END(display);
+
+	restartClock(display->transitionClock, display->transitionRate);
+	STATS_END(STATS_SCRIPT);
+}
+
+
+/************************************************************************************************
+ * 																								*
+ *									Script Helper Functions										*
+ * 																								*
+ ************************************************************************************************/
+
+/*
+ * Function: pauseSevenSegmentScriptCtx
+ * --------------------
+ * Pause the script, the current screen stays on the display
+ *
+ * display: the display to act on
+ *
+ *
+ * Return: no return
+ */
+void pauseSevenSegmentScriptCtx(SevenSegmentDisplay *display) {
+	display->pauseScript = true;
+}
+
+/*
+ * Function: runSevenSegmentScriptCtx
+ * --------------------
+ * Continue the script if paused
+ *
+ * display: the display to act on
+ *
+ *
+ * Return: no return
+ */
+void runSevenSegmentScriptCtx(SevenSegmentDisplay *display) {
+	display->pauseScript = false;
+}
+
+/*
+ * Function: restartSevenSegmentScriptCtx
+ * --------------------
+ * Start the script from the first opcode again
+ * Removes the pause on the script if any
+ *
+ * display: the display to act on
+ *
+ *
+ * Return: no return
+ */
+void restartSevenSegmentScriptCtx(SevenSegmentDisplay *display) {
+	if (display->scriptActiveOp == SCRIPT_OP_BLINK) {
+		setSevenSegmentBrightnessCtx(display, display->scriptBlinkBrightness);
+	}
+	display->scriptPc = 0;
+	display->scriptActiveOp = SCRIPT_OP_NONE;
+	display->scriptLoopDepth = 0;
+	display->scriptFinished = false;
+	display->pauseScript = false;
+}
+
+/*
+ * Function: isSevenSegmentScriptFinishedCtx
+ * --------------------
+ * Check if the script has reached END or run past its last byte
+ *
+ * display: the display to act on
+ *
+ *
+ * Return: true if finished
+ */
+bool isSevenSegmentScriptFinishedCtx(SevenSegmentDisplay *display) {
+	return display->scriptFinished;
+}
+
+
+/************************************************************************************************
+ * 																								*
+ *									Default Display Functions									*
+ * 		Each acts on defaultSevenSegmentDisplay, see the Ctx version of each function			*
+ * 																								*
+ ************************************************************************************************/
+
+void setupSevenSegmentScript(const uint8_t script[], int scriptLength, char newTransitionClock[],
+		int transitionSpeed, char refreshClock[], int refreshRate) {
+	setupSevenSegmentScriptCtx(&defaultSevenSegmentDisplay, script, scriptLength, newTransitionClock, transitionSpeed, refreshClock, refreshRate);
+}
+
+void sevenSegmentScriptInterrupt() {
+	sevenSegmentScriptInterruptCtx(&defaultSevenSegmentDisplay);
+}
+
+void pauseSevenSegmentScript() {
+	pauseSevenSegmentScriptCtx(&defaultSevenSegmentDisplay);
+}
+
+void runSevenSegmentScript() {
+	runSevenSegmentScriptCtx(&defaultSevenSegmentDisplay);
+}
+
+void restartSevenSegmentScript() {
+	restartSevenSegmentScriptCtx(&defaultSevenSegmentDisplay);
+}
+
+bool isSevenSegmentScriptFinished() {
+	return isSevenSegmentScriptFinishedCtx(&defaultSevenSegmentDisplay);
+}
+#endif
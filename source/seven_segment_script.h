@@ -0,0 +1,174 @@
+/****************************************************************
+ * 																*
+ *					Seven Segment Script Player					*
+ * 		Plays display scripts stored as bytecode in flash		*
+ * 			Scripts are built with tools/seven_segment_asm.py	*
+ * 																*
+ ****************************************************************/
+
+#ifndef SEVEN_SEGMENT_SCRIPT_H_
+#define SEVEN_SEGMENT_SCRIPT_H_
+
+#include "stdint.h"
+#include "stdbool.h"
+#include "seven_segment.h"
+
+/*
+ * Script Opcodes
+ * --------------------
+ * All values are single bytes, 16 bit values are stored high byte first
+ * Opcodes marked (yields) take up one or more transitions, the rest run immediately
+ *
+ * END									Stop the script, the last screen stays on the display (yields)
+ * SHOW c0 c1 c2 c3						Display 4 characters
+ * SCROLL flags length chars...			One shot carousel of the characters (yields)
+ *										flags: bit 0 = padding
+ * SLIDE flags length chars...			One shot slider of the characters (yields)
+ *										flags: bit 0 = padding, bit 1 = ignore single spaces
+ * COUNT start(16) stop(16) increment	Count from start to stop, the direction is picked from the values (yields)
+ * BLINK transitions					Flash the display on and off for a number of transitions (yields)
+ * BRIGHT level							Set the brightness 0 .. MAX_BRIGHTNESS
+ * WAIT transitions						Hold the current screen for a number of transitions (yields)
+ * LOOP address(16) count				Jump back to address count times in total, 0 loops forever
+ *										Counted LOOPs may nest SCRIPT_MAX_LOOP_DEPTH deep, they must not overlap
+ */
+#define SCRIPT_OP_END				(0x00)
+#define SCRIPT_OP_SHOW				(0x01)
+#define SCRIPT_OP_SCROLL			(0x02)
+#define SCRIPT_OP_SLIDE				(0x03)
+#define SCRIPT_OP_COUNT				(0x04)
+#define SCRIPT_OP_BLINK				(0x05)
+#define SCRIPT_OP_BRIGHT			(0x06)
+#define SCRIPT_OP_WAIT				(0x07)
+#define SCRIPT_OP_LOOP				(0x08)
+
+#define SCRIPT_FLAG_PADDING			(0x01)
+#define SCRIPT_FLAG_IGNORE_SPACES	(0x02)
+
+// Upper bound on the opcodes run in a single interrupt, keeps the cost of each step bounded
+#define SCRIPT_MAX_OPS_PER_STEP		(8)
+
+
+#if SEVEN_SEGMENT_USE_SCRIPT
+
+/************************************************************************************************
+ * 																								*
+ *									Script Setup Functions										*
+ * 																								*
+ ************************************************************************************************/
+
+/*
+ * Function: setupSevenSegmentScript
+ * --------------------
+ * Plays a bytecode script on the 7 segment display
+ * This function calls the 2 timers configurations internally
+ * Calling the respective interrupts will refresh the display and step the script
+ *
+ * script: bytecode built by tools/seven_segment_asm.py, must stay valid while the script is playing
+ * scriptLength: number of bytes in the script
+ * newTransitionClock: from the list "SysTick", "WKT", "MRT0", "MRT1", "CTIMER0" as input
+ * transitionSpeed: Speed of each script step
+ * refreshClock: from the list: "SysTick", "WKT", "MRT0", "MRT1", "CTIMER0"
+ * refreshRate: speed of cycling through digits
+ * NOTE: newTransitionClock & refreshClock cannot be the same clock
+ *
+ * Return: no return
+ */
+void setupSevenSegmentScript(const uint8_t script[], int scriptLength, char newTransitionClock[],
+		int transitionSpeed, char refreshClock[], int refreshRate);
+
+
+/************************************************************************************************
+ * 																								*
+ *									Script Interrupt Functions									*
+ * 																								*
+ ************************************************************************************************/
+
+/*
+ * Function: sevenSegmentScriptInterrupt
+ * --------------------
+ * Interrupt for the script player
+ * Runs at most SCRIPT_MAX_OPS_PER_STEP opcodes, stopping at the first opcode that yields
+ * This function should be called within the interrupt that handles transitions
+ *
+ * Used when setupSevenSegmentScript is used, where the clock associated with transitions
+ * was passing into newTransitionClock
+ *
+ *
+ * Return: no return
+ */
+void sevenSegmentScriptInterrupt();
+
+
+/************************************************************************************************
+ * 																								*
+ *									Script Helper Functions										*
+ * 																								*
+ ************************************************************************************************/
+
+/*
+ * Function: pauseSevenSegmentScript
+ * --------------------
+ * Pause the script, the current screen stays on the display
+ *
+ *
+ * Return: no return
+ */
+void pauseSevenSegmentScript();
+
+/*
+ * Function: runSevenSegmentScript
+ * --------------------
+ * Continue the script if paused
+ *
+ *
+ * Return: no return
+ */
+void runSevenSegmentScript();
+
+/*
+ * Function: restartSevenSegmentScript
+ * --------------------
+ * Start the script from the first opcode again
+ * Removes the pause on the script if any
+ *
+ *
+ * Return: no return
+ */
+void restartSevenSegmentScript();
+
+/*
+ * Function: isSevenSegmentScriptFinished
+ * --------------------
+ * Check if the script has reached END or run past its last byte
+ *
+ *
+ * Return: true if finished
+ */
+bool isSevenSegmentScriptFinished();
+
+
+/************************************************************************************************
+ * 																								*
+ *									Display Context Functions									*
+ * 																								*
+ ************************************************************************************************/
+
+/*
+ * Functions: ...Ctx
+ * --------------------
+ * Each function below behaves like the function of the same name above, acting on the given display
+ * Several displays can play their own scripts, each on its own transition clock
+ *
+ * display: the display to act on
+ */
+void setupSevenSegmentScriptCtx(SevenSegmentDisplay *display, const uint8_t script[], int scriptLength,
+		char newTransitionClock[], int transitionSpeed, char refreshClock[], int refreshRate);
+void sevenSegmentScriptInterruptCtx(SevenSegmentDisplay *display);
+void pauseSevenSegmentScriptCtx(SevenSegmentDisplay *display);
+void runSevenSegmentScriptCtx(SevenSegmentDisplay *display);
+void restartSevenSegmentScriptCtx(SevenSegmentDisplay *display);
+bool isSevenSegmentScriptFinishedCtx(SevenSegmentDisplay *display);
+#endif
+
+#endif /* SEVEN_SEGMENT_SCRIPT_H_ */
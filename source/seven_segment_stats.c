@@ -0,0 +1,363 @@
+/****************************************************************
+ * 																*
+ *					Seven Segment Interrupt Stats				*
+ * 		Measures the time spent in the library interrupt		*
+ * 		helpers with SysTick or a free running MRT channel		*
+ * 		and how well each display keeps up with its clocks		*
+ * 		Only built when SEVEN_SEGMENT_STATS is defined			*
+ * 																*
+ ****************************************************************/
+
+#include "seven_segment_stats.h"
+
+#ifdef SEVEN_SEGMENT_STATS
+
+#include "seven_segment_internal.h"
+#include "stddef.h"
+
+SevenSegmentStats sevenSegmentStats;
+// Clock index from getClockIndex, -1 until setupSevenSegmentStats has run
+int statsClock = -1;
+
+
+/*
+ * Function: setupSevenSegmentStats
+ * --------------------
+ * Picks the clock the stats are measured with
+ * SysTick is read as it is when already running (it may be a display clock or the application's
+ * timer), otherwise it is started free running without an interrupt
+ * A display whose refresh clock is the stats clock gets no framesPerSecond or longestRefreshGap,
+ * its refresh period is a whole turn of the stats clock
+ * An MRT channel is started free running without an interrupt and reserved, the display functions
+ * are then refused the channel
+ *
+ * newStatsClock: "SysTick", "MRT0" or "MRT1"
+ *
+ * Return: no return
+ */
+void setupSevenSegmentStats(char newStatsClock[]) {
+	int clock = getClockIndex(newStatsClock);
+
+	if (clock == 0) {
+		if ((SysTick->CTRL & SysTick_CTRL_ENABLE_Msk) == 0) {
+			SysTick->LOAD = SysTick_LOAD_RELOAD_Msk;
+			SysTick->VAL = 0;
+			SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_ENABLE_Msk;
+		}
+	} else if ((clock == 2 || clock == 3) && claimClock(NULL, clock, SEVEN_SEGMENT_TIMER_USER)) {
+		initTimerPeripheral(clock);
+		MRT0->CHANNEL[clock - 2].CTRL = 0; // repeat mode, no interrupt
+		MRT0->CHANNEL[clock - 2].INTVAL = MRT_CHANNEL_INTVAL_IVALUE_MASK | MRT_CHANNEL_INTVAL_LOAD_MASK;
+	} else {
+		clock = -1;
+	}
+
+	statsClock = clock;
+	clearSevenSegmentStats();
+}
+
+/*
+ * Function: getSevenSegmentStats
+ * --------------------
+ * Gives the stats gathered since the last clearSevenSegmentStats
+ * The stats keep changing in the interrupts, copy an entry with the interrupts off for a
+ * consistent snapshot
+ *
+ *
+ * Return: the stats of every helper
+ */
+const SevenSegmentStats *getSevenSegmentStats() {
+	return &sevenSegmentStats;
+}
+
+/*
+ * Function: clearSevenSegmentStats
+ * --------------------
+ * Zeroes every counter, for example after the display has been set up
+ *
+ *
+ * Return: no return
+ */
+void clearSevenSegmentStats() {
+	for (int i = 0; i < SEVEN_SEGMENT_STATS_HELPERS; i++) {
+		SevenSegmentHelperStats *stats = &sevenSegmentStats.helpers[i];
+		stats->count = 0;
+		stats->minCycles = UINT32_MAX;
+		stats->maxCycles = 0;
+		stats->totalCycles = 0;
+		stats->minPeriod = UINT32_MAX;
+		stats->maxPeriod = 0;
+		for (int j = 0; j < SEVEN_SEGMENT_STATS_BINS; j++) {
+			stats->histogram[j] = 0;
+		}
+	}
+}
+
+/*
+ * Function: readStatsClock
+ * --------------------
+ * Reads the stats clock as a count going up, so later readings are larger until it wraps
+ * Function called internally
+ *
+ *
+ * Return: cycles since the stats clock last reloaded
+ */
+uint32_t readStatsClock() {
+	if (statsClock == 0) {
+		return SysTick->LOAD - SysTick->VAL;
+	}
+	return (MRT0->CHANNEL[statsClock - 2].INTVAL & MRT_CHANNEL_INTVAL_IVALUE_MASK) - MRT0->CHANNEL[statsClock - 2].TIMER;
+}
+
+/*
+ * Function: statsClockPeriod
+ * --------------------
+ * Cycles in one turn of the stats clock, the longest time it can measure
+ * Function called internally
+ *
+ *
+ * Return: cycles between reloads of the stats clock
+ */
+uint32_t statsClockPeriod() {
+	if (statsClock == 0) {
+		return SysTick->LOAD + 1;
+	}
+	return MRT0->CHANNEL[statsClock - 2].INTVAL & MRT_CHANNEL_INTVAL_IVALUE_MASK;
+}
+
+/*
+ * Function: statsElapsed
+ * --------------------
+ * Cycles between two readings of the stats clock, allowing for one reload in between
+ * Function called internally
+ *
+ * start: the earlier reading
+ * end: the later reading
+ *
+ * Return: cycles from start to end
+ */
+uint32_t statsElapsed(uint32_t start, uint32_t end) {
+	if (end >= start) {
+		return end - start;
+	}
+	return end + statsClockPeriod() - start;
+}
+
+/*
+ * Function: startHelperStats
+ * --------------------
+ * Reads the stats clock at the start of a helper and records the time since its last call
+ * Function called internally by STATS_START
+ *
+ * helper: STATS_REFRESH .. STATS_SPI
+ *
+ * Return: stats clock reading to hand to endHelperStats
+ */
+uint32_t startHelperStats(int helper) {
+	if (statsClock < 0) {
+		return 0;
+	}
+
+	uint32_t start = readStatsClock();
+	SevenSegmentHelperStats *stats = &sevenSegmentStats.helpers[helper];
+	if (stats->count > 0) {
+		uint32_t period = statsElapsed(stats->lastStart, start);
+		if (period < stats->minPeriod) {
+			stats->minPeriod = period;
+		}
+		if (period > stats->maxPeriod) {
+			stats->maxPeriod = period;
+		}
+	}
+	stats->lastStart = start;
+	return start;
+}
+
+/*
+ * Function: endHelperStats
+ * --------------------
+ * Reads the stats clock at the end of a helper and records the duration of the call
+ * Function called internally by STATS_END
+ *
+ * helper: STATS_REFRESH .. STATS_SPI
+ * start: value returned by startHelperStats
+ *
+ * Return: no return
+ */
+void endHelperStats(int helper, uint32_t start) {
+	if (statsClock < 0) {
+		return;
+	}
+
+	uint32_t cycles = statsElapsed(start, readStatsClock());
+	SevenSegmentHelperStats *stats = &sevenSegmentStats.helpers[helper];
+	stats->count = stats->count + 1;
+	stats->totalCycles = stats->totalCycles + cycles;
+	if (cycles < stats->minCycles) {
+		stats->minCycles = cycles;
+	}
+	if (cycles > stats->maxCycles) {
+		stats->maxCycles = cycles;
+	}
+
+	int bin = 0;
+	uint32_t limit = (1 << SEVEN_SEGMENT_STATS_BIN_SHIFT);
+	while (bin < SEVEN_SEGMENT_STATS_BINS - 1 && cycles >= limit) {
+		bin = bin + 1;
+		limit = limit << 1;
+	}
+	stats->histogram[bin] = stats->histogram[bin] + 1;
+}
+
+
+/************************************************************************************************
+ * 																								*
+ *									Display Health Functions									*
+ * 																								*
+ ************************************************************************************************/
+
+/*
+ * Function: getSevenSegmentHealthCtx
+ * --------------------
+ * Gives the achieved refresh rate and transition lag of the display, to be polled or logged
+ * Gathered once setupSevenSegmentStats has picked a stats clock
+ * The first gaps after a display function starts a new mode can look late, clear the health
+ * once the display is running
+ *
+ * display: the display to act on
+ *
+ * Return: health counters of the display
+ */
+const SevenSegmentHealth *getSevenSegmentHealthCtx(SevenSegmentDisplay *display) {
+	return &display->health;
+}
+
+/*
+ * Function: clearSevenSegmentHealthCtx
+ * --------------------
+ * Zeroes the health counters of the display
+ *
+ * display: the display to act on
+ *
+ * Return: no return
+ */
+void clearSevenSegmentHealthCtx(SevenSegmentDisplay *display) {
+	SevenSegmentHealth *health = &display->health;
+	health->refreshTicks = 0;
+	health->frames = 0;
+	health->framesPerSecond = 0;
+	health->longestRefreshGap = 0;
+	health->transitions = 0;
+	health->lateTransitions = 0;
+	health->coalescedTransitions = 0;
+	health->windowFrames = 0;
+	health->windowCycles = 0;
+}
+
+/*
+ * Function: recordHealthRefresh
+ * --------------------
+ * Measures the gap since the last refresh interrupt of the display and counts frames
+ * Function called internally by HEALTH_REFRESH
+ *
+ * display: the display to act on
+ * frameDone: true if the interrupt completed a frame of the display
+ *
+ * Return: no return
+ */
+void recordHealthRefresh(SevenSegmentDisplay *display, bool frameDone) {
+	if (statsClock < 0) {
+		return;
+	}
+
+	SevenSegmentHealth *health = &display->health;
+	uint32_t now = readStatsClock();
+	uint32_t period = display->refresh.cycleRate;
+	if (display->refresh.currentClock == 1) {
+		period = display->refresh.cycleRate * (SystemCoreClock / WKT_CLOCK_HZ);
+	}
+
+	// Gaps of one turn of the stats clock or more cannot be measured, as when SysTick is both the stats
+	// clock and the refresh clock and every gap wraps to about 0, only the frames are counted then
+	bool measurable = period < statsClockPeriod();
+	if (health->refreshTicks > 0 && measurable) {
+		uint32_t gap = statsElapsed(health->lastRefresh, now);
+		if (gap > health->longestRefreshGap) {
+			health->longestRefreshGap = gap;
+		}
+		health->windowCycles = health->windowCycles + gap;
+	}
+	health->lastRefresh = now;
+	health->refreshTicks = health->refreshTicks + 1;
+
+	if (frameDone) {
+		health->frames = health->frames + 1;
+		if (measurable) {
+			health->windowFrames = health->windowFrames + 1;
+		}
+	}
+
+	// Once a second, scaled down by 1000 so the product stays within 32 bits
+	if (health->windowCycles >= SystemCoreClock) {
+		health->framesPerSecond = (health->windowFrames * (SystemCoreClock / 1000)) / (health->windowCycles / 1000);
+		health->windowFrames = 0;
+		health->windowCycles = 0;
+	}
+}
+
+/*
+ * Function: recordHealthTransition
+ * --------------------
+ * Compares the gap since the last transition of the display with the period it was meant to have
+ * Function called internally by HEALTH_TRANSITION
+ *
+ * display: the display to act on
+ * clock: internal clock index (0..4) of the transition
+ * rate: period of the transition in the units of that clock
+ *
+ * Return: no return
+ */
+void recordHealthTransition(SevenSegmentDisplay *display, int clock, int rate) {
+	if (statsClock < 0) {
+		return;
+	}
+
+	SevenSegmentHealth *health = &display->health;
+	uint32_t now = readStatsClock();
+	uint32_t period = rate;
+	if (clock == 1) {
+		period = rate * (SystemCoreClock / WKT_CLOCK_HZ);
+	}
+
+	// Gaps longer than one turn of the stats clock cannot be measured
+	if (health->transitions > 0 && period > 0 && period < statsClockPeriod()) {
+		uint32_t gap = statsElapsed(health->lastTransition, now);
+		if (gap > period + period / 8) {
+			health->lateTransitions = health->lateTransitions + 1;
+		}
+		uint32_t periods = (gap + period / 2) / period;
+		if (periods > 1) {
+			health->coalescedTransitions = health->coalescedTransitions + periods - 1;
+		}
+	}
+	health->lastTransition = now;
+	health->transitions = health->transitions + 1;
+}
+
+
+/************************************************************************************************
+ * 																								*
+ *									Default Display Functions									*
+ * 		Each acts on defaultSevenSegmentDisplay, see the Ctx version of each function			*
+ * 																								*
+ ************************************************************************************************/
+
+const SevenSegmentHealth *getSevenSegmentHealth() {
+	return getSevenSegmentHealthCtx(&defaultSevenSegmentDisplay);
+}
+
+void clearSevenSegmentHealth() {
+	clearSevenSegmentHealthCtx(&defaultSevenSegmentDisplay);
+}
+
+#endif /* SEVEN_SEGMENT_STATS */
@@ -0,0 +1,221 @@
+/****************************************************************
+ * 																*
+ *					Seven Segment Interrupt Stats				*
+ * 		Measures the time spent in the library interrupt		*
+ * 		helpers with SysTick or a free running MRT channel		*
+ * 		and how well each display keeps up with its clocks		*
+ * 		Only built when SEVEN_SEGMENT_STATS is defined			*
+ * 																*
+ ****************************************************************/
+
+#ifndef SEVEN_SEGMENT_STATS_H_
+#define SEVEN_SEGMENT_STATS_H_
+
+#include "LPC802.h"
+#include "stdbool.h"
+#include "stdint.h"
+#include "seven_segment.h"
+
+// Interrupt helpers measured by the stats
+#define STATS_REFRESH				(0)		// display4CharactersInterrupt and its wrappers, displayMultipleInterrupt, displaySPIChainInterrupt
+#define STATS_COUNTER				(1)		// updateSevenSegmentCounterInterrupt
+#define STATS_CAROUSEL				(2)		// sevenSegmentCarouselInterrupt
+#define STATS_SLIDER				(3)		// sevenSegmentSliderInterrupt
+#define STATS_SEQUENCER				(4)		// sevenSegmentSequencerInterrupt
+#define STATS_SCRIPT				(5)		// sevenSegmentScriptInterrupt
+#define STATS_SPI					(6)		// sevenSegmentSPIInterrupt
+#define SEVEN_SEGMENT_STATS_HELPERS	(7)
+
+#ifdef SEVEN_SEGMENT_STATS
+
+// Histogram bins per helper, bin 0 counts calls shorter than 1 << SEVEN_SEGMENT_STATS_BIN_SHIFT cycles,
+// each following bin doubles the limit and the last bin counts everything longer
+#ifndef SEVEN_SEGMENT_STATS_BINS
+#define SEVEN_SEGMENT_STATS_BINS	(8)
+#endif
+#ifndef SEVEN_SEGMENT_STATS_BIN_SHIFT
+#define SEVEN_SEGMENT_STATS_BIN_SHIFT	(6)
+#endif
+
+/*
+ * Struct: SevenSegmentHelperStats
+ * --------------------
+ * Cost of one interrupt helper, times are in cycles of the main clock
+ *
+ * count: calls measured
+ * minCycles, maxCycles: shortest and longest call
+ * totalCycles: sum of all calls, totalCycles / count is the average
+ * minPeriod, maxPeriod: shortest and longest time between the starts of two calls, the jitter of
+ *                       the interrupt, only valid for periods shorter than one turn of the stats clock
+ * histogram: calls per duration bin, see SEVEN_SEGMENT_STATS_BIN_SHIFT
+ * lastStart: stats clock reading at the start of the last call
+ */
+typedef struct {
+	uint32_t count;
+	uint32_t minCycles;
+	uint32_t maxCycles;
+	uint32_t totalCycles;
+	uint32_t minPeriod;
+	uint32_t maxPeriod;
+	uint32_t histogram[SEVEN_SEGMENT_STATS_BINS];
+	uint32_t lastStart;
+} SevenSegmentHelperStats;
+
+/*
+ * Struct: SevenSegmentStats
+ * --------------------
+ * helpers: one entry per helper, indexed by STATS_REFRESH .. STATS_SPI
+ */
+typedef struct {
+	SevenSegmentHelperStats helpers[SEVEN_SEGMENT_STATS_HELPERS];
+} SevenSegmentStats;
+
+// Placed at the start and end of a helper, the start macro declares the variable holding the start time
+#define STATS_START(helper)			uint32_t statsStart = startHelperStats(helper)
+#define STATS_END(helper)			endHelperStats(helper, statsStart)
+
+// Placed in the refresh and transition interrupts to keep the SevenSegmentHealth of the display
+#define HEALTH_REFRESH(display, frameDone)			recordHealthRefresh(display, frameDone)
+#define HEALTH_TRANSITION(display, clock, rate)		recordHealthTransition(display, clock, rate)
+
+/*
+ * Function: setupSevenSegmentStats
+ * --------------------
+ * Picks the clock the stats are measured with
+ * SysTick is read as it is when already running (it may be a display clock or the application's
+ * timer), otherwise it is started free running without an interrupt
+ * A display whose refresh clock is the stats clock gets no framesPerSecond or longestRefreshGap,
+ * its refresh period is a whole turn of the stats clock
+ * An MRT channel is started free running without an interrupt and reserved, the display functions
+ * are then refused the channel
+ *
+ * newStatsClock: "SysTick", "MRT0" or "MRT1"
+ *
+ * Return: no return
+ */
+void setupSevenSegmentStats(char newStatsClock[]);
+
+/*
+ * Function: getSevenSegmentStats
+ * --------------------
+ * Gives the stats gathered since the last clearSevenSegmentStats
+ * The stats keep changing in the interrupts, copy an entry with the interrupts off for a
+ * consistent snapshot
+ *
+ *
+ * Return: the stats of every helper
+ */
+const SevenSegmentStats *getSevenSegmentStats();
+
+/*
+ * Function: clearSevenSegmentStats
+ * --------------------
+ * Zeroes every counter, for example after the display has been set up
+ *
+ *
+ * Return: no return
+ */
+void clearSevenSegmentStats();
+
+/*
+ * Function: startHelperStats
+ * --------------------
+ * Reads the stats clock at the start of a helper and records the time since its last call
+ * Function called internally by STATS_START
+ *
+ * helper: STATS_REFRESH .. STATS_SPI
+ *
+ * Return: stats clock reading to hand to endHelperStats
+ */
+uint32_t startHelperStats(int helper);
+
+/*
+ * Function: endHelperStats
+ * --------------------
+ * Reads the stats clock at the end of a helper and records the duration of the call
+ * Function called internally by STATS_END
+ *
+ * helper: STATS_REFRESH .. STATS_SPI
+ * start: value returned by startHelperStats
+ *
+ * Return: no return
+ */
+void endHelperStats(int helper, uint32_t start);
+
+/*
+ * Function: getSevenSegmentHealth
+ * --------------------
+ * Gives the achieved refresh rate and transition lag of the display, to be polled or logged
+ * Gathered once setupSevenSegmentStats has picked a stats clock
+ * The first gaps after a display function starts a new mode can look late, clear the health
+ * once the display is running
+ *
+ *
+ * Return: health counters of the display
+ */
+const SevenSegmentHealth *getSevenSegmentHealth();
+
+/*
+ * Function: clearSevenSegmentHealth
+ * --------------------
+ * Zeroes the health counters of the display
+ *
+ *
+ * Return: no return
+ */
+void clearSevenSegmentHealth();
+
+/*
+ * Function: recordHealthRefresh
+ * --------------------
+ * Measures the gap since the last refresh interrupt of the display and counts frames
+ * Function called internally by HEALTH_REFRESH
+ *
+ * display: the display to act on
+ * frameDone: true if the interrupt completed a frame of the display
+ *
+ * Return: no return
+ */
+void recordHealthRefresh(SevenSegmentDisplay *display, bool frameDone);
+
+/*
+ * Function: recordHealthTransition
+ * --------------------
+ * Compares the gap since the last transition of the display with the period it was meant to have
+ * Function called internally by HEALTH_TRANSITION
+ *
+ * display: the display to act on
+ * clock: internal clock index (0..4) of the transition
+ * rate: period of the transition in the units of that clock
+ *
+ * Return: no return
+ */
+void recordHealthTransition(SevenSegmentDisplay *display, int clock, int rate);
+
+
+/************************************************************************************************
+ * 																								*
+ *									Display Context Functions									*
+ * 																								*
+ ************************************************************************************************/
+
+/*
+ * Functions: ...Ctx
+ * --------------------
+ * Each function below behaves like the function of the same name above, acting on the given display
+ *
+ * display: the display to act on
+ */
+const SevenSegmentHealth *getSevenSegmentHealthCtx(SevenSegmentDisplay *display);
+void clearSevenSegmentHealthCtx(SevenSegmentDisplay *display);
+
+#else
+
+#define STATS_START(helper)
+#define STATS_END(helper)
+#define HEALTH_REFRESH(display, frameDone)
+#define HEALTH_TRANSITION(display, clock, rate)
+
+#endif /* SEVEN_SEGMENT_STATS */
+
+#endif /* SEVEN_SEGMENT_STATS_H_ */
@@ -0,0 +1,66 @@
+/****************************************************************
+ * 																*
+ *					Seven Segment GPIO Trace					*
+ * 		Records every GPIO write made by the output backends	*
+ * 		Only built when SEVEN_SEGMENT_TRACE is defined			*
+ * 																*
+ ****************************************************************/
+
+#include "seven_segment_trace.h"
+
+#ifdef SEVEN_SEGMENT_TRACE
+
+SevenSegmentTrace sevenSegmentTrace;
+
+
+/*
+ * Function: recordGPIOWrite
+ * --------------------
+ * Adds a GPIO write to the trace
+ * Function called internally by the WRITE_GPIO macros
+ *
+ * reg: GPIO_TRACE_SET, GPIO_TRACE_CLR, GPIO_TRACE_DIRSET or GPIO_TRACE_DIRCLR
+ * mask: value written
+ *
+ * Return: no return
+ */
+void recordGPIOWrite(int reg, uint32_t mask) {
+	SevenSegmentTraceEntry *entry = &sevenSegmentTrace.entries[sevenSegmentTrace.writes % SEVEN_SEGMENT_TRACE_LENGTH];
+	entry->tick = sevenSegmentTrace.ticks;
+	entry->reg = reg;
+	entry->mask = mask;
+	sevenSegmentTrace.writes = sevenSegmentTrace.writes + 1;
+}
+
+/*
+ * Function: recordRefreshTick
+ * --------------------
+ * Moves the virtual timestamp on by one refresh interrupt
+ * Function called internally by the refresh interrupt
+ *
+ * frameDone: true if the tick completed a frame of its display
+ *
+ * Return: no return
+ */
+void recordRefreshTick(bool frameDone) {
+	sevenSegmentTrace.ticks = sevenSegmentTrace.ticks + 1;
+	if (frameDone) {
+		sevenSegmentTrace.frames = sevenSegmentTrace.frames + 1;
+	}
+}
+
+/*
+ * Function: clearSevenSegmentTrace
+ * --------------------
+ * Empties the trace and zeroes its counters, for example before a scenario is replayed
+ *
+ *
+ * Return: no return
+ */
+void clearSevenSegmentTrace() {
+	sevenSegmentTrace.writes = 0;
+	sevenSegmentTrace.ticks = 0;
+	sevenSegmentTrace.frames = 0;
+}
+
+#endif /* SEVEN_SEGMENT_TRACE */
@@ -0,0 +1,111 @@
+/****************************************************************
+ * 																*
+ *					Seven Segment GPIO Trace					*
+ * 		Records every GPIO write made by the output backends	*
+ * 		Only built when SEVEN_SEGMENT_TRACE is defined			*
+ * 																*
+ ****************************************************************/
+
+#ifndef SEVEN_SEGMENT_TRACE_H_
+#define SEVEN_SEGMENT_TRACE_H_
+
+#include "LPC802.h"
+#include "stdbool.h"
+#include "stdint.h"
+
+// GPIO registers written by the backends
+#define GPIO_TRACE_SET				(0)
+#define GPIO_TRACE_CLR				(1)
+#define GPIO_TRACE_DIRSET			(2)
+#define GPIO_TRACE_DIRCLR			(3)
+
+#ifdef SEVEN_SEGMENT_TRACE
+
+// Entries kept by the trace, the oldest are overwritten once it is full
+#ifndef SEVEN_SEGMENT_TRACE_LENGTH
+#define SEVEN_SEGMENT_TRACE_LENGTH	(64)
+#endif
+
+/*
+ * Struct: SevenSegmentTraceEntry
+ * --------------------
+ * One GPIO write
+ *
+ * tick: refresh interrupts seen before the write, the virtual timestamp of the write
+ * reg: GPIO_TRACE_SET, GPIO_TRACE_CLR, GPIO_TRACE_DIRSET or GPIO_TRACE_DIRCLR
+ * mask: value written
+ */
+typedef struct {
+	uint32_t tick;
+	uint8_t reg;
+	uint32_t mask;
+} SevenSegmentTraceEntry;
+
+/*
+ * Struct: SevenSegmentTrace
+ * --------------------
+ * entries: the last SEVEN_SEGMENT_TRACE_LENGTH writes, entries[(writes - 1) % SEVEN_SEGMENT_TRACE_LENGTH] is the newest
+ * writes: GPIO writes since the trace was cleared
+ * ticks: refresh interrupts since the trace was cleared
+ * frames: refresh frames (4 ticks of a display) completed since the trace was cleared
+ */
+typedef struct {
+	SevenSegmentTraceEntry entries[SEVEN_SEGMENT_TRACE_LENGTH];
+	uint32_t writes;
+	uint32_t ticks;
+	uint32_t frames;
+} SevenSegmentTrace;
+
+extern SevenSegmentTrace sevenSegmentTrace;
+
+// Backends write the GPIOs through these so each write can be recorded
+#define WRITE_GPIO_SET(mask)		do { GPIO->SET[0] = (mask); recordGPIOWrite(GPIO_TRACE_SET, (mask)); } while (0)
+#define WRITE_GPIO_CLR(mask)		do { GPIO->CLR[0] = (mask); recordGPIOWrite(GPIO_TRACE_CLR, (mask)); } while (0)
+#define WRITE_GPIO_DIRSET(mask)		do { GPIO->DIRSET[0] = (mask); recordGPIOWrite(GPIO_TRACE_DIRSET, (mask)); } while (0)
+#define WRITE_GPIO_DIRCLR(mask)		do { GPIO->DIRCLR[0] = (mask); recordGPIOWrite(GPIO_TRACE_DIRCLR, (mask)); } while (0)
+
+/*
+ * Function: recordGPIOWrite
+ * --------------------
+ * Adds a GPIO write to the trace
+ * Function called internally by the WRITE_GPIO macros
+ *
+ * reg: GPIO_TRACE_SET, GPIO_TRACE_CLR, GPIO_TRACE_DIRSET or GPIO_TRACE_DIRCLR
+ * mask: value written
+ *
+ * Return: no return
+ */
+void recordGPIOWrite(int reg, uint32_t mask);
+
+/*
+ * Function: recordRefreshTick
+ * --------------------
+ * Moves the virtual timestamp on by one refresh interrupt
+ * Function called internally by the refresh interrupt
+ *
+ * frameDone: true if the tick completed a frame of its display
+ *
+ * Return: no return
+ */
+void recordRefreshTick(bool frameDone);
+
+/*
+ * Function: clearSevenSegmentTrace
+ * --------------------
+ * Empties the trace and zeroes its counters, for example before a scenario is replayed
+ *
+ *
+ * Return: no return
+ */
+void clearSevenSegmentTrace();
+
+#else
+
+#define WRITE_GPIO_SET(mask)		(GPIO->SET[0] = (mask))
+#define WRITE_GPIO_CLR(mask)		(GPIO->CLR[0] = (mask))
+#define WRITE_GPIO_DIRSET(mask)		(GPIO->DIRSET[0] = (mask))
+#define WRITE_GPIO_DIRCLR(mask)		(GPIO->DIRCLR[0] = (mask))
+
+#endif /* SEVEN_SEGMENT_TRACE */
+
+#endif /* SEVEN_SEGMENT_TRACE_H_ */
@@ -0,0 +1,117 @@
+#!/usr/bin/env python3
+"""
+Charlieplex Wiring Check
+
+Simulates every scan step of the charlieplex backend in seven_segment_backend.c and
+reports LEDs that would light other than the ones the step means to light.
+
+A step drives the common line of one digit and the lines of its lit segments, every
+other line is tri-stated. An LED lights when its anode is driven high and its cathode
+low. It can also light through a sneak path: a chain of LEDs running through tri-stated
+lines from a high line to a low line, which conducts when the chain's forward voltages
+add up to no more than the supply.
+
+The wiring follows charlieplexSegmentLine(): digit place k has its common on line k,
+segment j (A..G, DP) of digit k is on line j for j < k and on line j + 1 otherwise.
+
+Usage: charlieplex_check.py [--lines 8|9] [--anode] [--vcc 3.3] [--vf 1.8]
+"""
+
+import argparse
+import sys
+
+DIGITS = 4
+SEGMENT_NAMES = "ABCDEFGP"
+
+
+def segmentLine(digitPlace, segment):
+    # Must match charlieplexSegmentLine() in seven_segment_backend.c
+    if segment < digitPlace:
+        return segment
+    return segment + 1
+
+
+def buildLeds(lineCount, commonAnode):
+    """Every LED as (anode line, cathode line, name)."""
+    leds = []
+    for digit in range(DIGITS):
+        for segment in range(lineCount - 1):
+            line = segmentLine(digit, segment)
+            name = "digit %d segment %s" % (digit, SEGMENT_NAMES[segment])
+            if commonAnode:
+                leds.append((digit, line, name))
+            else:
+                leds.append((line, digit, name))
+    return leds
+
+
+def buildStep(lineCount, commonAnode, digitPlace, segmentBits):
+    """Line levels for a step as charlieplexBuildStep() drives them: 1 high, 0 low, None tri-stated."""
+    levels = [None] * lineCount
+    segmentLines = [segmentLine(digitPlace, i) for i in range(lineCount - 1) if segmentBits & (1 << i)]
+    if not segmentLines:
+        return levels
+    levels[digitPlace] = 1 if commonAnode else 0
+    for line in segmentLines:
+        levels[line] = 0 if commonAnode else 1
+    return levels
+
+
+def litLeds(leds, levels, maxChain):
+    """Names of the LEDs conducting for the given line levels."""
+    lit = set()
+    # Chains start at a high line and may only pass through tri-stated lines until they reach a low line
+    for start in range(len(levels)):
+        if levels[start] != 1:
+            continue
+        # (line reached, LEDs used so far)
+        paths = [(start, [])]
+        while paths:
+            line, used = paths.pop()
+            for anode, cathode, name in leds:
+                if anode != line or name in used or len(used) >= maxChain:
+                    continue
+                if levels[cathode] == 0:
+                    lit.update(used + [name])
+                elif levels[cathode] is None:
+                    paths.append((cathode, used + [name]))
+    return lit
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Check a charlieplexed display for sneak path lighting")
+    parser.add_argument("--lines", type=int, choices=(8, 9), default=9, help="8 lines without DP, 9 with DP")
+    parser.add_argument("--anode", action="store_true", help="common anode display (default common cathode)")
+    parser.add_argument("--vcc", type=float, default=3.3, help="GPIO high level in volts")
+    parser.add_argument("--vf", type=float, default=1.8, help="LED forward voltage in volts")
+    options = parser.parse_args()
+
+    # Longest chain of LEDs the supply can push current through
+    maxChain = int(options.vcc // options.vf)
+    leds = buildLeds(options.lines, options.anode)
+    segmentCount = options.lines - 1
+
+    failures = 0
+    for digitPlace in range(DIGITS):
+        for segmentBits in range(1 << segmentCount):
+            levels = buildStep(options.lines, options.anode, digitPlace, segmentBits)
+            wanted = set("digit %d segment %s" % (digitPlace, SEGMENT_NAMES[i])
+                         for i in range(segmentCount) if segmentBits & (1 << i))
+            lit = litLeds(leds, levels, maxChain)
+            if lit != wanted:
+                failures += 1
+                if failures <= 20:
+                    sys.stdout.write("digit %d segments 0x%02X: unintended %s, missing %s\n"
+                                     % (digitPlace, segmentBits, sorted(lit - wanted), sorted(wanted - lit)))
+
+    steps = DIGITS << segmentCount
+    if failures:
+        sys.stdout.write("%d of %d steps light the wrong LEDs\n" % (failures, steps))
+        return 1
+    sys.stdout.write("%d steps checked, only the intended LEDs light (chains of up to %d LEDs conduct)\n"
+                     % (steps, maxChain))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,904 @@
+#!/usr/bin/env python3
+"""
+Seven Segment Host Checks
+
+Builds the seven segment library for the host with gcc against a stand-in LPC802.h, in which every
+peripheral is a plain struct in RAM, and runs small checks of the parts that can only be tested by
+looking at the registers they write.
+
+Nothing reacts to a register write: a check plays the part of the hardware itself, for example it
+calls sevenSegmentSPIInterrupt each time the SPI would have taken a word, and reads what the library
+wrote after each call. The library reaches the SPI through sevenSegmentSPI, which the checks
+point at a mock register block of their own.
+
+Checks:
+  spi chain      word order of a 74HC595 SPI chain frame, the single EOT that latches the chain,
+                 and the SPI interrupt being turned off once the frame is queued
+  script loops   counted LOOPs nested inside each other, each keeping its own count
+  light trace    auto-dimming fed a light trace through a mock ADC: levels in range and one step at a
+                 time, darkReading and brightReading reaching minLevel and MAX_BRIGHTNESS, and noise on
+                 the edge of a level not making it flicker
+  gpio traces    every GPIO write of display4Numbers, a counter wrapping from 9999 to 0, a continuous
+                 carousel and a padded slider, compared with the golden traces in tools/host_traces,
+                 followed by the writes of each scenario per refresh tick and per frame
+  virtual display a display on sevenSegmentVirtualBackend run by the virtual clock: a frame of
+                 display4Characters drawn by renderSevenSegmentAscii, and each frame a counter, a continuous
+                 carousel and a padded slider show, read back from their drawings
+  stats clock    calls timed by hand on a mock SysTick and a free running MRT channel, some of them
+                 across a reload: count, min, max, total, period and histogram bins of each helper
+  wkt calibration
+                 10% fast and slow oscillator measurements: the 16.16 WKT scale, the WKT counts written for
+                 a display, and a reload of the reference or of the WKT inside the measurement window
+                 dropping the measurement
+
+A recorded trace can replace the built-in one with --light-trace, a CSV file with one ADC reading
+(0..4095) per line in its first column. --verbose prints reading, filtered reading and brightness
+for each sample. --update-golden rewrites the golden traces after a change that is meant to alter the
+GPIO writes, the diff of tools/host_traces then shows what changed.
+
+Needs gcc (or --cc) on the path, nothing from the LPC802 SDK.
+
+Usage: host_check.py [--cc gcc] [--light-trace trace.csv] [--verbose] [--update-golden]
+"""
+
+import argparse
+import os
+import random
+import subprocess
+import sys
+import tempfile
+
+TOOLS_DIR = os.path.dirname(os.path.abspath(__file__))
+SOURCE_DIR = os.path.join(os.path.dirname(TOOLS_DIR), "source")
+GOLDEN_DIR = os.path.join(TOOLS_DIR, "host_traces")
+
+LIBRARY_FILES = ["seven_segment.c", "seven_segment_backend.c", "seven_segment_script.c", "seven_segment_trace.c",
+                 "seven_segment_stats.c", "seven_segment_light.c"]
+
+# Stand-in for the MCUXpresso LPC802.h, only the registers and fields the library uses
+HOST_LPC802_H = r"""
+#ifndef HOST_LPC802_H_
+#define HOST_LPC802_H_
+
+#include <stdint.h>
+
+#define __IO volatile
+#define __I volatile const
+#define __O volatile
+#define __NVIC_PRIO_BITS 2
+
+typedef enum { SysTick_IRQn = -1, SPI0_IRQn = 0, MRT0_IRQn = 10, WKT_IRQn = 15, ADC_SEQA_IRQn = 16,
+	CTIMER0_IRQn = 23 } IRQn_Type;
+
+typedef struct { __IO uint32_t SYSAHBCLKCTRL0, PDRUNCFG, LPOSCCLKEN, PRESETCTRL0, MAINCLKSEL, MAINCLKUEN,
+	PDSLEEPCFG, STARTERP1, PDAWAKECFG, ADCCLKSEL, ADCCLKDIV, FCLKSEL[11]; } SYSCON_Type;
+typedef struct { union { __IO uint32_t PINASSIGN_DATA[10]; struct { __IO uint32_t PINASSIGN0, PINASSIGN1,
+	PINASSIGN2, PINASSIGN3, PINASSIGN4, PINASSIGN5, PINASSIGN6, PINASSIGN7, PINASSIGN8, PINASSIGN9; } PINASSIGN; };
+	__IO uint32_t PINENABLE0; } SWM_Type;
+typedef struct { __IO uint32_t DIR[1], MASK[1], PIN[1], MPIN[1], SET[1]; __O uint32_t CLR[1], NOT[1], DIRSET[1],
+	DIRCLR[1], DIRNOT[1]; } GPIO_Type;
+typedef struct { __IO uint32_t CTRL, COUNT; } WKT_Type;
+typedef struct { struct { __IO uint32_t INTVAL, TIMER, CTRL, STAT; } CHANNEL[4]; __IO uint32_t MODCTRL, IDLE_CH,
+	IRQ_FLAG; } MRT_Type;
+typedef struct { __IO uint32_t IR, TCR, TC, PR, PC, MCR, MR[4]; } CTIMER_Type;
+typedef struct { __IO uint32_t CTRL, LOAD, VAL, CALIB; } SysTick_Type;
+typedef struct { __IO uint32_t CFG, DLY, STAT, INTENSET, INTENCLR, RXDAT, TXDATCTL, TXDAT, TXCTL, DIV,
+	INTSTAT; } SPI_Type;
+typedef struct { __IO uint32_t CTRL, SEQ_CTRL[2], SEQ_GDAT[2], DAT[12], FLAGS; } ADC_Type;
+typedef struct { __IO uint32_t PCON; } PMU_Type;
+typedef struct { __IO uint32_t SCR; } SCB_Type;
+
+extern SYSCON_Type hostSYSCON;
+extern SWM_Type hostSWM0;
+extern GPIO_Type hostGPIO;
+extern WKT_Type hostWKT;
+extern MRT_Type hostMRT0;
+extern CTIMER_Type hostCTIMER0;
+extern SysTick_Type hostSysTick;
+extern SPI_Type hostSPI0;
+extern ADC_Type hostADC0;
+extern PMU_Type hostPMU;
+extern SCB_Type hostSCB;
+#define SYSCON (&hostSYSCON)
+#define SWM0 (&hostSWM0)
+#define GPIO (&hostGPIO)
+#define WKT (&hostWKT)
+#define MRT0 (&hostMRT0)
+#define CTIMER0 (&hostCTIMER0)
+#define SysTick (&hostSysTick)
+#define SPI0 (&hostSPI0)
+#define ADC0 (&hostADC0)
+#define PMU (&hostPMU)
+#define SCB (&hostSCB)
+
+#define SYSCON_SYSAHBCLKCTRL0_SWM_MASK (1u << 7)
+#define SYSCON_SYSAHBCLKCTRL0_GPIO0_MASK (1u << 6)
+#define SYSCON_SYSAHBCLKCTRL0_WKT_MASK (1u << 9)
+#define SYSCON_SYSAHBCLKCTRL0_MRT_MASK (1u << 10)
+#define SYSCON_SYSAHBCLKCTRL0_SPI0_MASK (1u << 11)
+#define SYSCON_SYSAHBCLKCTRL0_ADC_MASK (1u << 24)
+#define SYSCON_SYSAHBCLKCTRL0_CTIMER0_MASK (1u << 25)
+#define SYSCON_PDRUNCFG_ADC_PD_MASK (1u << 4)
+#define SYSCON_PDRUNCFG_LPOSC_PD_MASK (1u << 6)
+#define SYSCON_PDSLEEPCFG_LPOSC_PD_MASK (1u << 6)
+#define SYSCON_LPOSCCLKEN_WKT_MASK (1u << 0)
+#define SYSCON_PRESETCTRL0_WKT_RST_N_MASK (1u << 9)
+#define SYSCON_PRESETCTRL0_MRT_RST_N_MASK (1u << 10)
+#define SYSCON_PRESETCTRL0_SPI0_RST_N_MASK (1u << 11)
+#define SYSCON_PRESETCTRL0_ADC_RST_N_MASK (1u << 24)
+#define SYSCON_PRESETCTRL0_CTIMER0_RST_N_MASK (1u << 25)
+#define SYSCON_STARTERP1_WKT_MASK (1u << 15)
+#define SWM_PINASSIGN3_SPI0_SCK_IO_MASK 0xFF000000u
+#define SWM_PINASSIGN3_SPI0_SCK_IO(x) (((uint32_t)(x)) << 24)
+#define SWM_PINASSIGN4_SPI0_MOSI_IO_MASK 0xFFu
+#define SWM_PINASSIGN4_SPI0_MOSI_IO(x) ((uint32_t)(x))
+#define SWM_PINASSIGN4_SPI0_SSEL0_IO_MASK 0xFF0000u
+#define SWM_PINASSIGN4_SPI0_SSEL0_IO(x) (((uint32_t)(x)) << 16)
+#define SWM_PINENABLE0_ADC_0_MASK (1u << 10)
+#define WKT_CTRL_CLKSEL_MASK 1u
+#define WKT_CTRL_ALARMFLAG_MASK 2u
+#define WKT_CTRL_CLEARCTR_MASK 4u
+#define MRT_CHANNEL_CTRL_MODE_SHIFT 1
+#define MRT_CHANNEL_CTRL_INTEN_MASK 1u
+#define MRT_CHANNEL_INTVAL_LOAD_MASK (1u << 31)
+#define MRT_CHANNEL_INTVAL_IVALUE_MASK 0xFFFFFFu
+#define MRT_CHANNEL_STAT_INTFLAG_MASK 1u
+#define MRT_CHANNEL_TIMER_VALUE_MASK 0xFFFFFFu
+#define CTIMER_IR_MR0INT_MASK 1u
+#define CTIMER_MCR_MR0I_MASK 1u
+#define CTIMER_TCR_CEN_MASK 1u
+#define CTIMER_TCR_CRST_MASK 2u
+#define SysTick_CTRL_ENABLE_Msk 1u
+#define SysTick_CTRL_TICKINT_Msk 2u
+#define SysTick_CTRL_CLKSOURCE_Msk 4u
+#define SysTick_LOAD_RELOAD_Msk 0xFFFFFFu
+#define SysTick_VAL_CURRENT_Msk 0xFFFFFFu
+#define SCB_SCR_SLEEPDEEP_Msk 4u
+#define PMU_PCON_PM(x) ((uint32_t)(x))
+#define SPI_CFG_ENABLE_MASK 1u
+#define SPI_CFG_MASTER_MASK 4u
+#define SPI_CFG_LSBF_MASK 8u
+#define SPI_STAT_TXRDY_MASK 2u
+#define SPI_STAT_ENDTRANSFER_MASK (1u << 7)
+#define SPI_STAT_MSTIDLE_MASK (1u << 8)
+#define SPI_INTENSET_TXRDYEN_MASK 2u
+#define SPI_INTENCLR_TXRDYEN_MASK 2u
+#define SPI_TXDATCTL_TXDAT(x) ((uint32_t)(x) & 0xFFFFu)
+#define SPI_TXDATCTL_TXSSEL0_N_MASK (1u << 16)
+#define SPI_TXDATCTL_EOT_MASK (1u << 20)
+#define SPI_TXDATCTL_RXIGNORE_MASK (1u << 22)
+#define SPI_TXDATCTL_LEN(x) (((uint32_t)(x)) << 24)
+#define SPI_DIV_DIVVAL(x) ((uint32_t)(x))
+#define ADC_CTRL_CLKDIV(x) ((uint32_t)(x))
+#define ADC_SEQ_CTRL_CHANNELS(x) ((uint32_t)(x))
+#define ADC_SEQ_CTRL_START_MASK (1u << 26)
+#define ADC_SEQ_CTRL_SEQ_ENA_MASK (1u << 31)
+#define ADC_DAT_RESULT_MASK 0xFFF0u
+#define ADC_DAT_RESULT_SHIFT 4
+#define ADC_DAT_DATAVALID_MASK (1u << 31)
+
+extern uint32_t SystemCoreClock;
+void NVIC_EnableIRQ(IRQn_Type irq);
+void NVIC_DisableIRQ(IRQn_Type irq);
+uint32_t NVIC_GetEnableIRQ(IRQn_Type irq);
+void NVIC_SetPriority(IRQn_Type irq, uint32_t priority);
+uint32_t NVIC_GetPriority(IRQn_Type irq);
+void NVIC_ClearPendingIRQ(IRQn_Type irq);
+uint32_t SysTick_Config(uint32_t ticks);
+void __disable_irq(void);
+void __enable_irq(void);
+uint32_t __get_PRIMASK(void);
+void __set_PRIMASK(uint32_t primask);
+void __WFI(void);
+void __DSB(void);
+
+#endif
+"""
+
+HOST_CLOCK_CONFIG_H = r"""
+void BOARD_BootClockFRO18M(void);
+"""
+
+# Register blocks and the CMSIS functions of the stand-in, the NVIC is an array of flags
+HOST_PERIPHERALS_C = r"""
+#include "LPC802.h"
+
+SYSCON_Type hostSYSCON;
+SWM_Type hostSWM0;
+GPIO_Type hostGPIO;
+WKT_Type hostWKT;
+MRT_Type hostMRT0;
+CTIMER_Type hostCTIMER0;
+SysTick_Type hostSysTick;
+SPI_Type hostSPI0;
+ADC_Type hostADC0;
+PMU_Type hostPMU;
+SCB_Type hostSCB;
+uint32_t SystemCoreClock = 18000000;
+
+static uint32_t hostIRQEnabled[48];
+static uint32_t hostIRQPriority[48];
+static uint32_t hostPRIMASK;
+// Called on each __disable_irq, lets a check move the timers on between two critical sections
+void (*hostDisableIRQHook)(void);
+
+void NVIC_EnableIRQ(IRQn_Type irq) { hostIRQEnabled[irq + 16] = 1; }
+void NVIC_DisableIRQ(IRQn_Type irq) { hostIRQEnabled[irq + 16] = 0; }
+uint32_t NVIC_GetEnableIRQ(IRQn_Type irq) { return hostIRQEnabled[irq + 16]; }
+void NVIC_SetPriority(IRQn_Type irq, uint32_t priority) { hostIRQPriority[irq + 16] = priority; }
+uint32_t NVIC_GetPriority(IRQn_Type irq) { return hostIRQPriority[irq + 16]; }
+void NVIC_ClearPendingIRQ(IRQn_Type irq) { }
+uint32_t SysTick_Config(uint32_t ticks) {
+	SysTick->LOAD = ticks - 1;
+	SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_TICKINT_Msk | SysTick_CTRL_ENABLE_Msk;
+	return 0;
+}
+void __disable_irq(void) {
+	hostPRIMASK = 1;
+	if (hostDisableIRQHook) {
+		hostDisableIRQHook();
+	}
+}
+void __enable_irq(void) { hostPRIMASK = 0; }
+uint32_t __get_PRIMASK(void) { return hostPRIMASK; }
+void __set_PRIMASK(uint32_t primask) { hostPRIMASK = primask; }
+void __WFI(void) { }
+void __DSB(void) { }
+void BOARD_BootClockFRO18M(void) { }
+"""
+
+# Included at the top of every check, CHECK counts and reports failures
+CHECK_PRELUDE = r"""
+#include <stdio.h>
+#include "LPC802.h"
+#include "seven_segment.h"
+#include "seven_segment_backend.h"
+#include "seven_segment_internal.h"
+
+static int checkFailures = 0;
+#define CHECK(condition, ...) do { if (!(condition)) { checkFailures++; printf("  failed: " __VA_ARGS__); \
+	printf("\n"); } } while (0)
+"""
+
+SPI_CHAIN_CHECK = r"""
+// Backend function, not in a header
+int shiftRegisterWord(SevenSegmentDisplay *display, int digitMask, int segmentBits);
+
+#define CHAIN_LENGTH 3
+static SevenSegmentDisplay chain[CHAIN_LENGTH] = {SEVEN_SEGMENT_DISPLAY_DEFAULTS, SEVEN_SEGMENT_DISPLAY_DEFAULTS,
+	SEVEN_SEGMENT_DISPLAY_DEFAULTS};
+static SPI_Type mockSPI;
+
+// Word of a chain position for the digit the last refresh prepared, words not yet sent carry the latest digit
+static uint32_t expectedWord(int position) {
+	SevenSegmentDisplay *display = &chain[position];
+	int digit = (display->refresh.currentDigit + 3) % 4;
+	return shiftRegisterWord(display, 1 << digit, getSegmentPattern(display->refresh.chrSequence[digit])) & 0xFFFF;
+}
+
+int main(void) {
+	SevenSegmentDisplay *displays[CHAIN_LENGTH] = {&chain[0], &chain[1], &chain[2]};
+	char *texts[CHAIN_LENGTH] = {"1234", "ABCD", "5678"};
+	sevenSegmentSPI = &mockSPI;
+	// The SPI is always ready for the next word and idle, the check calls its interrupt itself
+	mockSPI.STAT = SPI_STAT_TXRDY_MASK | SPI_STAT_MSTIDLE_MASK;
+	setupSevenSegmentSPIChain(displays, CHAIN_LENGTH, SPI_CHAIN_74HC595, 1, 2, 3, 4, "MRT0", 1000);
+	for (int i = 0; i < CHAIN_LENGTH; i++) {
+		display4CharactersCtx(displays[i], texts[i], "MRT0", 1000);
+	}
+	// Finish the blank frame sent by the setup
+	for (int i = 0; i < CHAIN_LENGTH; i++) {
+		sevenSegmentSPIInterrupt();
+	}
+
+	for (int frame = 0; frame < 8; frame++) {
+		mockSPI.INTENSET = 0;
+		mockSPI.INTENCLR = 0;
+		displaySPIChainInterrupt();
+
+		// The far end of the chain goes first, the word of position 0 last
+		for (int position = CHAIN_LENGTH - 1; position >= 0; position--) {
+			uint32_t control = mockSPI.TXDATCTL;
+			uint32_t expected = expectedWord(position);
+			CHECK((control & 0xFFFF) == expected, "frame %d position %d sent %04X, expected %04X",
+					frame, position, (unsigned)(control & 0xFFFF), (unsigned)expected);
+			CHECK((control >> 24 & 0xF) == 15, "frame %d position %d is not a 16 bit word", frame, position);
+			CHECK(((control & SPI_TXDATCTL_EOT_MASK) != 0) == (position == 0),
+					"frame %d position %d EOT %s, SSEL0 must only rise after position 0", frame, position,
+					(control & SPI_TXDATCTL_EOT_MASK) ? "set" : "clear");
+			if (position == CHAIN_LENGTH - 1) {
+				CHECK(mockSPI.INTENSET & SPI_INTENSET_TXRDYEN_MASK, "frame %d did not enable the SPI interrupt", frame);
+				// A refresh while the frame is queued must leave it alone
+				displaySPIChainInterrupt();
+				CHECK(mockSPI.TXDATCTL == control, "frame %d was restarted while still queued", frame);
+			}
+			if (position > 0) {
+				CHECK(mockSPI.INTENCLR == 0, "frame %d turned the SPI interrupt off early", frame);
+				sevenSegmentSPIInterrupt();
+			}
+		}
+		CHECK(mockSPI.INTENCLR & SPI_INTENCLR_TXRDYEN_MASK, "frame %d left the SPI interrupt on", frame);
+		uint32_t last = mockSPI.TXDATCTL;
+		sevenSegmentSPIInterrupt();
+		CHECK(mockSPI.TXDATCTL == last, "frame %d sent a word after position 0", frame);
+	}
+	printf("  8 frames of %d displays\n", CHAIN_LENGTH);
+	return checkFailures != 0;
+}
+"""
+
+SCRIPT_LOOPS_CHECK = r"""
+#include "seven_segment_script.h"
+
+// Runs a script until it finishes, returns the number of steps it took or -1 if it is still running
+static int runScript(SevenSegmentDisplay *display, const uint8_t script[], int length) {
+	setupSevenSegmentScriptCtx(display, script, length, "MRT0", 1000, "MRT1", 1000);
+	for (int step = 1; step <= 200; step++) {
+		sevenSegmentScriptInterruptCtx(display);
+		if (display->scriptFinished) {
+			return step;
+		}
+	}
+	return -1;
+}
+
+int main(void) {
+	static SevenSegmentDisplay display = SEVEN_SEGMENT_DISPLAY_DEFAULTS;
+	// outer: show "ABCD"; inner: wait 1; loop inner 3; loop outer 2; end
+	static const uint8_t nested[] = {
+		SCRIPT_OP_SHOW, 'A', 'B', 'C', 'D',
+		SCRIPT_OP_WAIT, 1,
+		SCRIPT_OP_LOOP, 0x00, 0x05, 3,
+		SCRIPT_OP_LOOP, 0x00, 0x00, 2,
+		SCRIPT_OP_END,
+	};
+	// a: b: c: d: e: wait 1; loop e 2; loop d 2; loop c 2; loop b 2; loop a 2; end, one level too deep
+	static const uint8_t tooDeep[] = {
+		SCRIPT_OP_WAIT, 1,
+		SCRIPT_OP_LOOP, 0x00, 0x00, 2,
+		SCRIPT_OP_LOOP, 0x00, 0x00, 2,
+		SCRIPT_OP_LOOP, 0x00, 0x00, 2,
+		SCRIPT_OP_LOOP, 0x00, 0x00, 2,
+		SCRIPT_OP_LOOP, 0x00, 0x00, 2,
+		SCRIPT_OP_END,
+	};
+	// a: b: c: d: wait 1; loop d 2; loop c 2; loop b 2; loop a 2; end
+	static const uint8_t deepest[] = {
+		SCRIPT_OP_WAIT, 1,
+		SCRIPT_OP_LOOP, 0x00, 0x00, 2,
+		SCRIPT_OP_LOOP, 0x00, 0x00, 2,
+		SCRIPT_OP_LOOP, 0x00, 0x00, 2,
+		SCRIPT_OP_LOOP, 0x00, 0x00, 2,
+		SCRIPT_OP_END,
+	};
+
+	// Each of the 6 WAITs yields once, the END is reached on the step after the last one
+	int steps = runScript(&display, nested, sizeof nested);
+	CHECK(steps == 7, "nested loops took %d steps, expected 7", steps);
+	CHECK(display.scriptLoopDepth == 0, "nested loops left %d counters", display.scriptLoopDepth);
+	printf("  nested loops finished after %d steps\n", steps);
+
+	steps = runScript(&display, deepest, sizeof deepest);
+	CHECK(steps == 17, "%d deep loops took %d steps, expected 17", SCRIPT_MAX_LOOP_DEPTH, steps);
+	printf("  %d deep loops finished after %d steps\n", SCRIPT_MAX_LOOP_DEPTH, steps);
+
+	// Out of counters the script stops the first time the innermost LOOP is reached with all the others
+	// counting, on its 32nd WAIT instead of ending after its last
+	steps = runScript(&display, tooDeep, sizeof tooDeep);
+	CHECK(steps == 32 && display.scriptPc == 2, "%d deep loops stopped after %d steps at %d, expected 32 at 2",
+			SCRIPT_MAX_LOOP_DEPTH + 1, steps, display.scriptPc);
+
+	// A restart in the middle of the loops starts every count again
+	setupSevenSegmentScriptCtx(&display, nested, sizeof nested, "MRT0", 1000, "MRT1", 1000);
+	for (int step = 0; step < 4; step++) {
+		sevenSegmentScriptInterruptCtx(&display);
+	}
+	restartSevenSegmentScriptCtx(&display);
+	steps = 0;
+	while (!display.scriptFinished && steps < 200) {
+		sevenSegmentScriptInterruptCtx(&display);
+		steps++;
+	}
+	CHECK(steps == 7, "nested loops took %d steps after a restart, expected 7", steps);
+	return checkFailures != 0;
+}
+"""
+
+LIGHT_TRACE_CHECK = r"""
+#include "seven_segment_light.h"
+
+static const int16_t lightTrace[] = { LIGHT_TRACE_READINGS };
+static ADC_Type mockADC;
+static SevenSegmentDisplay display = SEVEN_SEGMENT_DISPLAY_DEFAULTS;
+
+// Leaves a conversion result in the channel and refreshes one frame, returns the brightness after it
+static int sampleFrame(int channel, int reading) {
+	mockADC.DAT[channel] = ADC_DAT_DATAVALID_MASK | (uint32_t)reading << ADC_DAT_RESULT_SHIFT;
+	mockADC.SEQ_CTRL[0] = 0;
+	for (int digit = 0; digit < 4; digit++) {
+		display4CharactersInterruptCtx(&display);
+	}
+	CHECK(mockADC.SEQ_CTRL[0] == (ADC_SEQ_CTRL_CHANNELS(1 << channel) | ADC_SEQ_CTRL_SEQ_ENA_MASK
+			| ADC_SEQ_CTRL_START_MASK), "the frame did not start the next conversion");
+	return display.refresh.brightnessLevel;
+}
+
+// Holds one reading until the filter has settled, returns the brightness then
+static int settle(int channel, int reading) {
+	int level = 0;
+	for (int i = 0; i < 12 << SEVEN_SEGMENT_AUTO_DIM_FILTER_SHIFT; i++) {
+		level = sampleFrame(channel, reading);
+	}
+	return level;
+}
+
+int main(void) {
+	int channel = 3, minLevel = 1;
+	sevenSegmentADC = &mockADC;
+	display4CharactersCtx(&display, "8888", "MRT0", 1000);
+	setupSevenSegmentAutoDimCtx(&display, channel, 0, 4095, minLevel, 1);
+
+	// The recorded trace, the brightness must stay in range and only step between neighbouring levels
+	int level = display.refresh.brightnessLevel, changes = 0;
+	for (int i = 0; i < (int)(sizeof lightTrace / sizeof lightTrace[0]); i++) {
+		int next = sampleFrame(channel, lightTrace[i]);
+		CHECK(next >= minLevel && next <= MAX_BRIGHTNESS, "sample %d set brightness %d", i, next);
+		// The first sample sets the filter outright and may jump to any level
+		CHECK(i == 0 || (next - level <= 1 && level - next <= 1), "sample %d jumped from brightness %d to %d", i,
+				level, next);
+		changes += next != level;
+		level = next;
+		if (LIGHT_TRACE_VERBOSE) {
+			printf("  %d,%d,%d\n", lightTrace[i], getSevenSegmentLightReadingCtx(&display), next);
+		}
+	}
+	printf("  %d samples, %d brightness changes\n", (int)(sizeof lightTrace / sizeof lightTrace[0]), changes);
+
+	// The ends of the range reach the ends of the brightness
+	level = settle(channel, 4095);
+	CHECK(level == MAX_BRIGHTNESS, "brightReading gave brightness %d, expected %d", level, MAX_BRIGHTNESS);
+	level = settle(channel, 0);
+	CHECK(level == minLevel, "darkReading gave brightness %d, expected %d", level, minLevel);
+
+	// Noise on the edge between two levels changes the level at most once
+	int edge = (3 << AUTO_DIM_LEVEL_SHIFT) / display.autoDim.levelScale;
+	settle(channel, edge);
+	level = display.refresh.brightnessLevel;
+	changes = 0;
+	for (int i = 0; i < 400; i++) {
+		int next = sampleFrame(channel, edge + ((i * 37) % 121) - 60);
+		changes += next != level;
+		level = next;
+	}
+	CHECK(changes <= 1, "noise of 60 around reading %d changed the brightness %d times", edge, changes);
+
+	// A sensor whose reading falls as the light rises
+	setupSevenSegmentAutoDimCtx(&display, channel, 4095, 0, minLevel, 1);
+	level = settle(channel, 0);
+	CHECK(level == MAX_BRIGHTNESS, "inverted brightReading gave brightness %d, expected %d", level, MAX_BRIGHTNESS);
+	level = settle(channel, 4095);
+	CHECK(level == minLevel, "inverted darkReading gave brightness %d, expected %d", level, minLevel);
+	return checkFailures != 0;
+}
+"""
+
+# Runs the interrupt helpers in a fixed order, shared by the checks that replay scenarios
+VIRTUAL_CLOCK = r"""
+typedef void (*ContentInterrupt)(SevenSegmentDisplay *display);
+
+// The refresh interrupt fires every tick, the content interrupt after the refresh of every contentTicks-th
+// tick, as if its clock ran contentTicks times slower
+static void runVirtualClock(SevenSegmentDisplay *display, int ticks, ContentInterrupt content, int contentTicks) {
+	for (int tick = 1; tick <= ticks; tick++) {
+		display4CharactersInterruptCtx(display);
+		if (content != NULL && tick % contentTicks == 0) {
+			content(display);
+		}
+	}
+}
+"""
+
+GPIO_TRACES_CHECK = r"""
+#include "seven_segment_trace.h"
+
+static const char *traceRegisters[] = {"SET", "CLR", "DIRSET", "DIRCLR"};
+static SevenSegmentDisplay display;
+
+// A display on the GPIOs, set up with the trace recording from the first DIRSET
+static void startScenario(const char *name) {
+	static const SevenSegmentDisplay fresh = SEVEN_SEGMENT_DISPLAY_DEFAULTS;
+	int digits[4] = {10, 11, 12, 13};
+	int segments[7] = {0, 1, 2, 3, 4, 7, 8};
+	display = fresh;
+	clearSevenSegmentTrace();
+	printf("scenario %s\n", name);
+	// Segments first, the pins of a display start at -1 and only its digits may be left at -1
+	sevenSegmentGPIOSetupCtx(&display, segments);
+	digitGPIOSetupCtx(&display, digits);
+}
+
+// Prints every write of the scenario, then its totals
+static void endScenario(void) {
+	CHECK(sevenSegmentTrace.writes <= SEVEN_SEGMENT_TRACE_LENGTH, "%u writes overflowed the trace",
+			(unsigned)sevenSegmentTrace.writes);
+	for (uint32_t i = 0; i < sevenSegmentTrace.writes && i < SEVEN_SEGMENT_TRACE_LENGTH; i++) {
+		SevenSegmentTraceEntry *entry = &sevenSegmentTrace.entries[i];
+		printf("%u %s %08X\n", (unsigned)entry->tick, traceRegisters[entry->reg], (unsigned)entry->mask);
+	}
+	printf("totals %u %u %u\n", (unsigned)sevenSegmentTrace.writes, (unsigned)sevenSegmentTrace.ticks,
+			(unsigned)sevenSegmentTrace.frames);
+}
+
+int main(void) {
+	startScenario("display4Numbers");
+	display4NumbersCtx(&display, 1234, "MRT0", 1000);
+	runVirtualClock(&display, 16, NULL, 1);
+	endScenario();
+
+	// 9998 counts up through 9999 to 0000 and on
+	startScenario("counter wraparound");
+	setupSevenSegmentCounterCtx(&display, 9998, "MRT1", "UP", 1, 0, false, 1000, "MRT0", 1000);
+	runVirtualClock(&display, 24, updateSevenSegmentCounterInterruptCtx, 4);
+	endScenario();
+
+	// Twice round a continuous carousel of 6 screens
+	startScenario("carousel continuous");
+	sevenSegmentDisplayTextCarouselCtx(&display, "HELLO", 5, "MRT1", 1000, true, false, "MRT0", 1000);
+	runVirtualClock(&display, 48, sevenSegmentCarouselInterruptCtx, 4);
+	endScenario();
+
+	// Slides in from a blank screen and out to one
+	startScenario("slider padding");
+	sevenSegmentDisplayTextSliderCtx(&display, "ABC", 3, "MRT1", 1000, false, true, false, "MRT0", 1000);
+	runVirtualClock(&display, 40, sevenSegmentSliderInterruptCtx, 4);
+	endScenario();
+	return checkFailures != 0;
+}
+"""
+
+VIRTUAL_DISPLAY_CHECK = r"""
+#include <string.h>
+
+static SevenSegmentDisplay display;
+
+// A display on the virtual backend, refreshed by the virtual clock instead of a timer
+static void startVirtualDisplay(void) {
+	static const SevenSegmentDisplay fresh = SEVEN_SEGMENT_DISPLAY_DEFAULTS;
+	display = fresh;
+	setSevenSegmentBackendCtx(&display, &sevenSegmentVirtualBackend);
+}
+
+// Reads the characters back from the drawing of the virtual display, '?' for a digit no character draws
+static void readScreen(char screen[5]) {
+	static const char characters[] = " 0123456789AbCdEFGHJLnoPrtUy-";
+	static SevenSegmentDisplay reference;
+	char text[SEVEN_SEGMENT_ASCII_SIZE], drawn[SEVEN_SEGMENT_ASCII_SIZE];
+	renderSevenSegmentAscii(&display, text);
+	for (int digit = 0; digit < 4; digit++) {
+		screen[digit] = '?';
+		for (int i = 0; characters[i] != '\0' && screen[digit] == '?'; i++) {
+			// Draws the character on every place of a second virtual display and compares the digit's columns
+			for (int place = 0; place < 4; place++) {
+				reference.shownSegments[place] = getSegmentPattern(characters[i]);
+			}
+			renderSevenSegmentAscii(&reference, drawn);
+			bool same = true;
+			for (int row = 0; row < 3; row++) {
+				same = same && memcmp(&text[row * 17 + digit * 4], &drawn[row * 17 + digit * 4], 3) == 0;
+			}
+			if (same) {
+				screen[digit] = characters[i];
+			}
+		}
+	}
+	screen[4] = '\0';
+}
+
+// Runs the virtual clock a frame at a time, the content stepping after each, and compares every frame shown
+static void checkFrames(const char *mode, ContentInterrupt content, const char *expected[], int frames) {
+	char screen[5];
+	for (int frame = 0; frame < frames; frame++) {
+		runVirtualClock(&display, 4, content, 4);
+		readScreen(screen);
+		CHECK(strcmp(screen, expected[frame]) == 0, "%s frame %d showed \"%s\", expected \"%s\"", mode, frame, screen,
+				expected[frame]);
+		printf("  %s frame %d: %s\n", mode, frame, screen);
+	}
+}
+
+int main(void) {
+	char text[SEVEN_SEGMENT_ASCII_SIZE];
+
+	// A whole frame of display4Characters, drawn as it would look on the display
+	startVirtualDisplay();
+	display4CharactersCtx(&display, "1234", "MRT0", 1000);
+	runVirtualClock(&display, 4, NULL, 1);
+	renderSevenSegmentAscii(&display, text);
+	CHECK(strcmp(text, "     _   _      \n  |  _|  _| |_| \n  | |_   _|   | \n") == 0, "1234 was drawn as\n%s", text);
+	printf("%s", text);
+
+	startVirtualDisplay();
+	setupSevenSegmentCounterCtx(&display, 9998, "MRT1", "UP", 1, 0, false, 1000, "MRT0", 1000);
+	const char *counter[] = {"9998", "9999", "0000", "0001"};
+	checkFrames("counter", updateSevenSegmentCounterInterruptCtx, counter, 4);
+
+	startVirtualDisplay();
+	sevenSegmentDisplayTextCarouselCtx(&display, "HELLO", 5, "MRT1", 1000, true, false, "MRT0", 1000);
+	// The setup shows the first screen and the first step shows it again, then it moves a character a step
+	const char *carousel[] = {"HELL", "HELL", "ELLo", "LLo ", "Lo H", "o HE", " HEL", "HELL"};
+	checkFrames("carousel", sevenSegmentCarouselInterruptCtx, carousel, 8);
+
+	startVirtualDisplay();
+	sevenSegmentDisplayTextSliderCtx(&display, "ABCDEFG", 7, "MRT1", 1000, false, true, false, "MRT0", 1000);
+	// The blank padding page, then a page a step, staying on the last one
+	const char *slider[] = {"    ", "    ", "AbCd", "EFG ", "EFG "};
+	checkFrames("slider", sevenSegmentSliderInterruptCtx, slider, 5);
+	return checkFailures != 0;
+}
+"""
+
+STATS_CLOCK_CHECK = r"""
+#include "seven_segment_stats.h"
+
+// The stats clock counts down, so the check sets the count left at the start and end of each call
+static void timeCall(int helper, uint32_t *counter, uint32_t startCount, uint32_t endCount) {
+	*counter = startCount;
+	uint32_t start = startHelperStats(helper);
+	*counter = endCount;
+	endHelperStats(helper, start);
+}
+
+static void checkStats(const char *clock, int helper, uint32_t count, uint32_t minCycles, uint32_t maxCycles,
+		uint32_t totalCycles, uint32_t minPeriod, uint32_t maxPeriod, const uint32_t histogram[]) {
+	const SevenSegmentHelperStats *stats = &getSevenSegmentStats()->helpers[helper];
+	CHECK(stats->count == count, "%s counted %u calls, expected %u", clock, (unsigned)stats->count, (unsigned)count);
+	CHECK(stats->minCycles == minCycles && stats->maxCycles == maxCycles, "%s min %u max %u, expected %u and %u",
+			clock, (unsigned)stats->minCycles, (unsigned)stats->maxCycles, (unsigned)minCycles, (unsigned)maxCycles);
+	CHECK(stats->totalCycles == totalCycles, "%s total %u, expected %u", clock, (unsigned)stats->totalCycles,
+			(unsigned)totalCycles);
+	CHECK(stats->minPeriod == minPeriod && stats->maxPeriod == maxPeriod,
+			"%s periods %u..%u, expected %u..%u", clock, (unsigned)stats->minPeriod, (unsigned)stats->maxPeriod,
+			(unsigned)minPeriod, (unsigned)maxPeriod);
+	for (int bin = 0; bin < SEVEN_SEGMENT_STATS_BINS; bin++) {
+		CHECK(stats->histogram[bin] == histogram[bin], "%s bin %d holds %u calls, expected %u", clock, bin,
+				(unsigned)stats->histogram[bin], (unsigned)histogram[bin]);
+	}
+	printf("  %s: %u calls, %u..%u cycles, periods %u..%u\n", clock, (unsigned)stats->count,
+			(unsigned)stats->minCycles, (unsigned)stats->maxCycles, (unsigned)stats->minPeriod, (unsigned)stats->maxPeriod);
+}
+
+int main(void) {
+	// An application SysTick already running with a 1000 cycle period is read as it is
+	SysTick->LOAD = 999;
+	SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_ENABLE_Msk;
+	setupSevenSegmentStats("SysTick");
+	CHECK(SysTick->LOAD == 999, "the stats changed the running SysTick's reload to %u", (unsigned)SysTick->LOAD);
+	timeCall(STATS_REFRESH, (uint32_t *)&SysTick->VAL, 900, 880);		// 20 cycles
+	timeCall(STATS_REFRESH, (uint32_t *)&SysTick->VAL, 600, 500);		// 100 cycles, 300 after the last start
+	timeCall(STATS_REFRESH, (uint32_t *)&SysTick->VAL, 50, 900);		// 150 cycles across the reload, 550 after the last start
+	timeCall(STATS_REFRESH, (uint32_t *)&SysTick->VAL, 700, 100);		// 600 cycles, 350 after the last start across the reload
+	// Bins hold calls under 64, 128, 256, 512, 1024 ... cycles
+	static const uint32_t sysTickBins[SEVEN_SEGMENT_STATS_BINS] = {1, 1, 1, 0, 1};
+	checkStats("SysTick", STATS_REFRESH, 4, 20, 600, 870, 300, 550, sysTickBins);
+
+	// A free running MRT channel turns every 0xFFFFFF cycles, a call longer than the last bin's limit lands in it
+	setupSevenSegmentStats("MRT1");
+	CHECK((MRT0->CHANNEL[1].INTVAL & MRT_CHANNEL_INTVAL_IVALUE_MASK) == 0xFFFFFF, "MRT1 was not started free running");
+	timeCall(STATS_SPI, (uint32_t *)&MRT0->CHANNEL[1].TIMER, 100, 0xFFFFFF - 5000);	// 5100 cycles across the reload
+	timeCall(STATS_SPI, (uint32_t *)&MRT0->CHANNEL[1].TIMER, 0xFFFFFF - 6000, 0xFFFFFF - 6010);	// 10 cycles
+	static const uint32_t mrtBins[SEVEN_SEGMENT_STATS_BINS] = {[0] = 1, [SEVEN_SEGMENT_STATS_BINS - 1] = 1};
+	checkStats("MRT1", STATS_SPI, 2, 10, 5100, 5110, 6100, 6100, mrtBins);
+	CHECK(getSevenSegmentStats()->helpers[STATS_REFRESH].count == 0, "picking MRT1 kept the SysTick stats");
+	return checkFailures != 0;
+}
+"""
+
+WKT_CALIBRATION_CHECK = r"""
+// Called by the stand-in __disable_irq, so the timers move on between the critical sections of the calibration
+extern void (*hostDisableIRQHook)(void);
+
+static SevenSegmentDisplay display = SEVEN_SEGMENT_DISPLAY_DEFAULTS;
+// Ticks of the low power oscillator and cycles of the system clock between two readings of the timers
+static uint32_t lpoPerStep, cyclesPerStep;
+// Count a display's interrupt reloads the WKT with once it runs out, the free running WKT never does
+static uint32_t wktReload;
+
+static void advanceTimers(void) {
+	uint32_t timer = MRT0->CHANNEL[1].TIMER;
+	MRT0->CHANNEL[1].TIMER = timer >= cyclesPerStep ? timer - cyclesPerStep : timer + MRT_CHANNEL_TIMER_VALUE_MASK - cyclesPerStep;
+	WKT->COUNT = WKT->COUNT > lpoPerStep ? WKT->COUNT - lpoPerStep : WKT->COUNT + wktReload - lpoPerStep;
+}
+
+// Calibrates against MRT1 with the reference starting at referenceStart, returns the result of calibrateSevenSegmentWKT
+static bool calibrate(uint32_t lpoHz, uint32_t referenceStart) {
+	lpoPerStep = lpoHz / 1000;
+	cyclesPerStep = SystemCoreClock / 1000;
+	MRT0->CHANNEL[1].TIMER = referenceStart;
+	hostDisableIRQHook = advanceTimers;
+	bool stored = calibrateSevenSegmentWKT("MRT1", 10000);
+	hostDisableIRQHook = 0;
+	return stored;
+}
+
+int main(void) {
+	// Pairs of oscillator ticks and system clock cycles 10% fast, 10% slow, and too far off to be trusted
+	CHECK(setSevenSegmentWKTMeasurement(11000, 180000), "a 1.1 MHz measurement was refused");
+	CHECK(sevenSegmentWKTScale == 72090, "1.1 MHz gave scale %u, expected 72090 (1.1 in 16.16)",
+			(unsigned)sevenSegmentWKTScale);
+	CHECK(getWKTCount(1000) == 1100, "1000 nominal ticks at 1.1 MHz gave a count of %u", (unsigned)getWKTCount(1000));
+	CHECK(setSevenSegmentWKTMeasurement(9000, 180000), "a 0.9 MHz measurement was refused");
+	CHECK(sevenSegmentWKTScale == 58982, "0.9 MHz gave scale %u, expected 58982 (0.9 in 16.16)",
+			(unsigned)sevenSegmentWKTScale);
+	CHECK(getWKTCount(1000) == 900, "1000 nominal ticks at 0.9 MHz gave a count of %u", (unsigned)getWKTCount(1000));
+	CHECK(getWKTCount(1) == 1, "1 nominal tick at 0.9 MHz gave a count of %u", (unsigned)getWKTCount(1));
+	CHECK(!setSevenSegmentWKTMeasurement(4000, 180000) && !setSevenSegmentWKTMeasurement(0, 180000)
+			&& sevenSegmentWKTScale == 58982, "a measurement off by more than a factor 2 changed the scale");
+
+	// The free running WKT measured against MRT1, 10000 ticks at 1.1 MHz take 10 readings
+	CHECK(calibrate(1100000, MRT_CHANNEL_TIMER_VALUE_MASK), "calibrating a 1.1 MHz oscillator failed");
+	CHECK(sevenSegmentWKTScale == 72090, "calibration gave scale %u, expected 72090", (unsigned)sevenSegmentWKTScale);
+	// The 16.16 scale resolves the frequency to about 15 Hz
+	CHECK(getSevenSegmentWKTClockHz() == 1100006, "calibrated to %d Hz, expected 1100006", getSevenSegmentWKTClockHz());
+
+	// A reference reload inside the measurement window drops it
+	CHECK(!calibrate(900000, 5 * SystemCoreClock / 1000), "a measurement across the reference's reload was kept");
+	CHECK(sevenSegmentWKTScale == 72090, "the dropped measurement changed the scale to %u",
+			(unsigned)sevenSegmentWKTScale);
+
+	// Counts written for a display on the WKT are rescaled, by the setup and by each interrupt
+	display4CharactersCtx(&display, "8888", "WKT", 1000);
+	CHECK(WKT->COUNT == 1100, "the WKT was started with a count of %u, expected 1100", (unsigned)WKT->COUNT);
+	WKT->COUNT = 0;
+	display4CharactersInterruptCtx(&display);
+	CHECK(WKT->COUNT == 1100, "the interrupt reloaded the WKT with %u, expected 1100", (unsigned)WKT->COUNT);
+
+	// The display's interrupt reloading the WKT inside the measurement window drops it too
+	wktReload = 1100;
+	CHECK(!calibrate(900000, MRT_CHANNEL_TIMER_VALUE_MASK), "a measurement across the WKT's reload was kept");
+	CHECK(sevenSegmentWKTScale == 72090, "the dropped measurement changed the scale to %u",
+			(unsigned)sevenSegmentWKTScale);
+
+	// A display period longer than the measurement leaves it valid
+	display4CharactersCtx(&display, "8888", "WKT", 20000);
+	wktReload = WKT->COUNT;
+	CHECK(calibrate(900000, MRT_CHANNEL_TIMER_VALUE_MASK), "calibrating next to a slow WKT display failed");
+	CHECK(sevenSegmentWKTScale == 58982, "calibration gave scale %u, expected 58982", (unsigned)sevenSegmentWKTScale);
+	printf("  scale %u, %d Hz\n", (unsigned)sevenSegmentWKTScale, getSevenSegmentWKTClockHz());
+	return checkFailures != 0;
+}
+"""
+
+
+def defaultLightTrace():
+    """A day in front of a window, one reading per sample: night, a lamp, dawn, a passing cloud and dusk"""
+    noise = random.Random(802)
+    levels = [(40, 180), (30, 1400), (120, 3900), (30, 2600), (60, 4095), (120, 200)]
+    trace, reading = [], 180
+    for samples, target in levels:
+        for _ in range(samples):
+            reading += (target - reading) // 8
+            trace.append(max(0, min(4095, reading + noise.randint(-40, 40))))
+    return trace
+
+
+def readLightTrace(path):
+    """Readings from the first column of a CSV file, lines that do not start with a number are skipped"""
+    trace = []
+    with open(path) as traceFile:
+        for line in traceFile:
+            field = line.split(",")[0].strip()
+            if field.isdigit():
+                trace.append(min(4095, int(field)))
+    if not trace:
+        raise SystemExit("%s has no readings" % path)
+    return trace
+
+
+def splitScenarios(output):
+    """Lines printed for each scenario, keyed by its name, without the failures CHECK reports"""
+    scenarios, lines = {}, None
+    for line in output.splitlines():
+        if line.startswith("scenario "):
+            lines = scenarios.setdefault(line[len("scenario "):], [])
+        elif lines is not None and not line.startswith("  "):
+            lines.append(line)
+    return scenarios
+
+
+def compareTraces(args, output):
+    """Compares each scenario's trace with its golden file, returns whether they all match and the write counts"""
+    passed = True
+    report = ["  %-22s %7s %6s %6s %9s %10s" % ("scenario", "writes", "ticks", "frames", "per tick", "per frame")]
+    for name, lines in splitScenarios(output).items():
+        writes, ticks, frames = (int(field) for field in lines[-1].split()[1:])
+        report.append("  %-22s %7d %6d %6d %9.2f %10.2f" % (name, writes, ticks, frames, writes / max(ticks, 1),
+                                                          writes / max(frames, 1)))
+        golden = os.path.join(GOLDEN_DIR, name.replace(" ", "_") + ".trace")
+        if args.updateGolden:
+            writeFile(golden, "\n".join(lines) + "\n")
+            continue
+        if not os.path.exists(golden):
+            report.append("  %s: no golden trace, run with --update-golden" % name)
+            passed = False
+            continue
+        with open(golden) as goldenFile:
+            expected = goldenFile.read().splitlines()
+        if lines != expected:
+            line = next(i for i in range(max(len(lines), len(expected)))
+                        if i >= len(lines) or i >= len(expected) or lines[i] != expected[i])
+            report.append("  %s: line %d is %r, %s has %r" % (name, line + 1, lines[line] if line < len(lines) else "",
+                                                            os.path.basename(golden),
+                                                            expected[line] if line < len(expected) else ""))
+            passed = False
+    return passed, report
+
+# (check, extra defines, code after the prelude, function checking its output or None)
+CHECKS = [
+    ("spi chain", [], SPI_CHAIN_CHECK, None),
+    ("script loops", [], SCRIPT_LOOPS_CHECK, None),
+    ("light trace", ["SEVEN_SEGMENT_AUTO_DIM"], LIGHT_TRACE_CHECK, None),
+    ("gpio traces", ["SEVEN_SEGMENT_TRACE", "SEVEN_SEGMENT_TRACE_LENGTH=1024"], VIRTUAL_CLOCK + GPIO_TRACES_CHECK,
+     compareTraces),
+    ("virtual display", [], VIRTUAL_CLOCK + VIRTUAL_DISPLAY_CHECK, None),
+    ("stats clock", ["SEVEN_SEGMENT_STATS"], STATS_CLOCK_CHECK, None),
+    ("wkt calibration", [], WKT_CALIBRATION_CHECK, None),
+]
+
+
+def writeFile(path, text):
+    with open(path, "w") as outputFile:
+        outputFile.write(text)
+
+
+def runCheck(args, workDir, name, defines, code, checkOutput):
+    """Builds and runs one check, returns True if it passed"""
+    harness = os.path.join(workDir, name.replace(" ", "_") + ".c")
+    binary = harness[:-2]
+    code = code.replace("LIGHT_TRACE_READINGS", ", ".join(str(reading) for reading in args.lightTrace))
+    code = code.replace("LIGHT_TRACE_VERBOSE", "1" if args.verbose else "0")
+    writeFile(harness, CHECK_PRELUDE + code)
+    command = [args.cc, "-std=gnu99", "-w", "-I", workDir, "-I", SOURCE_DIR]
+    command += ["-D" + define for define in defines]
+    command += [os.path.join(SOURCE_DIR, source) for source in LIBRARY_FILES]
+    command += [os.path.join(workDir, "host_peripherals.c"), harness, "-o", binary]
+    build = subprocess.run(command, capture_output=True, text=True)
+    if build.returncode != 0:
+        sys.stdout.write("%-16s build failed\n%s" % (name, build.stderr))
+        return False
+    run = subprocess.run([binary], capture_output=True, text=True)
+    passed = run.returncode == 0
+    report = []
+    if checkOutput is not None:
+        outputPassed, report = checkOutput(args, run.stdout)
+        passed = passed and outputPassed
+    sys.stdout.write("%-16s %s\n" % (name, "ok" if passed else "FAILED"))
+    if args.verbose or not passed:
+        sys.stdout.write(run.stdout)
+    for line in report:
+        sys.stdout.write(line + "\n")
+    return passed
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--cc", default="gcc", help="host compiler, default gcc")
+    parser.add_argument("--light-trace", dest="lightTraceFile", help="CSV of ADC readings for the light trace check")
+    parser.add_argument("--verbose", action="store_true", help="print the output of the checks that pass")
+    parser.add_argument("--update-golden", dest="updateGolden", action="store_true",
+                        help="rewrite the golden GPIO traces from this build instead of comparing with them")
+    args = parser.parse_args()
+    args.lightTrace = readLightTrace(args.lightTraceFile) if args.lightTraceFile else defaultLightTrace()
+
+    failures = 0
+    with tempfile.TemporaryDirectory() as workDir:
+        writeFile(os.path.join(workDir, "LPC802.h"), HOST_LPC802_H)
+        writeFile(os.path.join(workDir, "clock_config.h"), HOST_CLOCK_CONFIG_H)
+        writeFile(os.path.join(workDir, "host_peripherals.c"), HOST_PERIPHERALS_C)
+        for name, defines, code, checkOutput in CHECKS:
+            if not runCheck(args, workDir, name, defines, code, checkOutput):
+                failures += 1
+    return 1 if failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,504 @@
+#!/usr/bin/env python3
+"""
+Interrupt Helper Cycle Benchmark
+
+Cross compiles the seven segment library for the Cortex-M0+ with arm-none-eabi-gcc, runs the
+interrupt helpers under the unicorn emulator and reports the cycles each call costs.
+
+Each scenario runs a setup function from the harness below once, then calls one interrupt helper
+repeatedly, the same way the timer interrupt would. Every call is timed separately and the
+min/avg/max are reported, together with the highest rate the helper could be called at if it had
+the core to itself.
+
+Peripherals are plain memory: register writes cost what a store costs and nothing reacts to them.
+Cycles are counted per instruction with the Cortex-M0+ timings (Cortex-M0+ TRM, instruction set
+summary), so they are core cycles with zero wait state memory. --flash-wait adds the given number
+of cycles to each taken branch and each load from flash, a rough model of the LPC802 flash wait
+state above 15 MHz.
+
+The results are compared with tools/isr_cycles_baseline.json, a scenario whose average grows by
+more than --tolerance percent fails the run. A run without the file fails too, --update-baseline
+records it (or rewrites it after an intended change) and the file is then committed.
+
+--check-timings only checks the cycle table: it assembles a list of Thumb instructions with llvm-mc
+and compares the cycles counted for each encoding with the TRM. It needs neither
+arm-none-eabi-gcc nor unicorn.
+
+An energy model follows: for each display mode the interrupt rates of its clocks and the measured
+cycles give the time the core is awake each second, the rest is spent in sevenSegmentIdle, in
+deep-sleep when the WKT is the only clock and in sleep otherwise. --wake-us adds the deep-sleep
+wake-up time to every interrupt, and --run-ma/--sleep-ma/--deep-sleep-ma turn the times into an
+average current, take them from the datasheet for the part and clock.
+
+Needs arm-none-eabi-gcc on the path, the unicorn Python module (pip install unicorn) and the
+MCUXpresso LPC802 device and CMSIS headers, passed with -I.
+
+Usage: isr_cycles.py -I path/to/LPC802/device -I path/to/CMSIS -I path/to/board
+                     [--opt -Os] [--clock 18000000] [--flash-wait 0] [--update-baseline]
+                     [--wake-us 0] [--run-ma X --sleep-ma Y --deep-sleep-ma Z]
+       isr_cycles.py --check-timings [--llvm-mc llvm-mc]
+"""
+
+import argparse
+import glob
+import json
+import os
+import struct
+import subprocess
+import sys
+import tempfile
+
+TOOLS_DIR = os.path.dirname(os.path.abspath(__file__))
+SOURCE_DIR = os.path.join(os.path.dirname(TOOLS_DIR), "source")
+BASELINE_FILE = os.path.join(TOOLS_DIR, "isr_cycles_baseline.json")
+
+# LPC802 memory map, flash and RAM are larger than the part so unoptimised builds still fit
+FLASH_BASE, FLASH_SIZE = 0x00000000, 0x40000
+RAM_BASE, RAM_SIZE = 0x10000000, 0x10000
+PERIPHERAL_REGIONS = [
+    (0x40000000, 0x100000),    # APB peripherals: WKT, MRT, SWM, CTIMER0, SYSCON, SPI0 ...
+    (0xA0000000, 0x10000),     # GPIO
+    (0xE0000000, 0x100000),    # SysTick, NVIC and SCB
+]
+
+# Setup functions called once before a scenario, the display is wired as in EECS3215_7_Segment_Example.c
+HARNESS = r"""
+#include "LPC802.h"
+#include "seven_segment.h"
+
+static int benchChannels[] = {7, 1, 0, 14};
+static int benchSegments[] = {15, 11, 10, 9, 8, 17, 13};
+
+static void benchWire(void) {
+	sevenSegmentFullSetup(benchChannels, benchSegments, 16);
+}
+
+void benchSetupCharacters(void) {
+	benchWire();
+	display4Characters("AB12", "MRT0", 55000);
+}
+
+void benchSetupCharactersWKT(void) {
+	benchWire();
+	display4Characters("AB12", "WKT", 2500);
+}
+
+void benchSetupCharactersDimmed(void) {
+	benchWire();
+	setSevenSegmentBrightness(5);
+	setSevenSegmentBlink(0x3, 0x1, 50);
+	display4Characters("AB12", "MRT0", 55000);
+}
+
+void benchSetupCounterUp(void) {
+	benchWire();
+	setupSevenSegmentCounter(0, "WKT", "UP", 1, 0, false, 850000, "MRT0", 55000);
+}
+
+void benchSetupCounterDown(void) {
+	benchWire();
+	setupSevenSegmentCounter(9999, "WKT", "DOWN", 7, 0, false, 850000, "MRT0", 55000);
+}
+
+void benchSetupCarousel(void) {
+	benchWire();
+	sevenSegmentDisplayTextCarousel("HELLO WORLD", 11, "WKT", 850000, true, true, "MRT0", 55000);
+}
+
+void benchSetupSlider(void) {
+	benchWire();
+	sevenSegmentDisplayTextSlider("EEC53215 i5  fun", 16, "WKT", 850000, true, true, true, "MRT0", 55000);
+}
+
+// Return address of every call, the emulator stops when it gets here
+void benchReturn(void) {
+	for (;;) {
+	}
+}
+"""
+
+LINKER_SCRIPT = """
+ENTRY(benchReturn)
+MEMORY {
+	FLASH (rx) : ORIGIN = 0x%08X, LENGTH = 0x%X
+	RAM (rwx) : ORIGIN = 0x%08X, LENGTH = 0x%X
+}
+SECTIONS {
+	.text : { *(.text*) *(.rodata*) } > FLASH
+	.data : { *(.data*) } > RAM
+	.bss (NOLOAD) : { *(.bss*) *(COMMON) } > RAM
+	end = .;
+}
+""" % (FLASH_BASE, FLASH_SIZE, RAM_BASE, RAM_SIZE)
+
+# (scenario, setup function, interrupt helper, calls)
+SCENARIOS = [
+    ("characters", "benchSetupCharacters", "display4CharactersInterrupt", 64),
+    ("characters dimmed+blink", "benchSetupCharactersDimmed", "display4CharactersInterrupt", 256),
+    ("characters WKT", "benchSetupCharactersWKT", "display4CharactersInterrupt", 64),
+    ("counter up", "benchSetupCounterUp", "updateSevenSegmentCounterInterrupt", 1200),
+    ("counter down", "benchSetupCounterDown", "updateSevenSegmentCounterInterrupt", 1200),
+    ("carousel", "benchSetupCarousel", "sevenSegmentCarouselInterrupt", 64),
+    ("slider", "benchSetupSlider", "sevenSegmentSliderInterrupt", 64),
+]
+
+# Display modes of the energy model: (mode, [(scenario, clock, rate)]) with the rates of the harness
+ENERGY_MODES = [
+    ("characters", [("characters", "MRT0", 55000)]),
+    ("characters dimmed+blink", [("characters dimmed+blink", "MRT0", 55000)]),
+    ("characters, WKT refresh", [("characters WKT", "WKT", 2500)]),
+    ("counter", [("characters", "MRT0", 55000), ("counter up", "WKT", 850000)]),
+    ("carousel", [("characters", "MRT0", 55000), ("carousel", "WKT", 850000)]),
+    ("slider", [("characters", "MRT0", 55000), ("slider", "WKT", 850000)]),
+]
+
+# The WKT counts the 1 MHz low power oscillator, the other clocks count the core clock
+WKT_CLOCK_HZ = 1000000
+
+# Exception entry latency of the Cortex-M0+, the return is taken to cost the same
+EXCEPTION_CYCLES = 15 + 15
+
+
+class BuildError(Exception):
+    pass
+
+
+def build(workDir, includes, defines, opt):
+    harness = os.path.join(workDir, "bench_harness.c")
+    linkerScript = os.path.join(workDir, "bench.ld")
+    elf = os.path.join(workDir, "bench.elf")
+    with open(harness, "w") as harnessFile:
+        harnessFile.write(HARNESS)
+    with open(linkerScript, "w") as linkerFile:
+        linkerFile.write(LINKER_SCRIPT)
+
+    sources = sorted(glob.glob(os.path.join(SOURCE_DIR, "seven_segment*.c"))) + [harness]
+    command = ["arm-none-eabi-gcc", "-mcpu=cortex-m0plus", "-mthumb", opt, "-ffunction-sections",
+               "-fdata-sections", "-nostartfiles", "--specs=nano.specs", "--specs=nosys.specs",
+               "-Wl,--gc-sections", "-Wl,--undefined=benchReturn", "-T", linkerScript, "-I", SOURCE_DIR]
+    for include in includes:
+        command += ["-I", include]
+    for define in defines:
+        command.append("-D" + define)
+    for _, setup, helper, _ in SCENARIOS:
+        command.append("-Wl,--undefined=%s,--undefined=%s" % (setup, helper))
+    command += sources + ["-o", elf, "-lgcc"]
+    try:
+        result = subprocess.run(command, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, universal_newlines=True)
+    except FileNotFoundError:
+        raise BuildError("arm-none-eabi-gcc not found, --check-timings checks the cycle table without it\n")
+    if result.returncode != 0:
+        raise BuildError(result.stdout)
+    return elf
+
+
+def readSymbols(elf):
+    output = subprocess.run(["arm-none-eabi-nm", elf], stdout=subprocess.PIPE, universal_newlines=True,
+                            check=True).stdout
+    symbols = {}
+    for line in output.splitlines():
+        parts = line.split()
+        if len(parts) == 3:
+            symbols[parts[2]] = int(parts[0], 16)
+    return symbols
+
+
+def loadSegments(elf):
+    """(address, bytes, memory size) of each PT_LOAD segment of a 32 bit little endian ELF."""
+    with open(elf, "rb") as elfFile:
+        data = elfFile.read()
+    phoff, = struct.unpack_from("<I", data, 0x1C)
+    phentsize, phnum = struct.unpack_from("<HH", data, 0x2A)
+    segments = []
+    for i in range(phnum):
+        pType, offset, vaddr, _, filesz, memsz = struct.unpack_from("<IIIIII", data, phoff + i * phentsize)
+        if pType == 1:
+            segments.append((vaddr, data[offset:offset + filesz], memsz))
+    return segments
+
+
+def popcount(value):
+    return bin(value).count("1")
+
+
+def instructionCycles(halfword, nextHalfword, multiplyCycles):
+    """
+    Cycles for one Thumb instruction on the Cortex-M0+ as (cycles, size, kind)
+    kind is "cond" for conditional branches, which take one more cycle when taken,
+    "load" for loads, which pay the flash wait state when they read flash, otherwise None
+    """
+    top5 = halfword >> 11
+    if top5 in (0x1D, 0x1E, 0x1F):
+        # 32 bit: BL, MSR, MRS, DMB, DSB, ISB all take 3
+        return 3, 4, None
+    if (halfword & 0xFFC0) == 0x4340:
+        return multiplyCycles, 2, None
+    if (halfword & 0xFF00) == 0x4700:
+        # BX, BLX
+        return 2, 2, None
+    if (halfword & 0xFC00) == 0x4400:
+        # ADD/MOV of high registers, a write to the PC is a branch
+        rd = ((halfword >> 4) & 0x8) | (halfword & 0x7)
+        if (halfword & 0x0300) != 0x0100 and rd == 15:
+            return 2, 2, None
+        return 1, 2, None
+    if top5 == 0x09 or (halfword >> 12) in (0x5, 0x6, 0x7, 0x8, 0x9):
+        # LDR literal, register and immediate offset loads and stores
+        isLoad = top5 == 0x09 or ((halfword >> 12) == 0x5 and (halfword & 0x0E00) >= 0x0600) \
+            or ((halfword >> 12) != 0x5 and halfword & 0x0800)
+        return 2, 2, "load" if isLoad else None
+    if (halfword & 0xF600) == 0xB400:
+        # PUSH, POP, bit 8 is LR for PUSH and PC for POP
+        registers = popcount(halfword & 0x1FF)
+        if (halfword & 0x0800) and (halfword & 0x0100):
+            return 3 + registers, 2, None
+        return 1 + registers, 2, None
+    if (halfword >> 12) == 0xC:
+        # STM, LDM
+        return 1 + popcount(halfword & 0xFF), 2, "load" if halfword & 0x0800 else None
+    if (halfword >> 12) == 0xD and ((halfword >> 8) & 0xF) < 0xE:
+        return 1, 2, "cond"
+    if top5 == 0x1C:
+        return 2, 2, None
+    return 1, 2, None
+
+
+# Cycles of the Cortex-M0+ TRM instruction set summary, with a single cycle multiplier, as
+# (instruction, cycles, kind) for --check-timings, a taken conditional branch adds one more
+TIMING_CHECKS = [
+    ("movs r0, #1", 1, None),
+    ("adds r0, r1, r2", 1, None),
+    ("lsls r0, r1, #2", 1, None),
+    ("add sp, #8", 1, None),
+    ("mov r8, r1", 1, None),
+    ("add r1, pc", 1, None),
+    ("uxtb r0, r1", 1, None),
+    ("muls r0, r1, r0", 1, None),
+    ("cpsid i", 1, None),
+    ("wfi", 1, None),
+    ("mov pc, r1", 2, None),
+    ("bx lr", 2, None),
+    ("blx r3", 2, None),
+    ("b #8", 2, None),
+    ("beq #4", 1, "cond"),
+    ("bl #16", 3, None),
+    ("ldr r0, [r1, #4]", 2, "load"),
+    ("ldr r0, [pc, #8]", 2, "load"),
+    ("ldr r0, [sp, #4]", 2, "load"),
+    ("ldrb r0, [r1, r2]", 2, "load"),
+    ("ldrsh r0, [r1, r2]", 2, "load"),
+    ("ldrh r0, [r1, #2]", 2, "load"),
+    ("str r0, [r1]", 2, None),
+    ("str r0, [sp, #4]", 2, None),
+    ("strh r0, [r1, r2]", 2, None),
+    ("strb r0, [r1, #1]", 2, None),
+    ("push {r4, r5, lr}", 4, None),
+    ("pop {r4, r5}", 3, None),
+    ("pop {r4, pc}", 5, None),
+    ("stm r0!, {r1, r2}", 3, None),
+    ("ldm r0!, {r1, r2, r3}", 4, "load"),
+    ("mrs r0, primask", 3, None),
+    ("msr primask, r0", 3, None),
+    ("dsb sy", 3, None),
+    ("isb sy", 3, None),
+]
+
+
+def checkTimings(llvmMc):
+    """Assembles TIMING_CHECKS and compares instructionCycles with the TRM, returns the mismatches"""
+    source = "\n".join(instruction for instruction, _, _ in TIMING_CHECKS) + "\n"
+    try:
+        result = subprocess.run([llvmMc, "--triple=thumbv6m-none-eabi", "-mcpu=cortex-m0plus", "-show-encoding"],
+                                input=source, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, universal_newlines=True)
+    except FileNotFoundError:
+        raise BuildError("%s not found\n" % llvmMc)
+    if result.returncode != 0:
+        raise BuildError(result.stdout)
+    encodings = [line.split("encoding: [")[1].rstrip("]") for line in result.stdout.splitlines()
+                 if "encoding: [" in line]
+    failures = 0
+    sys.stdout.write("%-24s %-22s %3s %7s\n" % ("instruction", "encoding", "TRM", "counted"))
+    for (instruction, cycles, kind), encoding in zip(TIMING_CHECKS, encodings):
+        code = bytes(int(byte, 16) for byte in encoding.split(",")) + bytes(4)
+        halfword, nextHalfword = struct.unpack_from("<HH", code)
+        counted, size, countedKind = instructionCycles(halfword, nextHalfword, 1)
+        ok = counted == cycles and countedKind == kind and size == len(encoding.split(","))
+        if not ok:
+            failures += 1
+        sys.stdout.write("%-24s %-22s %3d %7d %s\n" % (instruction, encoding, cycles, counted, "" if ok else "FAIL"))
+    return failures
+
+
+class CycleCounter:
+    def __init__(self, uc, multiplyCycles, flashWait):
+        self.uc = uc
+        self.multiplyCycles = multiplyCycles
+        self.flashWait = flashWait
+        self.cycles = 0
+        self.expectedNext = None
+        self.pendingCond = False
+
+    def onCode(self, uc, address, size, userData):
+        if self.expectedNext is not None and address != self.expectedNext:
+            if self.pendingCond:
+                self.cycles += 1
+            self.cycles += self.flashWait
+        code = bytes(uc.mem_read(address, 4))
+        halfword, nextHalfword = struct.unpack("<HH", code)
+        cycles, instructionSize, kind = instructionCycles(halfword, nextHalfword, self.multiplyCycles)
+        self.cycles += cycles
+        self.pendingCond = kind == "cond"
+        self.expectedNext = address + instructionSize
+
+    def onRead(self, uc, access, address, size, value, userData):
+        if address < FLASH_BASE + FLASH_SIZE:
+            self.cycles += self.flashWait
+
+    def reset(self):
+        self.cycles = 0
+        self.expectedNext = None
+        self.pendingCond = False
+
+
+def runScenarios(elf, multiplyCycles, flashWait):
+    import unicorn
+    from unicorn import arm_const
+
+    symbols = readSymbols(elf)
+    results = {}
+    for name, setup, helper, calls in SCENARIOS:
+        uc = unicorn.Uc(unicorn.UC_ARCH_ARM, unicorn.UC_MODE_THUMB | unicorn.UC_MODE_MCLASS)
+        uc.mem_map(FLASH_BASE, FLASH_SIZE)
+        uc.mem_map(RAM_BASE, RAM_SIZE)
+        for base, size in PERIPHERAL_REGIONS:
+            uc.mem_map(base, size)
+        for address, data, _ in loadSegments(elf):
+            uc.mem_write(address, data)
+
+        counter = CycleCounter(uc, multiplyCycles, flashWait)
+        returnAddress = symbols["benchReturn"]
+
+        def call(function):
+            uc.reg_write(arm_const.UC_ARM_REG_SP, RAM_BASE + RAM_SIZE)
+            uc.reg_write(arm_const.UC_ARM_REG_LR, returnAddress | 1)
+            counter.reset()
+            uc.emu_start(symbols[function] | 1, returnAddress)
+            return counter.cycles
+
+        call(setup)
+        uc.hook_add(unicorn.UC_HOOK_CODE, counter.onCode)
+        uc.hook_add(unicorn.UC_HOOK_MEM_READ, counter.onRead)
+        samples = [call(helper) for _ in range(calls)]
+        results[name] = {"helper": helper, "calls": calls, "min": min(samples),
+                         "avg": round(sum(samples) / float(calls), 1), "max": max(samples)}
+    return results
+
+
+def report(results, baseline, clock, tolerance):
+    failures = 0
+    sys.stdout.write("%-26s %-36s %6s %8s %6s %12s %10s\n"
+                     % ("scenario", "helper", "min", "avg", "max", "max rate Hz", "baseline"))
+    for name, _, _, _ in SCENARIOS:
+        result = results[name]
+        change = ""
+        if name in baseline:
+            previous = baseline[name]["avg"]
+            delta = (result["avg"] - previous) * 100.0 / previous
+            change = "%+.1f%%" % delta
+            if delta > tolerance:
+                change += " FAIL"
+                failures += 1
+        sys.stdout.write("%-26s %-36s %6d %8.1f %6d %12d %10s\n"
+                         % (name, result["helper"], result["min"], result["avg"], result["max"],
+                            clock // result["max"], change))
+    return failures
+
+
+def energy(results, options):
+    """Active and sleep time per second of each display mode, with the average current if given"""
+    currents = (options.run_ma, options.sleep_ma, options.deep_sleep_ma)
+    sys.stdout.write("\n%-26s %-10s %8s %12s %12s %8s" % ("mode", "idle", "wakes/s", "active us/s", "sleep us/s", "active"))
+    sys.stdout.write(" %8s\n" % "avg mA" if None not in currents else "\n")
+    for mode, clocks in ENERGY_MODES:
+        # sevenSegmentIdle only deep-sleeps while the WKT is the one clock running
+        deepSleep = all(clock == "WKT" for _, clock, _ in clocks)
+        wakes = 0.0
+        activeUs = 0.0
+        for scenario, clock, rate in clocks:
+            calls = (WKT_CLOCK_HZ if clock == "WKT" else options.clock) / float(rate)
+            wakes += calls
+            activeUs += calls * (results[scenario]["avg"] + EXCEPTION_CYCLES) * 1e6 / options.clock
+        if deepSleep:
+            activeUs += wakes * options.wake_us
+        activeUs = min(activeUs, 1e6)
+        sleepUs = 1e6 - activeUs
+        sys.stdout.write("%-26s %-10s %8.1f %12.1f %12.1f %7.3f%%"
+                         % (mode, "deep-sleep" if deepSleep else "sleep", wakes, activeUs, sleepUs, activeUs / 1e4))
+        if None not in currents:
+            idleMa = options.deep_sleep_ma if deepSleep else options.sleep_ma
+            sys.stdout.write(" %8.4f" % ((activeUs * options.run_ma + sleepUs * idleMa) / 1e6))
+        sys.stdout.write("\n")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Count Cortex-M0+ cycles of the seven segment interrupt helpers")
+    parser.add_argument("-I", dest="includes", action="append", default=[],
+                        help="include directory for LPC802.h, the CMSIS core headers and clock_config.h")
+    parser.add_argument("-D", dest="defines", action="append", default=[], help="preprocessor define, e.g. SEVEN_SEGMENT_TRACE")
+    parser.add_argument("--opt", default="-Os", help="optimisation flag passed to the compiler")
+    parser.add_argument("--clock", type=int, default=18000000, help="core clock in Hz for the max rate column")
+    parser.add_argument("--flash-wait", type=int, default=0, help="flash wait states")
+    parser.add_argument("--slow-multiply", action="store_true", help="32 cycle multiplier instead of single cycle")
+    parser.add_argument("--tolerance", type=float, default=5.0, help="allowed growth of the average in percent")
+    parser.add_argument("--update-baseline", action="store_true", help="write the results as the new baseline")
+    parser.add_argument("--wake-us", type=float, default=0.0, help="deep-sleep wake-up time added to each interrupt")
+    parser.add_argument("--run-ma", type=float, help="current with the core running, for the average current")
+    parser.add_argument("--sleep-ma", type=float, help="current in sleep")
+    parser.add_argument("--deep-sleep-ma", type=float, help="current in deep-sleep")
+    parser.add_argument("--check-timings", action="store_true",
+                        help="only check the cycle table against the TRM, needs llvm-mc instead of gcc and unicorn")
+    parser.add_argument("--llvm-mc", default="llvm-mc", help="llvm-mc used by --check-timings")
+    options = parser.parse_args()
+
+    if options.check_timings:
+        try:
+            failures = checkTimings(options.llvm_mc)
+        except BuildError as error:
+            sys.stderr.write(str(error))
+            return 1
+        sys.stdout.write("%d of %d instructions disagree with the TRM\n" % (failures, len(TIMING_CHECKS)))
+        return 1 if failures else 0
+
+    with tempfile.TemporaryDirectory() as workDir:
+        try:
+            elf = build(workDir, options.includes, options.defines, options.opt)
+        except BuildError as error:
+            sys.stderr.write(str(error))
+            return 1
+        results = runScenarios(elf, 32 if options.slow_multiply else 1, options.flash_wait)
+
+    baseline = {}
+    if os.path.exists(BASELINE_FILE) and not options.update_baseline:
+        with open(BASELINE_FILE) as baselineFile:
+            baseline = json.load(baselineFile)
+    failures = report(results, baseline, options.clock, options.tolerance)
+    energy(results, options)
+
+    # Only --update-baseline records the baseline, a run with nothing to compare with is not a pass
+    if options.update_baseline:
+        with open(BASELINE_FILE, "w") as baselineFile:
+            json.dump(results, baselineFile, indent=4, sort_keys=True)
+            baselineFile.write("\n")
+        sys.stdout.write("baseline written to %s, commit it\n" % os.path.relpath(BASELINE_FILE))
+    elif not baseline:
+        sys.stdout.write("no baseline in %s, record one with --update-baseline and commit it\n"
+                         % os.path.relpath(BASELINE_FILE))
+        return 1
+    if failures:
+        sys.stdout.write("%d scenarios are slower than the baseline\n" % failures)
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,216 @@
+#!/usr/bin/env python3
+"""
+Seven Segment Script Assembler
+
+Turns a text display script into a const uint8_t[] for seven_segment_script.c
+
+Script syntax, one statement per line, '#' starts a comment:
+
+    show "ABCD"                  display 4 characters
+    scroll "HELLO WORLD" [pad]   one shot carousel
+    slide "A B C D" [pad] [nospace]
+                                 one shot slider, nospace ignores single spaces
+    count START STOP [STEP]      count between 0 and 9999 (STEP defaults to 1)
+    blink TRANSITIONS            flash the display on and off
+    bright LEVEL                 brightness 0 .. 8
+    wait TRANSITIONS             hold the current screen
+    name:                        label for loop
+    loop name [COUNT]            repeat from the label COUNT times in total, 0 or no COUNT loops forever
+                                 the label must come first, loops may nest but not overlap and
+                                 counted loops nest at most 4 deep
+    end                          stop on the current screen
+
+Usage: seven_segment_asm.py script.txt [-n arrayName] [-o script.h]
+"""
+
+import argparse
+import os
+import shlex
+import sys
+
+OP_END = 0x00
+OP_SHOW = 0x01
+OP_SCROLL = 0x02
+OP_SLIDE = 0x03
+OP_COUNT = 0x04
+OP_BLINK = 0x05
+OP_BRIGHT = 0x06
+OP_WAIT = 0x07
+OP_LOOP = 0x08
+
+FLAG_PADDING = 0x01
+FLAG_IGNORE_SPACES = 0x02
+
+# Must match seven_segment.h
+MAX_SEQUENCE_LENGTH = 64
+MAX_BRIGHTNESS = 8
+SCRIPT_MAX_LOOP_DEPTH = 4
+
+# Characters the display library can show (lower case is converted)
+DISPLAYABLE = set("0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ-=_ ")
+
+
+class AssemblerError(Exception):
+    def __init__(self, lineNumber, message):
+        super().__init__("line %d: %s" % (lineNumber, message))
+
+
+def parseInt(lineNumber, text, low, high):
+    try:
+        value = int(text, 0)
+    except ValueError:
+        raise AssemblerError(lineNumber, "expected a number, got '%s'" % text)
+    if value < low or value > high:
+        raise AssemblerError(lineNumber, "%d is outside %d .. %d" % (value, low, high))
+    return value
+
+
+def checkText(lineNumber, text):
+    for character in text:
+        if character.upper() not in DISPLAYABLE:
+            raise AssemblerError(lineNumber, "'%s' cannot be shown on the display" % character)
+    return [ord(character) for character in text]
+
+
+def checkLoops(code, fixups, labels):
+    # The player keeps one counter per counted LOOP being repeated, which only works for loops that
+    # jump back and nest inside each other
+    loops = []
+    for position, label, lineNumber in fixups:
+        start, end = labels[label], position - 1
+        if start > end:
+            raise AssemblerError(lineNumber, "loop label '%s' must come before the loop" % label)
+        loops.append((start, end, code[position + 2], lineNumber))
+    for start, end, count, lineNumber in loops:
+        depth = 0
+        for otherStart, otherEnd, otherCount, otherLine in loops:
+            if otherStart < start <= otherEnd < end or start < otherStart <= end < otherEnd:
+                raise AssemblerError(max(lineNumber, otherLine), "loops on lines %d and %d overlap"
+                                     % (min(lineNumber, otherLine), max(lineNumber, otherLine)))
+            if otherCount != 0 and otherStart <= start and end <= otherEnd:
+                depth += 1
+        if count != 0 and depth > SCRIPT_MAX_LOOP_DEPTH:
+            raise AssemblerError(lineNumber, "counted loops nest deeper than %d" % SCRIPT_MAX_LOOP_DEPTH)
+
+
+def assemble(source):
+    code = []
+    labels = {}
+    # (position of the address in code, label, line number) filled in once all labels are known
+    fixups = []
+
+    for lineNumber, line in enumerate(source.splitlines(), 1):
+        line = line.split("#", 1)[0].strip()
+        if not line:
+            continue
+        if line.endswith(":"):
+            labels[line[:-1].strip()] = len(code)
+            continue
+
+        words = shlex.split(line)
+        op = words[0].lower()
+        args = words[1:]
+
+        if op == "show":
+            if len(args) != 1 or len(args[0]) != 4:
+                raise AssemblerError(lineNumber, "show needs exactly 4 characters")
+            code += [OP_SHOW] + checkText(lineNumber, args[0])
+        elif op in ("scroll", "slide"):
+            if not args:
+                raise AssemblerError(lineNumber, "%s needs a text" % op)
+            text = args[0]
+            flags = 0
+            for option in args[1:]:
+                if option == "pad":
+                    flags |= FLAG_PADDING
+                elif option == "nospace" and op == "slide":
+                    flags |= FLAG_IGNORE_SPACES
+                else:
+                    raise AssemblerError(lineNumber, "unknown option '%s'" % option)
+            if len(text) > MAX_SEQUENCE_LENGTH:
+                raise AssemblerError(lineNumber, "text is longer than %d characters" % MAX_SEQUENCE_LENGTH)
+            # A one shot carousel only ends once the last 4 characters are on screen
+            if op == "scroll" and len(text) < 4 and not (flags & FLAG_PADDING):
+                raise AssemblerError(lineNumber, "scroll text shorter than 4 characters needs pad")
+            code += [OP_SCROLL if op == "scroll" else OP_SLIDE, flags, len(text)] + checkText(lineNumber, text)
+        elif op == "count":
+            if len(args) not in (2, 3):
+                raise AssemblerError(lineNumber, "count needs START STOP [STEP]")
+            start = parseInt(lineNumber, args[0], 0, 9999)
+            stop = parseInt(lineNumber, args[1], 0, 9999)
+            step = parseInt(lineNumber, args[2], 1, 255) if len(args) == 3 else 1
+            # The counter only stops when it lands exactly on the stop value
+            if abs(stop - start) % step != 0:
+                raise AssemblerError(lineNumber, "STEP must divide the distance from START to STOP")
+            code += [OP_COUNT, start >> 8, start & 0xFF, stop >> 8, stop & 0xFF, step]
+        elif op in ("blink", "wait"):
+            if len(args) != 1:
+                raise AssemblerError(lineNumber, "%s needs a number of transitions" % op)
+            code += [OP_BLINK if op == "blink" else OP_WAIT, parseInt(lineNumber, args[0], 0, 255)]
+        elif op == "bright":
+            if len(args) != 1:
+                raise AssemblerError(lineNumber, "bright needs a level")
+            code += [OP_BRIGHT, parseInt(lineNumber, args[0], 0, MAX_BRIGHTNESS)]
+        elif op == "loop":
+            if len(args) not in (1, 2):
+                raise AssemblerError(lineNumber, "loop needs a label and an optional count")
+            count = parseInt(lineNumber, args[1], 0, 255) if len(args) == 2 else 0
+            fixups.append((len(code) + 1, args[0], lineNumber))
+            code += [OP_LOOP, 0, 0, count]
+        elif op == "end":
+            code.append(OP_END)
+        else:
+            raise AssemblerError(lineNumber, "unknown statement '%s'" % op)
+
+    for position, label, lineNumber in fixups:
+        if label not in labels:
+            raise AssemblerError(lineNumber, "unknown label '%s'" % label)
+        code[position] = labels[label] >> 8
+        code[position + 1] = labels[label] & 0xFF
+    checkLoops(code, fixups, labels)
+
+    if not code or code[-1] != OP_END:
+        code.append(OP_END)
+    if len(code) > 0xFFFF:
+        raise AssemblerError(0, "script is larger than 64 KB")
+    return code
+
+
+def toC(code, arrayName, sourceName):
+    lines = ["// Generated by seven_segment_asm.py from %s" % sourceName,
+             "#include \"stdint.h\"",
+             "",
+             "const uint8_t %s[] = {" % arrayName]
+    for i in range(0, len(code), 12):
+        lines.append("\t" + ", ".join("0x%02X" % byte for byte in code[i:i + 12]) + ",")
+    lines.append("};")
+    lines.append("const int %sLength = %d;" % (arrayName, len(code)))
+    return "\n".join(lines) + "\n"
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Assemble a seven segment display script")
+    parser.add_argument("script", help="text script to assemble")
+    parser.add_argument("-n", "--name", default="sevenSegmentScript", help="name of the generated array")
+    parser.add_argument("-o", "--output", help="output file, stdout if not given")
+    options = parser.parse_args()
+
+    with open(options.script) as scriptFile:
+        source = scriptFile.read()
+    try:
+        code = assemble(source)
+    except AssemblerError as error:
+        sys.stderr.write("%s: %s\n" % (options.script, error))
+        return 1
+
+    output = toC(code, options.name, os.path.basename(options.script))
+    if options.output:
+        with open(options.output, "w") as outputFile:
+            outputFile.write(output)
+    else:
+        sys.stdout.write(output)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,105 @@
+#!/usr/bin/env python3
+"""
+Seven Segment Size Report
+
+Cross compiles the seven segment library once per configuration of seven_segment_config.h and
+reports the flash (.text + .data) and RAM (.data + .bss) it takes, so the cost of each mode and
+clock can be seen before leaving it out.
+
+Each configuration is a list of SEVEN_SEGMENT_USE_... options turned off, everything else keeps the
+default from seven_segment_config.h. The sizes are the sum over the library objects, that is every
+function built in, as in a firmware that calls all of them.
+
+Needs arm-none-eabi-gcc and arm-none-eabi-size on the path (or --cc and --size) and the MCUXpresso
+LPC802 device and CMSIS headers, passed with -I.
+
+Usage: size_report.py -I path/to/LPC802/device -I path/to/CMSIS -I path/to/board
+                      [--opt -Os] [-D SEVEN_SEGMENT_STATS] [--cc arm-none-eabi-gcc]
+"""
+
+import argparse
+import os
+import subprocess
+import sys
+import tempfile
+
+TOOLS_DIR = os.path.dirname(os.path.abspath(__file__))
+SOURCE_DIR = os.path.join(os.path.dirname(TOOLS_DIR), "source")
+
+# Library files, the example and the optional trace and stats files are left out
+LIBRARY_FILES = ["seven_segment.c", "seven_segment_backend.c", "seven_segment_script.c"]
+
+MODES = ["COUNTER", "CAROUSEL", "SLIDER", "SEQUENCER", "SCRIPT"]
+
+# Name and the options turned off
+CONFIGURATIONS = [
+    ("full", []),
+    ("no counter", ["COUNTER"]),
+    ("no carousel", ["CAROUSEL"]),
+    ("no slider", ["SLIDER"]),
+    ("no sequencer", ["SEQUENCER"]),
+    ("no script", ["SCRIPT"]),
+    ("counter only", ["CAROUSEL", "SLIDER", "SEQUENCER", "SCRIPT"]),
+    ("carousel only", ["COUNTER", "SLIDER", "SEQUENCER", "SCRIPT"]),
+    ("characters only", MODES),
+    ("characters, MRT only", MODES + ["SYSTICK", "WKT", "CTIMER0"]),
+    ("characters, SysTick only", MODES + ["WKT", "MRT", "CTIMER0"]),
+    ("no adaptive refresh", ["ADAPTIVE_REFRESH"]),
+]
+
+
+def compileConfiguration(args, disabled, workDir):
+    """Compiles the library with the given options off, returns the object paths"""
+    objects = []
+    flags = [args.opt, "-mcpu=cortex-m0plus", "-mthumb", "-ffunction-sections", "-fdata-sections",
+             "-I", SOURCE_DIR]
+    flags += ["-I" + include for include in args.include]
+    flags += ["-D" + define for define in args.define]
+    flags += ["-DSEVEN_SEGMENT_USE_%s=0" % option for option in disabled]
+
+    for source in LIBRARY_FILES:
+        output = os.path.join(workDir, source.replace(".c", ".o"))
+        subprocess.run([args.cc, "-c"] + flags + [os.path.join(SOURCE_DIR, source), "-o", output], check=True)
+        objects.append(output)
+    return objects
+
+
+def readSizes(args, objects):
+    """Returns (text, data, bss) in bytes summed over the objects, from size in Berkeley format"""
+    output = subprocess.run([args.size, "-B"] + objects, check=True, capture_output=True, text=True).stdout
+    sizes = [0, 0, 0]
+    for line in output.strip().splitlines()[1:]:
+        fields = line.split()
+        for i in range(3):
+            sizes[i] += int(fields[i])
+    return tuple(sizes)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("-I", dest="include", action="append", default=[], help="include directory for LPC802.h and CMSIS")
+    parser.add_argument("-D", dest="define", action="append", default=[], help="extra define for every configuration")
+    parser.add_argument("--opt", default="-Os", help="optimisation flag, default -Os")
+    parser.add_argument("--cc", default="arm-none-eabi-gcc", help="compiler, default arm-none-eabi-gcc")
+    parser.add_argument("--size", default="arm-none-eabi-size", help="size tool, default arm-none-eabi-size")
+    args = parser.parse_args()
+
+    rows = []
+    for name, disabled in CONFIGURATIONS:
+        with tempfile.TemporaryDirectory() as workDir:
+            try:
+                text, data, bss = readSizes(args, compileConfiguration(args, disabled, workDir))
+            except subprocess.CalledProcessError as error:
+                sys.exit("%s: build failed (%s)" % (name, error))
+        rows.append((name, text, data, bss))
+
+    fullFlash = rows[0][1] + rows[0][2]
+    print("%-26s %8s %8s %8s %8s %8s %8s" % ("configuration", "text", "data", "bss", "flash", "ram", "saved"))
+    for name, text, data, bss in rows:
+        flash = text + data
+        print("%-26s %8d %8d %8d %8d %8d %8d" % (name, text, data, bss, flash, data + bss, fullFlash - flash))
+    print("\ndata includes defaultSevenSegmentDisplay, each further display takes the same again")
+
+
+if __name__ == "__main__":
+    main()